@@ -95,6 +95,10 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId) = 0;
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) = 0;
+            /**
+            isInLineOfSight from one origin to count targets, given as x, y, z triplets in targets. Sets results[i] for each target
+            */
+            virtual void isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float const* targets, uint32 count, ModelIgnoreFlags ignoreFlags, bool* results) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             virtual float getCeil(unsigned int /*pMapId*/, float /*x*/, float /*y*/, float /*z*/, float /*maxSearchDist*/) { return VMAP_INVALID_CEIL_VALUE; }
 
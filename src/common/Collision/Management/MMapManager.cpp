@@ -28,7 +28,38 @@ namespace MMAP
     static char const* const TILE_FILE_NAME_FORMAT = "%s/mmaps/%03i%02i%02i.mmtile";
     static char const* const GAMEOBJECT_FILE_NAME_FORMAT = "%s/mmaps/go%04i.mmap";
 
+    // dtNavMeshQuery is not thread safe, so each thread owns its queries. A query is shared by
+    // every instance of the same navmesh and is re-attached when the navmesh was reloaded.
+    struct ThreadNavMeshQueryPool
+    {
+        struct Entry
+        {
+            uint32 serial = 0;
+            dtNavMeshQuery* query = nullptr;
+        };
+
+        ~ThreadNavMeshQueryPool()
+        {
+            for (auto& itr : mapQueries)
+                dtFreeNavMeshQuery(itr.second.query);
+            for (auto& itr : modelQueries)
+                dtFreeNavMeshQuery(itr.second.query);
+        }
+
+        std::unordered_map<uint32 /*mapId*/, Entry> mapQueries;
+        std::unordered_map<uint32 /*displayId*/, Entry> modelQueries;
+    };
+
+    static thread_local ThreadNavMeshQueryPool threadQueryPool;
+
     // ######################## MMapManager ########################
+    MMapManager::MMapManager() : loadedTiles(0), thread_safe_environment(true),
+        nextMeshSerial(0), queryHits(0), queryMisses(0), queryExhausted(0)
+    {
+        queryMaxNodes = std::max(sConfigMgr->GetIntDefault("MMap.QueryNodePool", 1024), 64);
+        modelQueryMaxNodes = std::max(sConfigMgr->GetIntDefault("MMap.ModelQueryNodePool", 1024), 64);
+    }
+
     MMapManager::~MMapManager()
     {
         for (auto & loadedMMap : loadedMMaps)
@@ -104,7 +135,7 @@ namespace MMAP
         TC_LOG_DEBUG("maps", "MMAP:loadMapData: Loaded %03i.mmap", mapId);
 
         // store inside our map list
-        auto  mmap_data = new MMapData(mesh);
+        auto  mmap_data = new MMapData(mesh, ++nextMeshSerial);
 
         itr->second = mmap_data;
         return true;
@@ -266,40 +297,42 @@ namespace MMAP
         return true;
     }
 
-    bool MMapManager::unloadMapInstance(uint32 mapId, uint32 instanceId)
+    dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
     {
-        // check if we have this map loaded
         auto itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
+            return nullptr;
+
+        return itr->second->navMesh;
+    }
+
+    dtNavMeshQuery const* MMapManager::GetPooledQuery(bool model, uint32 id, MMapData const* data, int32 maxNodes)
+    {
+        ThreadNavMeshQueryPool::Entry& entry = model ? threadQueryPool.modelQueries[id] : threadQueryPool.mapQueries[id];
+        if (entry.query && entry.serial == data->serial)
         {
-            // file may not exist, therefore not loaded
-            TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded navmesh map %03u", mapId);
-            return false;
+            ++queryHits;
+            return entry.query;
         }
 
-        MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        ++queryMisses;
+        if (!entry.query)
         {
-            TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId %03u instanceId %u", mapId, instanceId);
-            return false;
+            entry.query = dtAllocNavMeshQuery();
+            ASSERT(entry.query);
         }
 
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
-
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
-        TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Unloaded mapId %03u instanceId %u", mapId, instanceId);
-
-        return true;
-    }
-
-    dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
-    {
-        auto itr = GetMMapData(mapId);
-        if (itr == loadedMMaps.end())
+        // init() only reallocates the node pool if its size changed, so attaching to a reloaded navmesh is cheap
+        if (dtStatusFailed(entry.query->init(data->navMesh, maxNodes)))
+        {
+            dtFreeNavMeshQuery(entry.query);
+            entry.query = nullptr;
+            entry.serial = 0;
             return nullptr;
+        }
 
-        return itr->second->navMesh;
+        entry.serial = data->serial;
+        return entry.query;
     }
 
     dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
@@ -308,24 +341,20 @@ namespace MMAP
         if (itr == loadedMMaps.end())
             return nullptr;
 
-        MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
-        {
-            // allocate mesh query
-            dtNavMeshQuery* query = dtAllocNavMeshQuery();
-            ASSERT(query);
-            if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
-            {
-                dtFreeNavMeshQuery(query);
-                TC_LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-                return nullptr;
-            }
+        dtNavMeshQuery const* query = GetPooledQuery(false, mapId, itr->second, queryMaxNodes);
+        if (!query)
+            TC_LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
 
-            TC_LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-            mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
-        }
+        return query;
+    }
 
-        return mmap->navMeshQueries[instanceId];
+    NavMeshQueryPoolStats MMapManager::GetNavMeshQueryPoolStats() const
+    {
+        NavMeshQueryPoolStats stats;
+        stats.hits = queryHits;
+        stats.misses = queryMisses;
+        stats.exhausted = queryExhausted;
+        return stats;
     }
 
     bool MMapManager::loadGameObject(uint32 displayId)
@@ -387,7 +416,7 @@ namespace MMAP
         // Check again after load. We allow threads to load independently for performance if
         // none is found, but we only want one instance to be managed. Saves other threads
         // having to wait for the lock in GetModelNavMeshQuery while this thread loads
-        MMapData* mmap_data = new MMapData(mesh);
+        MMapData* mmap_data = new MMapData(mesh, ++nextMeshSerial);
         if (loadedModels.find(displayId) == loadedModels.end())
             loadedModels.insert(std::pair<uint32, MMapData*>(displayId, mmap_data));
         else
@@ -398,32 +427,14 @@ namespace MMAP
 
     dtNavMeshQuery const* MMapManager::GetModelNavMeshQuery(uint32 displayId)
     {
-        if (loadedModels.find(displayId) == loadedModels.end())
+        auto itr = loadedModels.find(displayId);
+        if (itr == loadedModels.end())
             return nullptr;
 
-        MMapData* mmap = loadedModels[displayId];
-
-        dtNavMeshQuery* navMeshQuery = nullptr;
-
-        NavMeshQuerySet::iterator it = mmap->navMeshQueries.find(displayId);
-        if (it == mmap->navMeshQueries.end())
-        {
-            // allocate mesh query
-            navMeshQuery = dtAllocNavMeshQuery();
-            ASSERT(navMeshQuery);
-            if (dtStatusFailed(navMeshQuery->init(mmap->navMesh, 1024)))
-            {
-                dtFreeNavMeshQuery(navMeshQuery);
-                TC_LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for displayid %03u displayId %u", displayId, displayId);
-                return nullptr;
-            }
-
-            TC_LOG_TRACE("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for displayid %03u displayId %u", displayId, displayId);
-            mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(displayId, navMeshQuery));
-        }
-        else
-            navMeshQuery = it->second;
+        dtNavMeshQuery const* query = GetPooledQuery(true, displayId, itr->second, modelQueryMaxNodes);
+        if (!query)
+            TC_LOG_ERROR("maps", "MMAP:GetModelNavMeshQuery: Failed to initialize dtNavMeshQuery for displayId %u", displayId);
 
-        return navMeshQuery;
+        return query;
     }
 }
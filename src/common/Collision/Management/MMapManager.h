@@ -23,6 +23,7 @@
 #include "DetourAlloc.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -31,28 +32,29 @@
 namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
-    typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
 
     // dummy struct to hold map's mmap data
     struct TC_COMMON_API MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) { }
+        MMapData(dtNavMesh* mesh, uint32 meshSerial) : navMesh(mesh), serial(meshSerial) { }
         ~MMapData()
         {
-            for (auto & navMeshQuerie : navMeshQueries)
-                dtFreeNavMeshQuery(navMeshQuerie.second);
-
             if (navMesh)
                 dtFreeNavMesh(navMesh);
         }
 
         dtNavMesh* navMesh;
-
-        // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
-        NavMeshQuerySet navMeshQueries;     // instanceId to query
+        uint32 serial;                      // unique per loaded navmesh, lets pooled queries detect a reloaded mesh
         MMapTileSet loadedTileRefs;         // maps [map grid coords] to [dtTile]
     };
 
+    struct NavMeshQueryPoolStats
+    {
+        uint64 hits = 0;                    // query reused from the calling thread's pool
+        uint64 misses = 0;                  // query had to be allocated or attached to a new navmesh
+        uint64 exhausted = 0;               // searches that ran out of nodes in the query node pool
+    };
+
 
     typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
 
@@ -61,7 +63,7 @@ namespace MMAP
     class TC_COMMON_API MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0), thread_safe_environment(true) {}
+            MMapManager();
             ~MMapManager();
 
             void InitializeThreadUnsafe(const std::vector<uint32>& mapIds);
@@ -69,24 +71,36 @@ namespace MMAP
             bool loadGameObject(uint32 displayId);
             bool unloadMap(uint32 mapId, int32 x, int32 y);
             bool unloadMap(uint32 mapId);
-            bool unloadMapInstance(uint32 mapId, uint32 instanceId);
 
-            // the returned [dtNavMeshQuery const*] is NOT threadsafe
+            // the returned [dtNavMeshQuery const*] belongs to the calling thread and is shared by all instances of the map.
+            // Do not keep it across updates, the map may be updated by another thread next time.
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
             dtNavMeshQuery const* GetModelNavMeshQuery(uint32 displayId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
+            // to be called when a search on a query returned by this manager failed with DT_OUT_OF_NODES
+            void ReportNavMeshQueryExhausted() { ++queryExhausted; }
+            NavMeshQueryPoolStats GetNavMeshQueryPoolStats() const;
+
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
         private:
             bool loadMapData(uint32 mapId);
             uint32 packTileID(int32 x, int32 y);
+            dtNavMeshQuery const* GetPooledQuery(bool model, uint32 id, MMapData const* data, int32 maxNodes);
 
             MMapDataSet::const_iterator GetMMapData(uint32 mapId) const;
             MMapDataSet loadedMMaps;
             MMapDataSet loadedModels;
             uint32 loadedTiles;
             bool thread_safe_environment;
+
+            int32 queryMaxNodes;
+            int32 modelQueryMaxNodes;
+            std::atomic<uint32> nextMeshSerial;
+            std::atomic<uint64> queryHits;
+            std::atomic<uint64> queryMisses;
+            std::atomic<uint64> queryExhausted;
     };
 }
 
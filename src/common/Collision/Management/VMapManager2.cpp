@@ -20,6 +20,8 @@
 #include <iomanip>
 #include <string>
 #include <sstream>
+#include <algorithm>
+#include <memory>
 #include "VMapManager2.h"
 #include "MapTree.h"
 #include "ModelInstance.h"
@@ -181,6 +183,37 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float const* targets, uint32 count, ModelIgnoreFlags ignoreFlags, bool* results)
+    {
+        std::fill(results, results + count, true);
+        if (!count || !isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+            return;
+
+        auto instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        Vector3 pos1 = convertPositionToInternalRep(x1, y1, z1);
+        std::vector<Vector3> pos2;
+        std::vector<uint32> indexes;
+        pos2.reserve(count);
+        indexes.reserve(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            Vector3 pos = convertPositionToInternalRep(targets[i * 3], targets[i * 3 + 1], targets[i * 3 + 2]);
+            if (pos != pos1)
+            {
+                pos2.push_back(pos);
+                indexes.push_back(i);
+            }
+        }
+
+        std::unique_ptr<bool[]> rayResults(new bool[pos2.size()]);
+        instanceTree->second->isInLineOfSight(pos1, pos2.data(), pos2.size(), ignoreFlags, rayResults.get());
+        for (uint32 i = 0; i < indexes.size(); ++i)
+            results[indexes[i]] = rayResults[i];
+    }
+
     /* same as getObjectHitPos but a bit more gentle, will try from a bit higher and return collision from there if it gets further */
     bool VMapManager2::getLeapHitPos(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist)
     {
@@ -27,6 +27,7 @@
 #include <sstream>
 #include <iomanip>
 #include <limits>
+#include <algorithm>
 
 using G3D::Vector3;
 
@@ -207,6 +208,49 @@ namespace VMAP
     }
     //=========================================================
 
+    void StaticMapTree::isInLineOfSight(const Vector3& pos1, const Vector3* pos2, uint32 count, ModelIgnoreFlags ignoreFlags, bool* results) const
+    {
+        if (!count)
+            return;
+
+        G3D::AABox fanBounds(pos1);
+        for (uint32 i = 0; i < count; ++i)
+            fanBounds.merge(pos2[i]);
+
+        std::vector<uint32> models;
+        auto collect = [&models](uint32 entry) { models.push_back(entry); };
+        iTree.intersectBox(fanBounds, collect);
+        std::sort(models.begin(), models.end());
+        models.erase(std::unique(models.begin(), models.end()), models.end());
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            results[i] = true;
+            float maxDist = (pos2[i] - pos1).magnitude();
+            // same checks as the single ray version
+            if (maxDist == std::numeric_limits<float>::max() || !std::isfinite(maxDist))
+            {
+                results[i] = false;
+                continue;
+            }
+
+            if (maxDist < 1e-10f)
+                continue;
+
+            G3D::Ray ray = G3D::Ray::fromOriginAndDirection(pos1, (pos2[i] - pos1) / maxDist);
+            for (uint32 entry : models)
+            {
+                float distance = maxDist;
+                if (iTreeValues[entry].intersectRay(ray, distance, true, ignoreFlags))
+                {
+                    results[i] = false;
+                    break;
+                }
+            }
+        }
+    }
+    //=========================================================
+
     bool StaticMapTree::getObjectHitPos(const Vector3& pPos1, const Vector3& pPos2, Vector3& pResultHitPos, float pModifyDist) const
     {
         bool result=false;
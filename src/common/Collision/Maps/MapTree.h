@@ -60,6 +60,11 @@ namespace VMAP
 
             bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2, ModelIgnoreFlags ignoreFlags) const;
             /**
+            Same as above for a fan of rays from pos1, the tree is traversed once for the bounds of the whole fan
+            and every ray is then only tested against the models found
+            */
+            void isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3* pos2, uint32 count, ModelIgnoreFlags ignoreFlags, bool* results) const;
+            /**
             When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
             Return the hit pos or the original dest pos
             */
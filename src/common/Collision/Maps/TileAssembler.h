@@ -105,7 +105,9 @@ namespace VMAP
             TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
             virtual ~TileAssembler();
 
-            bool convertWorld2();
+            // maps and model files are converted by threadCount threads, 0 or 1 to work in the calling thread only
+            bool convertWorld2(uint32 threadCount = 0);
+            bool convertMap(uint32 mapId, MapSpawns* spawns, std::set<std::string>& modelFiles);
             bool readMapSpawns();
             bool calculateTransformedBound(ModelSpawn &spawn);
             void exportGameobjectModels();
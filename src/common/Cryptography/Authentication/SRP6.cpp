@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2008-2014 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2009 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SRP6.h"
+#include <cstring>
+
+// N = 894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7, little endian
+static uint8 const SRP6_N[SRP6::NUMBER_BYTES] =
+{
+    0xB7, 0x9B, 0x3E, 0x2A, 0x87, 0x82, 0x3C, 0xAB, 0x8F, 0x5E, 0xBF, 0xBF, 0x8E, 0xB1, 0x01, 0x08,
+    0x53, 0x50, 0x06, 0x29, 0x8B, 0x5B, 0xAD, 0xBD, 0x5B, 0x53, 0xE1, 0x89, 0x5E, 0x64, 0x4B, 0x89
+};
+
+// lo = a * b + c + d, hi receives the upper 64 bits (cannot overflow)
+static inline uint64 MulAdd(uint64 a, uint64 b, uint64 c, uint64 d, uint64& hi)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 const r = (unsigned __int128)a * b + c + d;
+    hi = uint64(r >> 64);
+    return uint64(r);
+#else
+    uint64 const ll = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+    uint64 const lh = (a & 0xFFFFFFFF) * (b >> 32);
+    uint64 const hl = (a >> 32) * (b & 0xFFFFFFFF);
+    uint64 const hh = (a >> 32) * (b >> 32);
+    uint64 const mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+    uint64 lo = (mid << 32) | (ll & 0xFFFFFFFF);
+    uint64 high = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    lo += c;
+    high += lo < c;
+    lo += d;
+    high += lo < d;
+    hi = high;
+    return lo;
+#endif
+}
+
+// result = a - b - borrow, borrow receives the outgoing borrow
+static inline uint64 SubBorrow(uint64 a, uint64 b, uint64& borrow)
+{
+    uint64 const d = a - b;
+    uint64 const result = d - borrow;
+    borrow = uint64(a < b) | uint64(d < borrow);
+    return result;
+}
+
+SRP6 const& SRP6::Instance()
+{
+    static SRP6 const instance;
+    return instance;
+}
+
+SRP6::SRP6()
+{
+    memcpy(_N.data(), SRP6_N, NUMBER_BYTES);
+    _nLimbs = ToLimbs(_N);
+
+    // Newton iteration for N^-1 % 2^64, each step doubles the number of correct bits
+    uint64 inv = 1;
+    for (uint32 i = 0; i < 6; i++)
+        inv *= 2 - _nLimbs[0] * inv;
+    _n0Inv = 0 - inv;
+
+    // N has its top bit set, so 2^256 % N = 2^256 - N
+    uint64 borrow = 0;
+    for (uint32 i = 0; i < LIMBS; i++)
+        _one[i] = SubBorrow(0, _nLimbs[i], borrow);
+
+    // 2^512 % N by doubling 2^256 % N, 256 times
+    _R2 = _one;
+    for (uint32 i = 0; i < NUMBER_BYTES * 8; i++)
+        _R2 = ModAdd(_R2, _R2);
+
+    Limbs g = { };
+    g[0] = GetG();
+    for (uint32 i = 0; i < _gTable.size(); i++)
+    {
+        _gTable[i][0] = _one;
+        _gTable[i][1] = i == 0 ? ToMont(g) : MontMul(_gTable[i - 1][WINDOW_SIZE / 2], _gTable[i - 1][WINDOW_SIZE / 2]);
+        for (uint32 j = 2; j < WINDOW_SIZE; j++)
+            _gTable[i][j] = MontMul(_gTable[i][j - 1], _gTable[i][1]);
+    }
+}
+
+SRP6::Number SRP6::ToNumber(uint8 const* bytes, uint32 length)
+{
+    Number number = { };
+    memcpy(number.data(), bytes, length < NUMBER_BYTES ? length : NUMBER_BYTES);
+    return number;
+}
+
+SRP6::Limbs SRP6::ToLimbs(Number const& number)
+{
+    Limbs limbs = { };
+    for (uint32 i = 0; i < NUMBER_BYTES; i++)
+        limbs[i / 8] |= uint64(number[i]) << ((i % 8) * 8);
+    return limbs;
+}
+
+SRP6::Number SRP6::ToBytes(Limbs const& limbs)
+{
+    Number number;
+    for (uint32 i = 0; i < NUMBER_BYTES; i++)
+        number[i] = uint8(limbs[i / 8] >> ((i % 8) * 8));
+    return number;
+}
+
+uint32 SRP6::GetWindow(Number const& exponent, uint32 window)
+{
+    return (exponent[window / 2] >> ((window % 2) * WINDOW_BITS)) & (WINDOW_SIZE - 1);
+}
+
+void SRP6::Select(Limbs const* table, uint32 index, Limbs& result)
+{
+    // read every entry so that the memory access pattern doesn't depend on index
+    result = { };
+    for (uint32 i = 0; i < WINDOW_SIZE; i++)
+    {
+        uint64 const mask = 0 - uint64(i == index);
+        for (uint32 j = 0; j < LIMBS; j++)
+            result[j] |= table[i][j] & mask;
+    }
+}
+
+SRP6::Limbs SRP6::MontMul(Limbs const& a, Limbs const& b) const
+{
+    // CIOS Montgomery multiplication: a * b * 2^-256 % N
+    uint64 t[LIMBS + 2] = { };
+    for (uint32 i = 0; i < LIMBS; i++)
+    {
+        uint64 carry = 0;
+        for (uint32 j = 0; j < LIMBS; j++)
+            t[j] = MulAdd(a[j], b[i], t[j], carry, carry);
+        t[LIMBS] += carry;
+        t[LIMBS + 1] = t[LIMBS] < carry;
+
+        uint64 const m = t[0] * _n0Inv;
+        MulAdd(m, _nLimbs[0], t[0], 0, carry);
+        for (uint32 j = 1; j < LIMBS; j++)
+            t[j - 1] = MulAdd(m, _nLimbs[j], t[j], carry, carry);
+        t[LIMBS - 1] = t[LIMBS] + carry;
+        t[LIMBS] = t[LIMBS + 1] + (t[LIMBS - 1] < carry);
+    }
+
+    // t < 2N, subtract N unless it borrows
+    Limbs reduced;
+    uint64 borrow = 0;
+    for (uint32 i = 0; i < LIMBS; i++)
+        reduced[i] = SubBorrow(t[i], _nLimbs[i], borrow);
+    uint64 const keepMask = 0 - uint64(borrow > t[LIMBS]);
+    Limbs result;
+    for (uint32 i = 0; i < LIMBS; i++)
+        result[i] = (t[i] & keepMask) | (reduced[i] & ~keepMask);
+    return result;
+}
+
+SRP6::Limbs SRP6::ModAdd(Limbs const& a, Limbs const& b) const
+{
+    Limbs sum;
+    uint64 carry = 0;
+    for (uint32 i = 0; i < LIMBS; i++)
+    {
+        uint64 const s = a[i] + carry;
+        sum[i] = s + b[i];
+        carry = uint64(s < carry) | uint64(sum[i] < b[i]);
+    }
+
+    Limbs reduced;
+    uint64 borrow = 0;
+    for (uint32 i = 0; i < LIMBS; i++)
+        reduced[i] = SubBorrow(sum[i], _nLimbs[i], borrow);
+    uint64 const keepMask = 0 - uint64(borrow > carry);
+    Limbs result;
+    for (uint32 i = 0; i < LIMBS; i++)
+        result[i] = (sum[i] & keepMask) | (reduced[i] & ~keepMask);
+    return result;
+}
+
+SRP6::Limbs SRP6::FromMont(Limbs const& a) const
+{
+    Limbs one = { };
+    one[0] = 1;
+    return MontMul(a, one);
+}
+
+SRP6::Limbs SRP6::MontExp(Limbs const& base, Number const& exponent, uint32 exponentBytes) const
+{
+    Limbs table[WINDOW_SIZE];
+    table[0] = _one;
+    table[1] = base;
+    for (uint32 i = 2; i < WINDOW_SIZE; i++)
+        table[i] = MontMul(table[i - 1], base);
+
+    Limbs result = _one;
+    Limbs factor;
+    for (uint32 window = exponentBytes * 8 / WINDOW_BITS; window-- > 0;)
+    {
+        for (uint32 i = 0; i < WINDOW_BITS; i++)
+            result = MontMul(result, result);
+        Select(table, GetWindow(exponent, window), factor);
+        result = MontMul(result, factor);
+    }
+    return result;
+}
+
+SRP6::Limbs SRP6::MontExpG(Number const& exponent, uint32 exponentBytes) const
+{
+    Limbs result = _one;
+    Limbs factor;
+    for (uint32 window = 0; window < exponentBytes * 8 / WINDOW_BITS; window++)
+    {
+        Select(_gTable[window].data(), GetWindow(exponent, window), factor);
+        result = MontMul(result, factor);
+    }
+    return result;
+}
+
+SRP6::Number SRP6::ComputeVerifier(Number const& x) const
+{
+    return ToBytes(FromMont(MontExpG(x, DIGEST_BYTES)));
+}
+
+SRP6::Number SRP6::ComputeServerEphemeral(Number const& v, Number const& b) const
+{
+    Limbs const vMont = ToMont(ToLimbs(v));
+    Limbs const kv = ModAdd(ModAdd(vMont, vMont), vMont);
+    return ToBytes(FromMont(ModAdd(kv, MontExpG(b, EPHEMERAL_BYTES))));
+}
+
+bool SRP6::ComputeSessionSecret(Number const& A, Number const& v, Number const& u, Number const& b, Number& S) const
+{
+    Limbs const aMont = ToMont(ToLimbs(A));
+    uint64 nonZero = 0;
+    for (uint64 limb : aMont)
+        nonZero |= limb;
+    if (!nonZero)
+        return false;
+
+    Limbs const vu = MontExp(ToMont(ToLimbs(v)), u, DIGEST_BYTES);
+    S = ToBytes(FromMont(MontExp(MontMul(aMont, vu), b, EPHEMERAL_BYTES)));
+    return true;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2008-2014 TrinityCore <http://www.trinitycore.org/>
+ * Copyright (C) 2005-2009 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SRP6_H
+#define _SRP6_H
+
+#include "Define.h"
+#include <array>
+
+/* Fixed width SRP6 arithmetic for the 256 bits safe prime N and generator g = 7 used by the client.
+   Numbers are 32 bytes little endian arrays, as in the auth packets and BigNumber::AsByteArray(32).
+   Computations use Montgomery multiplication on the stack: no allocation, no context, and the running
+   time doesn't depend on the secret exponents (fixed windows over the fixed exponent sizes, table
+   lookups read every entry). g^x uses a table of precomputed powers of g, built once.
+*/
+class TC_COMMON_API SRP6
+{
+    public:
+        static uint32 const NUMBER_BYTES = 32;
+        static uint32 const EPHEMERAL_BYTES = 19;           // server private ephemeral b
+        static uint32 const DIGEST_BYTES = 20;              // x and u are SHA1 digests
+        typedef std::array<uint8, NUMBER_BYTES> Number;
+
+        static SRP6 const& Instance();
+
+        Number const& GetN() const { return _N; }
+        static uint8 GetG() { return 7; }
+
+        // Load a little endian number of up to NUMBER_BYTES bytes
+        static Number ToNumber(uint8 const* bytes, uint32 length);
+
+        // v = g^x % N, x < 2^160
+        Number ComputeVerifier(Number const& x) const;
+        // B = (3 * v + g^b) % N, b < 2^152
+        Number ComputeServerEphemeral(Number const& v, Number const& b) const;
+        // S = (A * v^u)^b % N, u < 2^160, b < 2^152. Return false if A % N == 0 (SRP safeguard)
+        bool ComputeSessionSecret(Number const& A, Number const& v, Number const& u, Number const& b, Number& S) const;
+
+    private:
+        static uint32 const LIMBS = NUMBER_BYTES / 8;
+        static uint32 const WINDOW_BITS = 4;
+        static uint32 const WINDOW_SIZE = 1 << WINDOW_BITS;
+
+        typedef std::array<uint64, LIMBS> Limbs;
+
+        SRP6();
+
+        static Limbs ToLimbs(Number const& number);
+        static Number ToBytes(Limbs const& limbs);
+        static uint32 GetWindow(Number const& exponent, uint32 window);
+        static void Select(Limbs const* table, uint32 index, Limbs& result);
+
+        Limbs MontMul(Limbs const& a, Limbs const& b) const;
+        Limbs ModAdd(Limbs const& a, Limbs const& b) const;
+        Limbs ToMont(Limbs const& a) const { return MontMul(a, _R2); }
+        Limbs FromMont(Limbs const& a) const;
+        // base and result in Montgomery form, exponent < 2^(8 * exponentBytes)
+        Limbs MontExp(Limbs const& base, Number const& exponent, uint32 exponentBytes) const;
+        // g^exponent in Montgomery form, from the precomputed table
+        Limbs MontExpG(Number const& exponent, uint32 exponentBytes) const;
+
+        Number _N;
+        Limbs _nLimbs;
+        uint64 _n0Inv;                                      // -N^-1 % 2^64
+        Limbs _R2;                                          // 2^512 % N
+        Limbs _one;                                         // 2^256 % N, 1 in Montgomery form
+        // _gTable[i][j] = g^(j * 16^i) in Montgomery form, for the windows of the largest exponent
+        std::array<std::array<Limbs, WINDOW_SIZE>, DIGEST_BYTES * 8 / WINDOW_BITS> _gTable;
+};
+
+#endif
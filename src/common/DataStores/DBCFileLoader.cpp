@@ -23,68 +23,135 @@
 #include "DBCFileLoader.h"
 #include "Errors.h"
 
-DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), stringSize(0), fieldsOffset(nullptr), data(nullptr), stringTable(nullptr) { }
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool DBCFileLoader::memoryMapped = true;
+
+DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), stringSize(0), fieldsOffset(nullptr), data(nullptr), stringTable(nullptr),
+    mapping(nullptr), mappingSize(0) { }
 
 bool DBCFileLoader::Load(char const* filename, char const* fmt)
 {
-    uint32 header;
-    if (data)
-    {
-        delete [] data;
-        data = nullptr;
-    }
+    Unload();
+
+    if (memoryMapped)
+        return LoadMapped(filename, fmt);
 
     FILE* f = fopen(filename, "rb");
     if (!f)
         return false;
 
-    if (fread(&header, 4, 1, f) != 1)                        // Number of records
+    unsigned char header[HEADER_SIZE];
+    if (fread(header, HEADER_SIZE, 1, f) != 1 || !ReadHeader(header))
     {
         fclose(f);
         return false;
     }
 
+    SetFieldsOffset(fmt);
 
-    EndianConvert(header);
+    data = new unsigned char[recordSize * recordCount + stringSize];
+    stringTable = data + recordSize*recordCount;
 
-    if (header != 0x43424457)                                //'WDBC'
+    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
     {
         fclose(f);
         return false;
     }
 
-    if (fread(&recordCount, 4, 1, f) != 1)                   // Number of records
+    fclose(f);
+
+    return true;
+}
+
+bool DBCFileLoader::LoadMapped(char const* filename, char const* fmt)
+{
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_WINDOWS
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < HEADER_SIZE)
     {
-        fclose(f);
+        CloseHandle(file);
         return false;
     }
 
-    EndianConvert(recordCount);
+    // the view keeps the file and the mapping open
+    HANDLE fileMapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!fileMapping)
+        return false;
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                    // Number of fields
-    {
-        fclose(f);
+    mapping = MapViewOfFile(fileMapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(fileMapping);
+    if (!mapping)
         return false;
-    }
 
-    EndianConvert(fieldCount);
+    mappingSize = size_t(size.QuadPart);
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return false;
 
-    if (fread(&recordSize, 4, 1, f) != 1)                    // Size of a record
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < off_t(HEADER_SIZE))
     {
-        fclose(f);
+        close(fd);
         return false;
     }
 
-    EndianConvert(recordSize);
+    // writable for the few entries patched at startup, written pages become private
+    void* view = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED)
+        return false;
 
-    if (fread(&stringSize, 4, 1, f) != 1)                    // String size
+    mapping = view;
+    mappingSize = size_t(st.st_size);
+#endif
+
+    unsigned char* file = static_cast<unsigned char*>(mapping);
+    if (!ReadHeader(file) || HEADER_SIZE + uint64(recordSize) * recordCount + stringSize > mappingSize)
     {
-        fclose(f);
+        Unload();
         return false;
     }
 
-    EndianConvert(stringSize);
+    SetFieldsOffset(fmt);
+
+    data = file + HEADER_SIZE;
+    stringTable = data + recordSize * recordCount;
+    return true;
+}
+
+bool DBCFileLoader::ReadHeader(unsigned char const* header)
+{
+    uint32 fields[HEADER_SIZE / 4];
+    memcpy(fields, header, HEADER_SIZE);
+    for (uint32& field : fields)
+        EndianConvert(field);
 
+    if (fields[0] != 0x43424457)                             //'WDBC'
+        return false;
+
+    recordCount = fields[1];                                // Number of records
+    fieldCount = fields[2];                                 // Number of fields
+    recordSize = fields[3];                                 // Size of a record
+    stringSize = fields[4];                                 // String size
+    return true;
+}
+
+void DBCFileLoader::SetFieldsOffset(char const* fmt)
+{
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
     for (uint32 i = 1; i < fieldCount; ++i)
@@ -95,26 +162,33 @@ bool DBCFileLoader::Load(char const* filename, char const* fmt)
         else                                                // 4 byte fields (int32/float/strings)
             fieldsOffset[i] += sizeof(uint32);
     }
+}
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
-    stringTable = data + recordSize*recordCount;
-
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
+void DBCFileLoader::Unload()
+{
+    if (mapping)
     {
-        fclose(f);
-        return false;
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_WINDOWS
+        UnmapViewOfFile(mapping);
+#else
+        munmap(mapping, mappingSize);
+#endif
+        mapping = nullptr;
+        mappingSize = 0;
     }
+    else
+        delete[] data;
 
-    fclose(f);
+    data = nullptr;
+    stringTable = nullptr;
 
-    return true;
+    delete[] fieldsOffset;
+    fieldsOffset = nullptr;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    delete[] data;
-
-    delete[] fieldsOffset;
+    Unload();
 }
 
 DBCFileLoader::Record DBCFileLoader::getRecord(size_t id)
@@ -168,6 +242,26 @@ uint32 DBCFileLoader::GetFormatRecordSize(char const* format, int32* index_pos)
     return recordsize;
 }
 
+bool DBCFileLoader::IsInPlaceFormat(char const* format)
+{
+#if TRINITY_ENDIAN == TRINITY_LITTLEENDIAN
+    uint32 x = 0;
+    while (format[x] == FT_IND || format[x] == FT_INT || format[x] == FT_FLOAT)
+        ++x;
+
+    if (!x)
+        return false;
+
+    while (format[x] == FT_NA)
+        ++x;
+
+    return !format[x];
+#else
+    (void)format;
+    return false;
+#endif
+}
+
 char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**& indexTable)
 {
     /*
@@ -211,16 +305,22 @@ char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**
         indexTable = new ptr[recordCount];
     }
 
-    char* dataTable = new char[recordCount * recordsize];
+    // the struct is the beginning of the file record, aligned like the mapping
+    bool const inPlace = IsMapped() && IsInPlaceFormat(format) && recordSize >= recordsize && recordSize % sizeof(uint32) == 0;
+    char* dataTable = inPlace ? nullptr : new char[recordCount * recordsize];
 
     uint32 offset = 0;
 
     for (uint32 y = 0; y < recordCount; ++y)
     {
+        char* entry = inPlace ? reinterpret_cast<char*>(data + y * recordSize) : &dataTable[offset];
         if (i >= 0)
-            indexTable[getRecord(y).getUInt(i)] = &dataTable[offset];
+            indexTable[getRecord(y).getUInt(i)] = entry;
         else
-            indexTable[y] = &dataTable[offset];
+            indexTable[y] = entry;
+
+        if (inPlace)
+            continue;
 
         for (uint32 x=0; x < fieldCount; ++x)
         {
@@ -265,8 +365,13 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
     if (strlen(format) != fieldCount)
         return nullptr;
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+    // a mapped string block stays valid as long as the file is mapped, no need to copy it
+    char* stringPool = nullptr;
+    if (!IsMapped())
+    {
+        stringPool = new char[stringSize];
+        memcpy(stringPool, stringTable, stringSize);
+    }
 
     uint32 offset = 0;
 
@@ -293,7 +398,7 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
                     if (!*slot || !**slot)
                     {
                         const char * st = getRecord(y).getString(x);
-                        *slot = stringPool + (st - (char const*)stringTable);
+                        *slot = stringPool ? stringPool + (st - (char const*)stringTable) : const_cast<char*>(st);
                     }
                     offset += sizeof(char*);
                     break;
@@ -44,6 +44,7 @@ class TC_COMMON_API DBCFileLoader
         DBCFileLoader();
         ~DBCFileLoader();
 
+        // Maps the file when memory mapping is enabled, reads it in a heap buffer otherwise
         bool Load(const char *filename, const char *fmt);
 
         class Record
@@ -95,10 +96,29 @@ class TC_COMMON_API DBCFileLoader
         uint32 GetCols() const { return fieldCount; }
         uint32 GetOffset(size_t id) const { return (fieldsOffset != nullptr && id < fieldCount) ? fieldsOffset[id] : 0; }
         bool IsLoaded() const { return data != nullptr; }
+        bool IsMapped() const { return mapping != nullptr; }
+        // Returns null when the records of a mapped file are used in place
         char* AutoProduceData(char const* fmt, uint32& count, char**& indexTable);
+        // Returns null for a mapped file, strings then point into its string block
         char* AutoProduceStrings(char const* fmt, char* dataTable);
         static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = nullptr);
+        // Only 4 byte fields kept by the struct, optionally followed by unused fields
+        static bool IsInPlaceFormat(char const* format);
+
+        /**
+        * Mapped files are private copy on write mappings: pages nobody writes to stay shared
+        * with the page cache and other processes, and are only read from the disk when used.
+        * Whoever uses records or strings of a mapped file must keep the loader alive.
+        */
+        static void SetMemoryMapped(bool mapped) { memoryMapped = mapped; }
+        static bool IsMemoryMapped() { return memoryMapped; }
     private:
+        static uint32 const HEADER_SIZE = 20;
+
+        bool LoadMapped(char const* filename, char const* fmt);
+        bool ReadHeader(unsigned char const* header);
+        void SetFieldsOffset(char const* fmt);
+        void Unload();
 
         uint32 recordSize;
         uint32 recordCount;
@@ -107,6 +127,10 @@ class TC_COMMON_API DBCFileLoader
         uint32 *fieldsOffset;
         unsigned char *data;
         unsigned char *stringTable;
+        void *mapping;
+        size_t mappingSize;
+
+        static bool memoryMapped;
 
         DBCFileLoader(DBCFileLoader const& right) = delete;
         DBCFileLoader& operator=(DBCFileLoader const& right) = delete;
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2008-2019 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ParallelTasks_h__
+#define ParallelTasks_h__
+
+#include "Define.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace Trinity
+{
+    // Calls task(0) to task(count - 1), spread over threadCount threads, each thread taking the next index
+    // when done with the previous one. Runs on the calling thread with 0 or 1 thread.
+    template<class Task>
+    void RunParallelTasks(size_t count, uint32 threadCount, Task const& task)
+    {
+        if (threadCount <= 1)
+        {
+            for (size_t i = 0; i < count; ++i)
+                task(i);
+            return;
+        }
+
+        std::atomic<size_t> next(0);
+        std::vector<std::thread> workers;
+        for (uint32 t = 0; t < threadCount; ++t)
+            workers.emplace_back([&]()
+            {
+                for (size_t i = next++; i < count; i = next++)
+                    task(i);
+            });
+
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+}
+
+#endif // ParallelTasks_h__
@@ -18,6 +18,7 @@
 #ifndef _PCQ_H
 #define _PCQ_H
 
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
@@ -52,6 +53,13 @@ public:
         return _queue.empty();
     }
 
+    size_t Size()
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+
+        return _queue.size();
+    }
+
     bool Pop(T& value)
     {
         std::lock_guard<std::mutex> lock(_queueLock);
@@ -82,6 +90,26 @@ public:
         _queue.pop();
     }
 
+    // Returns false if nothing was pushed before the deadline
+    template<class Clock, class Duration>
+    bool WaitAndPopUntil(T& value, std::chrono::time_point<Clock, Duration> const& deadline)
+    {
+        std::unique_lock<std::mutex> lock(_queueLock);
+
+        while (_queue.empty() && !_shutdown)
+            if (_condition.wait_until(lock, deadline) == std::cv_status::timeout)
+                break;
+
+        if (_queue.empty() || _shutdown)
+            return false;
+
+        value = _queue.front();
+
+        _queue.pop();
+
+        return true;
+    }
+
     void Cancel()
     {
         _queueLock.lock();
@@ -18,11 +18,14 @@
 #include "EventMap.h"
 #include "Random.h"
 #include "Errors.h"
+#include <algorithm>
+#include <limits>
 
 void EventMap::Reset()
 {
-    _eventMap.clear();
+    _eventMap.Reset();
     _time = 0;
+    _timeOffset = 0;
     _phase = 0;
 }
 
@@ -49,7 +52,7 @@ void EventMap::ScheduleEvent(uint32 eventId, uint32 time, uint32 group /*= 0*/,
     if (phase && phase <= 8)
         eventId |= (1 << (phase + 23));
 
-    _eventMap.insert(EventStore::value_type(_time + time, eventId));
+    _eventMap.Schedule(GetStoreTime(time), eventId);
 }
 
 void EventMap::RescheduleEvent(uint32 eventId, Milliseconds minTime, Milliseconds maxTime, uint32 group /*= 0*/, uint32 phase /*= 0*/)
@@ -64,45 +67,48 @@ void EventMap::Repeat(uint32 minTime, uint32 maxTime)
 
 uint32 EventMap::ExecuteEvent()
 {
-    while (!Empty())
+    _eventMap.Advance(GetStoreTime(0));
+
+    while (_eventMap.HasDue())
     {
-        EventStore::iterator itr = _eventMap.begin();
-
-        if (itr->first > _time)
-            return 0;
-        else if (_phase && (itr->second & 0xFF000000) && !((itr->second >> 24) & _phase))
-            _eventMap.erase(itr);
-        else
-        {
-            uint32 eventId = (itr->second & 0x0000FFFF);
-            _lastEvent = itr->second; // include phase/group
-            _eventMap.erase(itr);
-            return eventId;
-        }
+        uint32 event = _eventMap.PopDue();
+
+        if (_phase && (event & 0xFF000000) && !((event >> 24) & _phase))
+            continue;
+
+        _lastEvent = event; // include phase/group
+        return (event & 0x0000FFFF);
     }
 
     return 0;
 }
 
-void EventMap::DelayEvents(uint32 delay, uint32 group)
+void EventMap::DelayEvents(uint32 delay)
 {
-    if (!group || group > 8 || Empty())
+    // _time is lowered, the keys are moved forward so the wheel time stays the same
+    delay = std::min(delay, _time);
+    if (!delay)
         return;
 
-    EventStore delayed;
+    _time -= delay;
+    _timeOffset += delay;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    _eventMap.ForEach([&](EventStore::Handle handle, uint32 /*event*/)
     {
-        if (itr->second & (1 << (group + 15)))
-        {
-            delayed.insert(EventStore::value_type(itr->first + delay, itr->second));
-            _eventMap.erase(itr++);
-        }
-        else
-            ++itr;
-    }
+        _eventMap.Delay(handle, _eventMap.GetScheduledTime(handle) + delay);
+    });
+}
 
-    _eventMap.insert(delayed.begin(), delayed.end());
+void EventMap::DelayEvents(uint32 delay, uint32 group)
+{
+    if (!group || group > 8 || Empty())
+        return;
+
+    _eventMap.ForEach([&](EventStore::Handle handle, uint32 event)
+    {
+        if (event & (1 << (group + 15)))
+            _eventMap.Delay(handle, _eventMap.GetScheduledTime(handle) + delay);
+    });
 }
 
 void EventMap::SetMinimalDelay(uint32 eventId, uint32 delay)
@@ -110,20 +116,11 @@ void EventMap::SetMinimalDelay(uint32 eventId, uint32 delay)
     if (Empty())
         return;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    _eventMap.ForEach([&](EventStore::Handle handle, uint32 event)
     {
-        if (eventId == (itr->second & 0x0000FFFF))
-        {
-            if (itr->first < delay)
-            {
-                _eventMap.insert(EventStore::value_type(delay, itr->second));
-                itr = _eventMap.erase(itr);
-                continue;
-            }
-
-        }
-        itr++;
-    }
+        if (eventId == (event & 0x0000FFFF) && _eventMap.GetScheduledTime(handle) - _timeOffset < delay)
+            _eventMap.Reschedule(handle, _timeOffset + delay);
+    });
 }
 
 void EventMap::CancelEvent(uint32 eventId)
@@ -131,13 +128,10 @@ void EventMap::CancelEvent(uint32 eventId)
     if (Empty())
         return;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    _eventMap.RemoveIf([eventId](uint32 event)
     {
-        if (eventId == (itr->second & 0x0000FFFF))
-            _eventMap.erase(itr++);
-        else
-            ++itr;
-    }
+        return eventId == (event & 0x0000FFFF);
+    });
 }
 
 void EventMap::CancelEventGroup(uint32 group)
@@ -145,13 +139,24 @@ void EventMap::CancelEventGroup(uint32 group)
     if (!group || group > 8 || Empty())
         return;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    _eventMap.RemoveIf([group](uint32 event)
     {
-        if (itr->second & (1 << (group + 15)))
-            _eventMap.erase(itr++);
-        else
-            ++itr;
-    }
+        return (event & (1 << (group + 15))) != 0;
+    });
+}
+
+uint32 EventMap::GetNextEventTime() const
+{
+    if (Empty())
+        return 0;
+
+    uint64 next = std::numeric_limits<uint64>::max();
+    _eventMap.ForEach([&](EventStore::Handle handle, uint32 /*event*/)
+    {
+        next = std::min(next, _eventMap.GetScheduledTime(handle));
+    });
+
+    return uint32(next - _timeOffset);
 }
 
 uint32 EventMap::GetNextEventTime(uint32 eventId) const
@@ -159,18 +164,30 @@ uint32 EventMap::GetNextEventTime(uint32 eventId) const
     if (Empty())
         return 0;
 
-    for (EventStore::const_iterator itr = _eventMap.begin(); itr != _eventMap.end(); ++itr)
-        if (eventId == (itr->second & 0x0000FFFF))
-            return itr->first;
+    uint64 next = std::numeric_limits<uint64>::max();
+    _eventMap.ForEach([&](EventStore::Handle handle, uint32 event)
+    {
+        if (eventId == (event & 0x0000FFFF))
+            next = std::min(next, _eventMap.GetScheduledTime(handle));
+    });
 
-    return 0;
+    if (next == std::numeric_limits<uint64>::max())
+        return 0;
+
+    return uint32(next - _timeOffset);
 }
 
 uint32 EventMap::GetTimeUntilEvent(uint32 eventId) const
 {
-    for (EventStore::const_iterator itr = _eventMap.begin(); itr != _eventMap.end(); ++itr)
-        if (eventId == (itr->second & 0x0000FFFF))
-            return itr->first - _time;
+    uint64 next = std::numeric_limits<uint64>::max();
+    _eventMap.ForEach([&](EventStore::Handle handle, uint32 event)
+    {
+        if (eventId == (event & 0x0000FFFF))
+            next = std::min(next, _eventMap.GetScheduledTime(handle));
+    });
+
+    if (next == std::numeric_limits<uint64>::max())
+        return std::numeric_limits<uint32>::max();
 
-    return std::numeric_limits<uint32>::max();
+    return uint32(next - GetStoreTime(0));
 }
@@ -20,13 +20,13 @@
 
 #include "Define.h"
 #include "Duration.h"
-#include <map>
+#include "TimingWheel.h"
 
 class TC_COMMON_API EventMap
 {
     /**
     * Internal storage type.
-    * Key: Time as uint32 when the event should occur.
+    * Key: Time when the event should occur, as _time + _timeOffset.
     * Value: The event data as uint32.
     *
     * Structure of event data:
@@ -35,10 +35,10 @@ class TC_COMMON_API EventMap
     * - Bit 24 - 31: Phase
     * - Pattern: 0xPPGGEEEE
     */
-    typedef std::multimap<uint32, uint32> EventStore;
+    typedef TimingWheel<uint32> EventStore;
 
 public:
-    EventMap() : _time(0), _phase(0), _lastEvent(0) { }
+    EventMap() : _time(0), _timeOffset(0), _phase(0), _lastEvent(0) { }
 
     /**
     * @name Reset
@@ -80,7 +80,7 @@ public:
     */
     bool Empty() const
     {
-        return _eventMap.empty();
+        return _eventMap.Empty();
     }
 
     /**
@@ -201,7 +201,7 @@ public:
     */
     void Repeat(uint32 time)
     {
-        _eventMap.insert(EventStore::value_type(_time + time, _lastEvent));
+        _eventMap.Schedule(GetStoreTime(time), _lastEvent);
     }
 
     /**
@@ -245,10 +245,7 @@ public:
     * @brief Delays all events in the map. If delay is greater than or equal internal timer, delay will be equal to internal timer.
     * @param delay Amount of delay.
     */
-    void DelayEvents(uint32 delay)
-    {
-        _time = delay < _time ? _time - delay : 0;
-    }
+    void DelayEvents(uint32 delay);
 
     /**
     * @name DelayEvents
@@ -301,10 +298,7 @@ public:
     * @name GetNextEventTime
     * @return Time of next event.
     */
-    uint32 GetNextEventTime() const
-    {
-        return Empty() ? 0 : _eventMap.begin()->first;
-    }
+    uint32 GetNextEventTime() const;
 
     /**
     * @name IsInPhase
@@ -326,6 +320,15 @@ public:
     uint32 GetTimeUntilEvent(uint32 eventId) const;
 
 private:
+    /**
+    * @name GetStoreTime
+    * @brief Returns the key in _eventMap of an event occurring after the given delay.
+    */
+    uint64 GetStoreTime(uint32 delay) const
+    {
+        return uint64(_time) + _timeOffset + delay;
+    }
+
     /**
     * @name _time
     * @brief Internal timer.
@@ -338,6 +341,16 @@ private:
     */
     uint32 _time;
 
+    /**
+    * @name _timeOffset
+    * @brief Total delay applied with DelayEvents.
+    *
+    * _time goes back when all events are delayed, while the time
+    * of _eventMap can only go forward. The events are moved forward
+    * instead and _time + _timeOffset stays the time of _eventMap.
+    */
+    uint64 _timeOffset;
+
     /**
     * @name _phase
     * @brief Phase mask of the event map.
@@ -32,14 +32,14 @@ void EventProcessor::Update(uint32 p_time)
 {
     // update time
     m_time += p_time;
+    m_events.Advance(m_time);
 
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (m_events.HasDue())
     {
         // get and remove event from queue
-        BasicEvent* event = i->second;
-        m_events.erase(i);
+        BasicEvent* event = m_events.PopDue();
+        event->m_handle = EventList::INVALID_HANDLE;
 
         if (event->IsRunning())
         {
@@ -76,34 +76,27 @@ void EventProcessor::KillAllEvents(bool force)
     m_aborting = true;
 
     // first, abort all existing events
-    for (auto itr = m_events.begin(); itr != m_events.end();)
+    m_events.RemoveIf([this, force](BasicEvent* event)
     {
         // Abort events which weren't aborted already
-        if (!itr->second->IsAborted())
+        if (!event->IsAborted())
         {
-            itr->second->SetAborted();
-            itr->second->Abort(m_time);
+            event->SetAborted();
+            event->Abort(m_time);
         }
 
         // Skip non-deletable events when we are
         // not forcing the event cancellation.
-        if (!force && !itr->second->IsDeletable())
-        {
-            ++itr;
-            continue;
-        }
+        if (!force && !event->IsDeletable())
+            return false;
 
-        delete itr->second;
-
-        if (force)
-            ++itr; // Clear the whole container when forcing
-        else
-            itr = m_events.erase(itr);
-    }
+        delete event;
+        return true;
+    });
 
     // fast clear event list (in force case)
     if (force)
-        m_events.clear();
+        m_events.Clear();
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -111,21 +104,17 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
     if (set_addtime)
         Event->m_addTime = m_time;
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    Event->m_handle = m_events.Schedule(e_time, Event);
 }
 
 void EventProcessor::ModifyEventTime(BasicEvent* Event, uint64 newTime)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
-    {
-        if (itr->second != Event)
-            continue;
+    // the handle may be outdated if the event is being executed
+    if (!m_events.IsScheduled(Event->m_handle) || m_events.Get(Event->m_handle) != Event)
+        return;
 
-        Event->m_execTime = newTime;
-        m_events.erase(itr);
-        m_events.insert(std::pair<uint64, BasicEvent*>(newTime, Event));
-        break;
-    }
+    Event->m_execTime = newTime;
+    m_events.Reschedule(Event->m_handle, newTime);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
@@ -21,10 +21,9 @@
 
 #include "Define.h"
 #include "Random.h"
+#include "TimingWheel.h"
 #include "advstd.h"
 
-#include <map>
-
 // Note. All times are in milliseconds here.
 
 class TC_COMMON_API BasicEvent
@@ -40,7 +39,7 @@ class TC_COMMON_API BasicEvent
 
     public:
         BasicEvent()
-            : m_abortState(AbortState::STATE_RUNNING), m_addTime(0), m_execTime(0) { }
+            : m_abortState(AbortState::STATE_RUNNING), m_addTime(0), m_execTime(0), m_handle(TimingWheel<BasicEvent*>::INVALID_HANDLE) { }
         virtual ~BasicEvent() = default;                           // override destructor to perform some actions on event removal
 
         // this method executes when the event is triggered
@@ -66,6 +65,7 @@ private:
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
+        TimingWheel<BasicEvent*>::Handle m_handle;          // position in the event list of the event handler
 };
 
 template<typename T>
@@ -88,7 +88,7 @@ private:
 template<typename T>
 using is_lambda_event = std::enable_if_t<!advstd::is_base_of_v<BasicEvent, std::remove_pointer_t<advstd::remove_cvref_t<T>>>>;
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+typedef TimingWheel<BasicEvent*> EventList;
 
 class TC_COMMON_API EventProcessor
 {
@@ -0,0 +1,236 @@
+/*
+* Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ObjectPool.h"
+#include "Errors.h"
+#include <new>
+
+// header in front of every block, owner is null for heap allocations
+struct alignas(16) ObjectPool::Block
+{
+    ThreadCache* owner;
+    Block* next;
+};
+
+struct ObjectPool::ThreadCache
+{
+    explicit ThreadCache(ObjectPool* pool) : pool(pool), freeList(nullptr), freeCount(0), remoteFrees(nullptr),
+        allocated(0), reused(0), remoteFreed(0), released(0), cached(0) { }
+
+    ObjectPool* pool;
+    Block* freeList;
+    uint32 freeCount;
+    // pushed by any thread, taken as a whole by the owner
+    std::atomic<Block*> remoteFrees;
+
+    // only written by the owner (remoteFreed by the freeing threads), read by GetStats
+    std::atomic<uint64> allocated;
+    std::atomic<uint64> reused;
+    std::atomic<uint64> remoteFreed;
+    std::atomic<uint64> released;
+    std::atomic<uint64> cached;
+
+    void Bump(std::atomic<uint64>& counter) { counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+};
+
+struct ObjectPool::ThreadCaches
+{
+    ThreadCaches() : caches() { }
+    ~ThreadCaches();
+
+    ThreadCache* caches[MAX_POOLS];
+};
+
+static std::mutex poolsLock;
+static std::vector<ObjectPool*> pools;
+
+// objects may be freed by other thread_local destructors after ours ran
+static thread_local bool threadCachesDestroyed = false;
+
+std::atomic<bool> ObjectPool::_enabled(true);
+
+ObjectPool::ThreadCaches::~ThreadCaches()
+{
+    threadCachesDestroyed = true;
+    for (ThreadCache* cache : caches)
+        if (cache)
+            cache->pool->Orphan(cache);
+}
+
+void ObjectPoolStats::Add(ObjectPoolStats const& other)
+{
+    allocated += other.allocated;
+    reused += other.reused;
+    remoteFreed += other.remoteFreed;
+    released += other.released;
+    cached += other.cached;
+}
+
+ObjectPool::ObjectPool(char const* name, size_t blockSize, uint32 maxCached) : _name(name), _blockSize(blockSize), _maxCached(maxCached)
+{
+    std::lock_guard<std::mutex> lock(poolsLock);
+    ASSERT(pools.size() < MAX_POOLS);
+    _index = pools.size();
+    pools.push_back(this);
+}
+
+ObjectPool::ThreadCaches* ObjectPool::GetThreadCaches()
+{
+    if (threadCachesDestroyed)
+        return nullptr;
+
+    static thread_local ThreadCaches threadCaches;
+    return &threadCaches;
+}
+
+ObjectPool::ThreadCache* ObjectPool::GetThreadCache()
+{
+    ThreadCaches* threadCaches = GetThreadCaches();
+    if (!threadCaches)
+        return nullptr;
+
+    ThreadCache*& cache = threadCaches->caches[_index];
+    if (cache)
+        return cache;
+
+    std::lock_guard<std::mutex> lock(_cachesLock);
+    if (!_orphans.empty())
+    {
+        cache = _orphans.back();
+        _orphans.pop_back();
+    }
+    else
+    {
+        cache = new ThreadCache(this);
+        _caches.push_back(cache);
+    }
+    return cache;
+}
+
+void ObjectPool::Orphan(ThreadCache* cache)
+{
+    std::lock_guard<std::mutex> lock(_cachesLock);
+    _orphans.push_back(cache);
+}
+
+void* ObjectPool::Allocate(size_t size)
+{
+    ThreadCache* cache = size <= _blockSize && IsEnabled() ? GetThreadCache() : nullptr;
+    if (!cache)
+    {
+        Block* block = static_cast<Block*>(::operator new(sizeof(Block) + size));
+        block->owner = nullptr;
+        return block + 1;
+    }
+
+    if (!cache->freeList)
+    {
+        // take back the blocks freed by other threads
+        Block* remote = cache->remoteFrees.exchange(nullptr, std::memory_order_acquire);
+        while (remote)
+        {
+            Block* next = remote->next;
+            if (cache->freeCount < _maxCached)
+            {
+                remote->next = cache->freeList;
+                cache->freeList = remote;
+                ++cache->freeCount;
+            }
+            else
+            {
+                ::operator delete(remote);
+                cache->Bump(cache->released);
+            }
+            remote = next;
+        }
+    }
+
+    Block* block = cache->freeList;
+    if (block)
+    {
+        cache->freeList = block->next;
+        --cache->freeCount;
+        cache->Bump(cache->reused);
+    }
+    else
+    {
+        block = static_cast<Block*>(::operator new(sizeof(Block) + _blockSize));
+        block->owner = cache;
+        cache->Bump(cache->allocated);
+    }
+    cache->cached.store(cache->freeCount, std::memory_order_relaxed);
+    return block + 1;
+}
+
+void ObjectPool::Free(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    Block* block = static_cast<Block*>(ptr) - 1;
+    ThreadCache* owner = block->owner;
+    if (!owner)
+    {
+        ::operator delete(block);
+        return;
+    }
+
+    ThreadCaches* threadCaches = GetThreadCaches();
+    if (threadCaches && threadCaches->caches[owner->pool->_index] == owner)
+    {
+        if (owner->freeCount >= owner->pool->_maxCached)
+        {
+            ::operator delete(block);
+            owner->Bump(owner->released);
+            return;
+        }
+
+        block->next = owner->freeList;
+        owner->freeList = block;
+        ++owner->freeCount;
+        owner->cached.store(owner->freeCount, std::memory_order_relaxed);
+        return;
+    }
+
+    // owned by another thread, or by an exited thread until its cache is adopted
+    Block* head = owner->remoteFrees.load(std::memory_order_relaxed);
+    do
+        block->next = head;
+    while (!owner->remoteFrees.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+    owner->remoteFreed.fetch_add(1, std::memory_order_relaxed);
+}
+
+ObjectPoolStats ObjectPool::GetStats() const
+{
+    ObjectPoolStats stats;
+    std::lock_guard<std::mutex> lock(_cachesLock);
+    for (ThreadCache const* cache : _caches)
+    {
+        stats.allocated += cache->allocated.load(std::memory_order_relaxed);
+        stats.reused += cache->reused.load(std::memory_order_relaxed);
+        stats.remoteFreed += cache->remoteFreed.load(std::memory_order_relaxed);
+        stats.released += cache->released.load(std::memory_order_relaxed);
+        stats.cached += cache->cached.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+std::vector<ObjectPool const*> ObjectPool::GetPools()
+{
+    std::lock_guard<std::mutex> lock(poolsLock);
+    return std::vector<ObjectPool const*>(pools.begin(), pools.end());
+}
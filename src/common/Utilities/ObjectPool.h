@@ -0,0 +1,95 @@
+/*
+* Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _OBJECT_POOL_H_
+#define _OBJECT_POOL_H_
+
+#include "Define.h"
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+struct ObjectPoolStats
+{
+    uint64 allocated = 0;                   // blocks taken from the heap
+    uint64 reused = 0;                      // allocations served from a free list
+    uint64 remoteFreed = 0;                 // blocks freed by another thread than the one which allocated them
+    uint64 released = 0;                    // blocks given back to the heap because the free list was full
+    uint64 cached = 0;                      // blocks currently waiting in the free lists
+
+    void Add(ObjectPoolStats const& other);
+};
+
+/**
+* Pool of fixed size memory blocks, meant to back the class operator new/delete of short lived
+* objects created at a high rate (spells, auras).
+*
+* Every thread allocates from its own free list, without locking. A block remembers the thread
+* cache it came from: freeing it from that thread puts it back in the local free list, freeing it
+* from another thread pushes it to a lock free list of the owner, which takes it back on its next
+* allocation. Free lists keep at most maxCached blocks, extra blocks go back to the heap.
+* When a thread exits, its cache is kept for the next thread created, so blocks still in use stay valid.
+*
+* Requests bigger than the block size, and all requests while pooling is disabled, go to the heap.
+* Pools are created once and never destroyed.
+*/
+class TC_COMMON_API ObjectPool
+{
+public:
+    static uint32 const MAX_POOLS = 8;
+
+    ObjectPool(char const* name, size_t blockSize, uint32 maxCached);
+    ObjectPool(ObjectPool const&) = delete;
+    ObjectPool& operator=(ObjectPool const&) = delete;
+
+    void* Allocate(size_t size);
+    // ptr must come from Allocate of any pool
+    static void Free(void* ptr);
+
+    char const* GetName() const { return _name; }
+    size_t GetBlockSize() const { return _blockSize; }
+    ObjectPoolStats GetStats() const;
+
+    // Disabling only affects later allocations, pooled blocks can still be freed
+    static void SetEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+    static bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+    static std::vector<ObjectPool const*> GetPools();
+
+private:
+    struct Block;
+    struct ThreadCache;
+    struct ThreadCaches;
+
+    // null once the thread caches of the calling thread were destroyed
+    static ThreadCaches* GetThreadCaches();
+    ThreadCache* GetThreadCache();
+    void Orphan(ThreadCache* cache);
+
+    char const* _name;
+    size_t _blockSize;
+    uint32 _maxCached;
+    uint32 _index;
+
+    mutable std::mutex _cachesLock;
+    std::vector<ThreadCache*> _caches;      // all caches ever created, for stats
+    std::vector<ThreadCache*> _orphans;     // caches of exited threads, adopted by new threads
+
+    static std::atomic<bool> _enabled;
+};
+
+#endif
@@ -90,14 +90,11 @@ void TaskScheduler::Dispatch(success_t const& callback)
             return;
     }
 
-    while (!_task_holder.IsEmpty())
+    while (TaskContainer task = _task_holder.PopDue(_now))
     {
-        if (_task_holder.First()->_end > _now)
-            break;
-
         // Perfect forward the context to the handler
         // Use weak references to catch destruction before callbacks.
-        TaskContext context(_task_holder.Pop(), std::weak_ptr<TaskScheduler>(self_reference));
+        TaskContext context(std::move(task), std::weak_ptr<TaskScheduler>(self_reference));
 
         // Invoke the context
         context.Invoke();
@@ -111,55 +108,57 @@ void TaskScheduler::Dispatch(success_t const& callback)
     callback();
 }
 
-void TaskScheduler::TaskQueue::Push(TaskContainer&& task)
+uint64 TaskScheduler::TaskQueue::ToTick(timepoint_t const& time) const
 {
-    container.insert(task);
+    if (time <= _base)
+        return 0;
+
+    return uint64(std::chrono::ceil<std::chrono::milliseconds>(time - _base).count());
 }
 
-auto TaskScheduler::TaskQueue::Pop() -> TaskContainer
+void TaskScheduler::TaskQueue::Push(TaskContainer&& task)
 {
-    TaskContainer result = *container.begin();
-    container.erase(container.begin());
-    return result;
+    uint64 const tick = ToTick(task->_end);
+    container.Schedule(tick, std::move(task));
 }
 
-auto TaskScheduler::TaskQueue::First() const -> TaskContainer const&
+auto TaskScheduler::TaskQueue::PopDue(timepoint_t const& now) -> TaskContainer
 {
-    return *container.begin();
+    // Tasks ending within the current millisecond are due once now passed their end. Due tasks are
+    // ordered by end, if the first one did not end yet none did.
+    container.Advance(ToTick(now));
+
+    if (!container.HasDue() || container.Get(container.FrontDue())->_end > now)
+        return nullptr;
+
+    return container.PopDue();
 }
 
 void TaskScheduler::TaskQueue::Clear()
 {
-    container.clear();
+    container.Clear();
 }
 
 void TaskScheduler::TaskQueue::RemoveIf(std::function<bool(TaskContainer const&)> const& filter)
 {
-    for (auto itr = container.begin(); itr != container.end();)
-        if (filter(*itr))
-            itr = container.erase(itr);
-        else
-            ++itr;
+    container.RemoveIf([&filter](TaskContainer const& task) -> bool
+    {
+        return filter(task);
+    });
 }
 
 void TaskScheduler::TaskQueue::ModifyIf(std::function<bool(TaskContainer const&)> const& filter)
 {
-    std::vector<TaskContainer> cache;
-    for (auto itr = container.begin(); itr != container.end();)
-        if (filter(*itr))
-        {
-            cache.push_back(*itr);
-            itr = container.erase(itr);
-        }
-        else
-            ++itr;
-
-    container.insert(cache.begin(), cache.end());
+    container.ForEach([&](TimingWheel<TaskContainer, TaskEndOrder>::Handle handle, TaskContainer const& task)
+    {
+        if (filter(task))
+            container.Reschedule(handle, ToTick(task->_end));
+    });
 }
 
 bool TaskScheduler::TaskQueue::IsEmpty() const
 {
-    return container.empty();
+    return container.Empty();
 }
 
 TaskContext& TaskContext::Dispatch(std::function<TaskScheduler&(TaskScheduler&)> const& apply)
@@ -21,13 +21,13 @@
 #include "Duration.h"
 #include "Optional.h"
 #include "Random.h"
+#include "TimingWheel.h"
 #include <algorithm>
 #include <chrono>
 #include <vector>
 #include <queue>
 #include <memory>
 #include <utility>
-#include <set>
 
 class TaskContext;
 
@@ -120,27 +120,34 @@ class TC_COMMON_API TaskScheduler
 
     typedef std::shared_ptr<Task> TaskContainer;
 
-    /// Container which provides Task order, insert and reschedule operations.
-    struct Compare
+    /// Orders the tasks due in the same millisecond by their end
+    struct TaskEndOrder
     {
-        bool operator() (TaskContainer const& left, TaskContainer const& right) const
+        bool operator()(TaskContainer const& left, TaskContainer const& right) const
         {
-            return (*left.get()) < (*right.get());
-        };
+            return left->_end < right->_end;
+        }
     };
 
+    /// Container which provides Task order, insert and reschedule operations.
+    /// Tasks are stored in a timing wheel ticking every millisecond since the given base.
     class TC_COMMON_API TaskQueue
     {
-        std::multiset<TaskContainer, Compare> container;
+        timepoint_t const _base;
+        TimingWheel<TaskContainer, TaskEndOrder> container;
+
+        /// Returns the first tick at or after the given time point
+        uint64 ToTick(timepoint_t const& time) const;
 
     public:
+        explicit TaskQueue(timepoint_t const& base) : _base(base) { }
+
         // Pushes the task in the container
         void Push(TaskContainer&& task);
 
-        /// Pops the task out of the container
-        TaskContainer Pop();
-
-        TaskContainer const& First() const;
+        /// Pops the next task ending at or before now out of the container,
+        /// returns an empty container if there is none.
+        TaskContainer PopDue(timepoint_t const& now);
 
         void Clear();
 
@@ -179,11 +186,11 @@ class TC_COMMON_API TaskScheduler
 
 public:
     TaskScheduler()
-        : self_reference(this, [](TaskScheduler const*) {}), _now(clock_t::now()), _predicate(EmptyValidator) { }
+        : self_reference(this, [](TaskScheduler const*) {}), _now(clock_t::now()), _task_holder(_now), _predicate(EmptyValidator) { }
 
     template<typename P>
     TaskScheduler(P&& predicate)
-        : self_reference(this, [](TaskScheduler const*) {}), _now(clock_t::now()), _predicate(std::forward<P>(predicate)) { }
+        : self_reference(this, [](TaskScheduler const*) {}), _now(clock_t::now()), _task_holder(_now), _predicate(std::forward<P>(predicate)) { }
 
     TaskScheduler(TaskScheduler const&) = delete;
     TaskScheduler(TaskScheduler&&) = delete;
@@ -0,0 +1,442 @@
+/*
+* Copyright (C) 2008-2018 TrinityCore <https://www.trinitycore.org/>
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+* more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _TIMING_WHEEL_H_
+#define _TIMING_WHEEL_H_
+
+#include "Define.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+* Hierarchical timing wheel, storing values of type T to expire at a given tick.
+*
+* The wheel has 4 levels of 64 slots, level N covering 64^(N+1) ticks, values further away wait
+* in an overflow list. Values are stored in nodes pooled by the wheel and referenced by handles,
+* scheduling, rescheduling and cancelling are O(1). Advancing costs one step per expired slot and
+* per 64 ticks crossed, values of higher levels are moved down when their slot is reached.
+*
+* Expired values are moved to a due queue, ordered by time, then by Order for values of the same
+* tick, then by scheduling order, which is the order a std::multimap keyed by time gives. Values
+* scheduled at or before the current time go directly to the due queue.
+*
+* The slots of a level are only allocated once a value is placed in this level.
+*/
+struct TimingWheelNoOrder
+{
+    template<class T>
+    bool operator()(T const& /*left*/, T const& /*right*/) const { return false; }
+};
+
+template<class T, class Order = TimingWheelNoOrder>
+class TimingWheel
+{
+public:
+    typedef uint32 Handle;
+    static constexpr Handle INVALID_HANDLE = 0xFFFFFFFF;
+
+    TimingWheel() : _now(0), _nextSeq(0), _size(0), _wheelCount(0), _free(INVALID_HANDLE), _overflowHead(INVALID_HANDLE),
+        _dueHead(INVALID_HANDLE), _dueTail(INVALID_HANDLE), _occupied() { }
+
+    /// Current tick of the wheel, values scheduled at or before it are due
+    uint64 GetTime() const { return _now; }
+    /// Number of scheduled values, including the due ones
+    size_t Size() const { return _size; }
+    bool Empty() const { return _size == 0; }
+
+    Handle Schedule(uint64 time, T value)
+    {
+        Handle handle = Allocate();
+        _nodes[handle].value = std::move(value);
+        _nodes[handle].seq = _nextSeq++;
+        Place(handle, time);
+        ++_size;
+        return handle;
+    }
+
+    /// Changes the time of a scheduled value, it is ordered after the values already scheduled at this time
+    void Reschedule(Handle handle, uint64 time)
+    {
+        Unlink(handle);
+        _nodes[handle].seq = _nextSeq++;
+        Place(handle, time);
+    }
+
+    /// Changes the time of a scheduled value, keeping its scheduling order: values moved by the same
+    /// delay stay in the same order
+    void Delay(Handle handle, uint64 time)
+    {
+        Unlink(handle);
+        Place(handle, time);
+    }
+
+    void Cancel(Handle handle)
+    {
+        Unlink(handle);
+        Release(handle);
+    }
+
+    bool IsScheduled(Handle handle) const { return handle < _nodes.size() && _nodes[handle].list != LIST_FREE; }
+    T const& Get(Handle handle) const { return _nodes[handle].value; }
+    uint64 GetScheduledTime(Handle handle) const { return _nodes[handle].time; }
+
+    /// Moves the wheel forward to the given tick, values expiring until then are moved to the due queue
+    void Advance(uint64 time)
+    {
+        while (_now < time)
+        {
+            if (!_wheelCount)
+            {
+                _now = time;
+                break;
+            }
+
+            // look for an occupied slot in the rest of the current level 0 rotation
+            uint64 rotationEnd = _now | SLOT_MASK;
+            uint64 limit = std::min(time, rotationEnd);
+            uint32 from = uint32(_now & SLOT_MASK) + 1;
+            uint32 to = uint32(limit & SLOT_MASK);
+            if (from <= to)
+            {
+                uint64 mask = (_occupied[0] >> from) << from;
+                if (to < SLOT_MASK)
+                    mask &= (uint64(2) << to) - 1;
+
+                if (mask)
+                {
+                    uint32 slot = LowestBit(mask);
+                    _now = (_now & ~uint64(SLOT_MASK)) | slot;
+                    Expire(slot);
+                    continue;
+                }
+            }
+
+            if (limit == time)
+            {
+                _now = time;
+                break;
+            }
+
+            _now = rotationEnd + 1;
+            Cascade();
+        }
+    }
+
+    bool HasDue() const { return _dueHead != INVALID_HANDLE; }
+    /// Handle of the first due value, INVALID_HANDLE if none
+    Handle FrontDue() const { return _dueHead; }
+
+    T PopDue()
+    {
+        Handle handle = _dueHead;
+        T value = std::move(_nodes[handle].value);
+        Cancel(handle);
+        return value;
+    }
+
+    /// Calls f(handle, value) for every scheduled value, in no particular order.
+    /// The value is a copy, f may schedule or cancel values.
+    template<class F>
+    void ForEach(F&& f)
+    {
+        for (Handle handle = 0; handle < _nodes.size(); ++handle)
+        {
+            if (_nodes[handle].list == LIST_FREE)
+                continue;
+
+            T value = _nodes[handle].value;
+            f(handle, value);
+        }
+    }
+
+    template<class F>
+    void ForEach(F&& f) const
+    {
+        for (Handle handle = 0; handle < _nodes.size(); ++handle)
+            if (_nodes[handle].list != LIST_FREE)
+                f(handle, _nodes[handle].value);
+    }
+
+    /// Cancels the values for which pred(value) returns true.
+    /// The value is a copy, pred may schedule or cancel values.
+    template<class P>
+    void RemoveIf(P&& pred)
+    {
+        for (Handle handle = 0; handle < _nodes.size(); ++handle)
+        {
+            if (_nodes[handle].list == LIST_FREE)
+                continue;
+
+            T value = _nodes[handle].value;
+            if (pred(value) && IsScheduled(handle))
+                Cancel(handle);
+        }
+    }
+
+    /// Cancels all values, the time of the wheel is kept
+    void Clear()
+    {
+        _nodes.clear();
+        for (std::vector<Handle>& slots : _slots)
+            slots.clear();
+        _size = 0;
+        _wheelCount = 0;
+        _free = INVALID_HANDLE;
+        _overflowHead = INVALID_HANDLE;
+        _dueHead = INVALID_HANDLE;
+        _dueTail = INVALID_HANDLE;
+        std::fill(std::begin(_occupied), std::end(_occupied), 0);
+    }
+
+    /// Cancels all values and sets the time of the wheel
+    void Reset(uint64 time = 0)
+    {
+        Clear();
+        _now = time;
+    }
+
+private:
+    static constexpr uint32 LEVELS = 4;
+    static constexpr uint32 SLOT_BITS = 6;
+    static constexpr uint32 SLOTS = 1 << SLOT_BITS;
+    static constexpr uint64 SLOT_MASK = SLOTS - 1;
+
+    // list ids: LEVELS * SLOTS wheel slots, then the overflow and due lists
+    static constexpr uint16 LIST_OVERFLOW = LEVELS * SLOTS;
+    static constexpr uint16 LIST_DUE = LIST_OVERFLOW + 1;
+    static constexpr uint16 LIST_FREE = 0xFFFF;
+
+    struct Node
+    {
+        uint64 time;
+        uint64 seq;
+        T value;
+        Handle prev;
+        Handle next;
+        uint16 list;
+    };
+
+    static uint32 LowestBit(uint64 mask)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, mask);
+        return uint32(index);
+#else
+        return uint32(__builtin_ctzll(mask));
+#endif
+    }
+
+    /// First node of a list, the slots of its level must be allocated
+    Handle& Head(uint16 list)
+    {
+        if (list == LIST_DUE)
+            return _dueHead;
+        if (list == LIST_OVERFLOW)
+            return _overflowHead;
+        return _slots[list / SLOTS][list % SLOTS];
+    }
+
+    /// Values ordered before the given one in the due queue
+    bool IsBefore(Node const& left, Node const& right) const
+    {
+        if (left.time != right.time)
+            return left.time < right.time;
+        if (_order(left.value, right.value))
+            return true;
+        if (_order(right.value, left.value))
+            return false;
+        return left.seq < right.seq;
+    }
+
+    Handle Allocate()
+    {
+        Handle handle = _free;
+        if (handle != INVALID_HANDLE)
+            _free = _nodes[handle].next;
+        else
+        {
+            handle = Handle(_nodes.size());
+            _nodes.emplace_back();
+        }
+
+        _nodes[handle].list = LIST_FREE;
+        return handle;
+    }
+
+    void Release(Handle handle)
+    {
+        Node& node = _nodes[handle];
+        node.value = T();
+        node.list = LIST_FREE;
+        node.next = _free;
+        _free = handle;
+        --_size;
+    }
+
+    void Place(Handle handle, uint64 time)
+    {
+        _nodes[handle].time = time;
+        if (time <= _now)
+        {
+            InsertDue(handle);
+            return;
+        }
+
+        uint16 list = LIST_OVERFLOW;
+        for (uint32 level = 0; level < LEVELS; ++level)
+        {
+            uint32 shift = SLOT_BITS * (level + 1);
+            if ((time >> shift) == (_now >> shift))
+            {
+                list = uint16(level * SLOTS + ((time >> (SLOT_BITS * level)) & SLOT_MASK));
+                if (_slots[level].empty())
+                    _slots[level].assign(SLOTS, INVALID_HANDLE);
+                break;
+            }
+        }
+
+        // slots are unordered, values of a slot are sorted when it expires
+        Node& node = _nodes[handle];
+        Handle& head = Head(list);
+        node.list = list;
+        node.prev = INVALID_HANDLE;
+        node.next = head;
+        if (node.next != INVALID_HANDLE)
+            _nodes[node.next].prev = handle;
+        head = handle;
+
+        if (list < LIST_OVERFLOW)
+            _occupied[list / SLOTS] |= uint64(1) << (list % SLOTS);
+        ++_wheelCount;
+    }
+
+    void InsertDue(Handle handle)
+    {
+        Node& node = _nodes[handle];
+        node.list = LIST_DUE;
+
+        // usually appended
+        Handle after = _dueTail;
+        while (after != INVALID_HANDLE && IsBefore(node, _nodes[after]))
+            after = _nodes[after].prev;
+
+        node.prev = after;
+        node.next = after != INVALID_HANDLE ? _nodes[after].next : _dueHead;
+        if (after != INVALID_HANDLE)
+            _nodes[after].next = handle;
+        else
+            _dueHead = handle;
+
+        if (node.next != INVALID_HANDLE)
+            _nodes[node.next].prev = handle;
+        else
+            _dueTail = handle;
+    }
+
+    void Unlink(Handle handle)
+    {
+        Node& node = _nodes[handle];
+        if (node.prev != INVALID_HANDLE)
+            _nodes[node.prev].next = node.next;
+        else
+            Head(node.list) = node.next;
+
+        if (node.next != INVALID_HANDLE)
+            _nodes[node.next].prev = node.prev;
+        else if (node.list == LIST_DUE)
+            _dueTail = node.prev;
+
+        if (node.list != LIST_DUE)
+        {
+            --_wheelCount;
+            if (node.list < LIST_OVERFLOW && Head(node.list) == INVALID_HANDLE)
+                _occupied[node.list / SLOTS] &= ~(uint64(1) << (node.list % SLOTS));
+        }
+    }
+
+    /// Detaches all values of a list into _scratch
+    void Detach(uint16 list)
+    {
+        _scratch.clear();
+        Handle& head = Head(list);
+        for (Handle handle = head; handle != INVALID_HANDLE; handle = _nodes[handle].next)
+            _scratch.push_back(handle);
+
+        head = INVALID_HANDLE;
+        if (list < LIST_OVERFLOW)
+            _occupied[list / SLOTS] &= ~(uint64(1) << (list % SLOTS));
+        _wheelCount -= _scratch.size();
+    }
+
+    /// Moves the values of a level 0 slot, all expiring at the current tick, to the due queue
+    void Expire(uint32 slot)
+    {
+        Detach(uint16(slot));
+        std::sort(_scratch.begin(), _scratch.end(), [this](Handle left, Handle right) { return IsBefore(_nodes[left], _nodes[right]); });
+        for (Handle handle : _scratch)
+            InsertDue(handle);
+    }
+
+    /// Moves down the values of the higher level slots starting at the current tick
+    void Cascade()
+    {
+        if ((_now & ((uint64(1) << (SLOT_BITS * LEVELS)) - 1)) == 0 && _overflowHead != INVALID_HANDLE)
+            Redistribute(LIST_OVERFLOW);
+
+        for (uint32 level = LEVELS - 1; level > 0; --level)
+        {
+            if ((_now & ((uint64(1) << (SLOT_BITS * level)) - 1)) != 0)
+                continue;
+
+            uint32 slot = uint32((_now >> (SLOT_BITS * level)) & SLOT_MASK);
+            if (_occupied[level] & (uint64(1) << slot))
+                Redistribute(uint16(level * SLOTS + slot));
+        }
+    }
+
+    void Redistribute(uint16 list)
+    {
+        Detach(list);
+        std::vector<Handle> handles;
+        handles.swap(_scratch);
+        for (Handle handle : handles)
+            Place(handle, _nodes[handle].time);
+        handles.swap(_scratch);
+    }
+
+    uint64 _now;
+    uint64 _nextSeq;
+    size_t _size;
+    size_t _wheelCount;                 // values in the wheel slots and the overflow list
+    Handle _free;                       // first node of the free list
+    Handle _overflowHead;
+    Handle _dueHead;
+    Handle _dueTail;
+    std::vector<Node> _nodes;
+    std::vector<Handle> _slots[LEVELS]; // first node of every slot, allocated with the first value of the level
+    uint64 _occupied[LEVELS];           // non empty slots of every level
+    Order _order;
+    std::vector<Handle> _scratch;
+};
+
+#endif // _TIMING_WHEEL_H_
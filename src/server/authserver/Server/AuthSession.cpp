@@ -5,6 +5,7 @@
 #include "Database/DatabaseEnv.h"
 #include "QueryCallback.h"
 #include "SHA1.h"
+#include "SRP6.h"
 #include "TOTP.h"
 #include "openssl/crypto.h"
 #include "Configuration/Config.h"
@@ -376,11 +377,10 @@ void AuthSession::LogonChallengeCallback(PreparedQueryResult result)
         v.SetHexStr(databaseV.c_str());
     }
 
-    b.SetRand(19 * 8);
-    BigNumber gmod = g.ModExp(b, N);
-    B = ((v * 3) + gmod) % N;
-
-    ASSERT(gmod.GetNumBytes() <= 32);
+    b.SetRand(SRP6::EPHEMERAL_BYTES * 8);
+    SRP6::Number const serverEphemeral = SRP6::Instance().ComputeServerEphemeral(SRP6::ToNumber(v.AsByteArray(32).get(), 32),
+        SRP6::ToNumber(b.AsByteArray(SRP6::EPHEMERAL_BYTES).get(), SRP6::EPHEMERAL_BYTES));
+    B.SetBinary(serverEphemeral.data(), serverEphemeral.size());
 
     // Fill the response packet with the result
     if (AuthHelper::IsAcceptedClientBuild(_build))
@@ -453,21 +453,19 @@ bool AuthSession::HandleLogonProof()
 
     A.SetBinary(logonProof->A, 32);
 
-    // SRP safeguard: abort if A == 0
-    if ((A % N).IsZero())
-        return false;
-
     SHA1Hash sha;
     sha.UpdateBigNumbers(&A, &B, NULL);
     sha.Finalize();
-    BigNumber u;
-    u.SetBinary(sha.GetDigest(), 20);
-    BigNumber S = (A * (v.ModExp(u, N))).ModExp(b, N);
+    // S = (A * v^u)^b % N, with u = sha(A, B)
+    SRP6::Number S;
+    if (!SRP6::Instance().ComputeSessionSecret(SRP6::ToNumber(logonProof->A, 32), SRP6::ToNumber(v.AsByteArray(32).get(), 32),
+        SRP6::ToNumber(sha.GetDigest(), SHA_DIGEST_LENGTH), SRP6::ToNumber(b.AsByteArray(SRP6::EPHEMERAL_BYTES).get(), SRP6::EPHEMERAL_BYTES), S))
+        return false; // SRP safeguard: abort if A % N == 0
 
     uint8 t[32];
     uint8 t1[16];
     uint8 vK[40];
-    memcpy(t, S.AsByteArray(32).get(), 32);
+    memcpy(t, S.data(), 32);
 
     for (int i = 0; i < 16; ++i)
         t1[i] = t[i * 2];
@@ -900,9 +898,8 @@ void AuthSession::SetVSFields(const std::string& rI)
     sha.UpdateData(s.AsByteArray(uint32(BufferSizes::SRP_6_S)).get(), (uint32(BufferSizes::SRP_6_S)));
     sha.UpdateData(mDigest, SHA_DIGEST_LENGTH);
     sha.Finalize();
-    BigNumber x;
-    x.SetBinary(sha.GetDigest(), sha.GetLength());
-    v = g.ModExp(x, N);
+    SRP6::Number const verifier = SRP6::Instance().ComputeVerifier(SRP6::ToNumber(sha.GetDigest(), sha.GetLength()));
+    v.SetBinary(verifier.data(), verifier.size());
 
     // No SQL injection (username escaped)
 
@@ -18,6 +18,7 @@
 #include "AdhocStatement.h"
 #include "Errors.h"
 #include "MySQLConnection.h"
+#include "QueryCompletion.h"
 #include "QueryResult.h"
 #include <cstdlib>
 #include <cstring>
@@ -48,10 +49,14 @@ bool BasicStatementTask::Execute()
         {
             delete result;
             m_result->set_value(QueryResult(nullptr));
+            if (m_completion)
+                m_completion->Complete();
             return false;
         }
 
         m_result->set_value(QueryResult(result));
+        if (m_completion)
+            m_completion->Complete();
         return true;
     }
 
@@ -21,6 +21,9 @@
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
 #include "SQLOperation.h"
+#include <memory>
+
+class QueryCompletion;
 
 /*! Raw, ad-hoc query. */
 class TC_DATABASE_API BasicStatementTask : public SQLOperation
@@ -31,11 +34,13 @@ class TC_DATABASE_API BasicStatementTask : public SQLOperation
 
         bool Execute() override;
         QueryResultFuture GetFuture() const { return m_result->get_future(); }
+        void SetCompletion(std::shared_ptr<QueryCompletion> completion) { m_completion = std::move(completion); }
 
     private:
         char const* m_sql;      //- Raw query to be executed
         bool m_has_result;
         QueryResultPromise* m_result;
+        std::shared_ptr<QueryCompletion> m_completion;  //- Completed once the result is set, may be null
 };
 
 #endif
@@ -41,6 +41,7 @@ class Transaction;
 typedef std::shared_ptr<Transaction> SQLTransaction;
 
 class SQLQueryHolder;
+class SQLQueryHolderBatch;
 typedef std::future<SQLQueryHolder*> QueryResultHolderFuture;
 typedef std::promise<SQLQueryHolder*> QueryResultHolderPromise;
 
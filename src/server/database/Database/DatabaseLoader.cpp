@@ -53,7 +53,10 @@ DatabaseLoader& DatabaseLoader::AddDatabase(DatabaseWorkerPool<T>& pool, std::st
 
         uint8 const synchThreads = uint8(sConfigMgr->GetIntDefault(name + "Database.SynchThreads", 1));
 
-        pool.SetConnectionInfo(dbString, asyncThreads, synchThreads);
+        uint32 const batchMaxSize = uint32(std::max(sConfigMgr->GetIntDefault(name + "Database.BatchSize", 32), 1));
+        uint32 const batchMaxDelay = uint32(std::max(sConfigMgr->GetIntDefault(name + "Database.BatchDelay", 0), 0));
+
+        pool.SetConnectionInfo(dbString, asyncThreads, synchThreads, batchMaxSize, batchMaxDelay);
         if (uint32 error = pool.Open())
         {
             // Database does not exist
@@ -16,14 +16,50 @@
  */
 
 #include "DatabaseWorker.h"
+#include "MySQLConnection.h"
 #include "SQLOperation.h"
 #include "ProducerConsumerQueue.h"
+#include <algorithm>
+
+void DatabaseStatementStats::Add(uint64 latency)
+{
+    ++count;
+    latencySum += latency;
+    latencyMax = std::max(latencyMax, latency);
+}
+
+void DatabaseStatementStats::Add(DatabaseStatementStats const& other)
+{
+    count += other.count;
+    latencySum += other.latencySum;
+    latencyMax = std::max(latencyMax, other.latencyMax);
+}
+
+void DatabaseWorkerStats::Add(DatabaseWorkerStats const& other)
+{
+    queued += other.queued;
+    operations += other.operations;
+    batches += other.batches;
+    batchedStatements += other.batchedStatements;
+    batchRetries += other.batchRetries;
+    for (uint32 i = 0; i < BATCH_SIZE_BUCKETS; ++i)
+        batchSizes[i] += other.batchSizes[i];
+    for (auto const& itr : other.statements)
+        statements[itr.first].Add(itr.second);
+}
+
+static uint64 GetLatency(SQLOperation const* operation, std::chrono::steady_clock::time_point now)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(now - operation->m_enqueueTime).count();
+}
 
 DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection)
 {
     _connection = connection;
     _queue = newQueue;
     _cancelationToken = false;
+    _batchMaxSize = connection->GetConnectionInfo().batchMaxSize;
+    _batchMaxDelay = connection->GetConnectionInfo().batchMaxDelay;
     _workerThread = std::thread(&DatabaseWorker::WorkerThread, this);
 }
 
@@ -41,18 +77,132 @@ void DatabaseWorker::WorkerThread()
     if (!_queue)
         return;
 
+    SQLOperation* next = nullptr;
     for (;;)
     {
         SQLOperation* operation = nullptr;
 
-        _queue->WaitAndPop(operation);
+        if (next)
+            std::swap(operation, next);
+        else
+            _queue->WaitAndPop(operation);
 
         if (_cancelationToken || !operation)
+        {
+            delete operation;
             return;
+        }
 
         operation->SetConnection(_connection);
-        operation->call();
+        if (_batchMaxSize > 1 && operation->IsBatchable())
+            ExecuteBatch(operation, next);
+        else
+            Execute(operation);
+    }
+}
+
+void DatabaseWorker::Execute(SQLOperation* operation)
+{
+    operation->call();
 
-        delete operation;
+    uint64 const latency = GetLatency(operation, std::chrono::steady_clock::now());
+    {
+        std::lock_guard<std::mutex> lock(_statsLock);
+        ++_stats.operations;
+        _stats.statements[operation->GetStatementIndex()].Add(latency);
     }
+
+    delete operation;
+}
+
+void DatabaseWorker::ExecuteBatch(SQLOperation* operation, SQLOperation*& next)
+{
+    _batch.clear();
+    _batch.push_back(operation);
+
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_batchMaxDelay);
+    while (_batch.size() < _batchMaxSize)
+    {
+        SQLOperation* queued = nullptr;
+        if (!_queue->Pop(queued) && (!_batchMaxDelay || !_queue->WaitAndPopUntil(queued, deadline)))
+            break;
+
+        queued->SetConnection(_connection);
+        if (!queued->IsBatchable())
+        {
+            next = queued;
+            break;
+        }
+
+        _batch.push_back(queued);
+    }
+
+    if (_batch.size() == 1)
+    {
+        Execute(operation);
+        return;
+    }
+
+    // A failed statement rolls back the whole batch, which is then executed one statement at a time
+    // to give every statement the result it would have had on its own. The failed statement already
+    // logged its error and is not executed again.
+    // Statements are not retried after a reconnection inside the batch: the transaction was lost with
+    // the connection, so every statement of the batch is executed again on the new one.
+    uint32 const reconnects = _connection->GetReconnectCount();
+    _connection->SetRetryOnReconnect(false);
+    size_t failedIndex = _batch.size();
+    bool failed = !_connection->BeginTransaction();
+    for (size_t i = 0; i < _batch.size() && !failed; ++i)
+    {
+        if (!_batch[i]->Execute())
+        {
+            failed = true;
+            failedIndex = i;
+        }
+    }
+
+    if (!failed)
+        failed = !_connection->CommitTransaction();
+    _connection->SetRetryOnReconnect(true);
+
+    if (failed)
+    {
+        bool const reconnected = _connection->GetReconnectCount() != reconnects;
+        if (reconnected)
+            failedIndex = _batch.size();
+        else
+            _connection->RollbackTransaction();
+
+        for (size_t i = 0; i < _batch.size(); ++i)
+            if (i != failedIndex)
+                _batch[i]->Execute();
+    }
+
+    auto const now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(_statsLock);
+        _stats.operations += _batch.size();
+        ++_stats.batches;
+        _stats.batchedStatements += _batch.size();
+        if (failed)
+            ++_stats.batchRetries;
+
+        uint32 bucket = 0;
+        for (size_t size = _batch.size() >> 2; size && bucket < DatabaseWorkerStats::BATCH_SIZE_BUCKETS - 1; size >>= 1)
+            ++bucket;
+        ++_stats.batchSizes[bucket];
+
+        for (SQLOperation* batched : _batch)
+            _stats.statements[batched->GetStatementIndex()].Add(GetLatency(batched, now));
+    }
+
+    for (SQLOperation* batched : _batch)
+        delete batched;
+    _batch.clear();
+}
+
+DatabaseWorkerStats DatabaseWorker::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(_statsLock);
+    return _stats;
 }
@@ -20,7 +20,10 @@
 
 #include "Define.h"
 #include <atomic>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 template <typename T>
 class ProducerConsumerQueue;
@@ -28,21 +31,59 @@ class ProducerConsumerQueue;
 class MySQLConnection;
 class SQLOperation;
 
+// Time async operations took from enqueued to executed (committed for batches), in microseconds
+struct DatabaseStatementStats
+{
+    uint64 count = 0;
+    uint64 latencySum = 0;
+    uint64 latencyMax = 0;
+
+    void Add(uint64 latency);
+    void Add(DatabaseStatementStats const& other);
+};
+
+struct DatabaseWorkerStats
+{
+    static uint32 const BATCH_SIZE_BUCKETS = 8;     // 2-3, 4-7, 8-15 ... 256 and more statements
+
+    uint64 queued = 0;                      // operations waiting in the queue, only set by DatabaseWorkerPool::GetStats
+    uint64 operations = 0;                  // operations executed, batched or not
+    uint64 batches = 0;                     // transactions made of several one-way statements
+    uint64 batchedStatements = 0;
+    uint64 batchRetries = 0;                // batches rolled back after an error, their statements executed one by one
+    uint64 batchSizes[BATCH_SIZE_BUCKETS] = { };
+    std::unordered_map<uint32, DatabaseStatementStats> statements;  // by prepared statement index, SQLOperation::NO_STATEMENT for other operations
+
+    void Add(DatabaseWorkerStats const& other);
+};
+
 class TC_DATABASE_API DatabaseWorker
 {
     public:
         DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection);
         ~DatabaseWorker();
 
+        DatabaseWorkerStats GetStats() const;
+
     private:
         ProducerConsumerQueue<SQLOperation*>* _queue;
         MySQLConnection* _connection;
 
         void WorkerThread();
+        void Execute(SQLOperation* operation);
+        // Executes operation and the batchable operations following it in the queue, next is the first other operation popped
+        void ExecuteBatch(SQLOperation* operation, SQLOperation*& next);
         std::thread _workerThread;
 
         std::atomic<bool> _cancelationToken;
 
+        uint32 _batchMaxSize;
+        uint32 _batchMaxDelay;
+        std::vector<SQLOperation*> _batch;
+
+        mutable std::mutex _statsLock;
+        DatabaseWorkerStats _stats;
+
         DatabaseWorker(DatabaseWorker const& right) = delete;
         DatabaseWorker& operator=(DatabaseWorker const& right) = delete;
 };
@@ -28,6 +28,7 @@
 #include "PreparedStatement.h"
 #include "ProducerConsumerQueue.h"
 #include "QueryCallback.h"
+#include "QueryCompletion.h"
 #include "QueryHolder.h"
 #include "QueryResult.h"
 #include "SQLOperation.h"
@@ -67,9 +68,11 @@ DatabaseWorkerPool<T>::~DatabaseWorkerPool()
 
 template <class T>
 void DatabaseWorkerPool<T>::SetConnectionInfo(std::string const& infoString,
-    uint8 const asyncThreads, uint8 const synchThreads)
+    uint8 const asyncThreads, uint8 const synchThreads, uint32 const batchMaxSize, uint32 const batchMaxDelay)
 {
     _connectionInfo = Trinity::make_unique<MySQLConnectionInfo>(infoString);
+    _connectionInfo->batchMaxSize = std::max(batchMaxSize, 1u);
+    _connectionInfo->batchMaxDelay = batchMaxDelay;
 
     _async_threads = asyncThreads;
     _synch_threads = synchThreads;
@@ -206,20 +209,24 @@ template <class T>
 QueryCallback DatabaseWorkerPool<T>::AsyncQuery(char const* sql)
 {
     BasicStatementTask* task = new BasicStatementTask(sql, true);
+    std::shared_ptr<QueryCompletion> completion = std::make_shared<QueryCompletion>(GetDatabaseName(), QueryCompletion::ADHOC_QUERY);
+    task->SetCompletion(completion);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     QueryResultFuture result = task->GetFuture();
     Enqueue(task);
-    return QueryCallback(std::move(result));
+    return QueryCallback(std::move(result), std::move(completion));
 }
 
 template <class T>
 QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement* stmt)
 {
     PreparedStatementTask* task = new PreparedStatementTask(stmt, true);
+    std::shared_ptr<QueryCompletion> completion = std::make_shared<QueryCompletion>(GetDatabaseName(), stmt->GetIndex());
+    task->SetCompletion(completion);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     PreparedQueryResultFuture result = task->GetFuture();
     Enqueue(task);
-    return QueryCallback(std::move(result));
+    return QueryCallback(std::move(result), std::move(completion));
 }
 
 template <class T>
@@ -232,6 +239,12 @@ QueryResultHolderFuture DatabaseWorkerPool<T>::DelayQueryHolder(SQLQueryHolder*
     return result;
 }
 
+template <class T>
+void DatabaseWorkerPool<T>::DelayQueryHolderBatch(SQLQueryHolderBatch* batch)
+{
+    Enqueue(new SQLQueryHolderBatchTask(batch));
+}
+
 template <class T>
 SQLTransaction DatabaseWorkerPool<T>::BeginTransaction()
 {
@@ -278,13 +291,13 @@ void DatabaseWorkerPool<T>::DirectCommitTransaction(SQLTransaction& transaction)
     {
         //todo: handle multiple sync threads deadlocking in a similar way as async threads
         uint8 loopBreaker = 5;
-        for (uint8 i = 0; i < loopBreaker; ++i)
-        {
-            if (!connection->ExecuteTransaction(transaction))
-                break;
-        }
+        for (uint8 i = 0; i < loopBreaker && errorCode; ++i)
+            errorCode = connection->ExecuteTransaction(transaction);
     }
 
+    if (errorCode)
+        transaction->Fail();
+
     //! Clean up now.
     transaction->Cleanup();
 
@@ -330,6 +343,16 @@ void DatabaseWorkerPool<T>::KeepAlive()
         Enqueue(new PingOperation);
 }
 
+template <class T>
+DatabaseWorkerStats DatabaseWorkerPool<T>::GetStats() const
+{
+    DatabaseWorkerStats stats;
+    for (auto const& connection : _connections[IDX_ASYNC])
+        stats.Add(connection->m_worker->GetStats());
+    stats.queued = _queue->Size();
+    return stats;
+}
+
 template <class T>
 uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConnections)
 {
@@ -381,6 +404,7 @@ unsigned long DatabaseWorkerPool<T>::EscapeString(char* to, char const* from, un
 template <class T>
 void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op)
 {
+    op->m_enqueueTime = std::chrono::steady_clock::now();
     _queue->Push(op);
 }
 
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include "DatabaseWorker.h"
 #include "StringFormat.h"
 #include <array>
 #include <string>
@@ -49,7 +50,10 @@ class DatabaseWorkerPool
 
         ~DatabaseWorkerPool();
 
-        void SetConnectionInfo(std::string const& infoString, uint8 const asyncThreads, uint8 const synchThreads);
+        //! Adjacent one-way prepared statements are executed by the async workers in transactions of up to batchMaxSize
+        //! statements, waiting at most batchMaxDelay ms for more of them. A batchMaxSize of 1 disables batching.
+        void SetConnectionInfo(std::string const& infoString, uint8 const asyncThreads, uint8 const synchThreads,
+            uint32 const batchMaxSize = 1, uint32 const batchMaxDelay = 0);
 
         uint32 Open();
 
@@ -171,6 +175,11 @@ class DatabaseWorkerPool
         //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
         QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder* holder);
 
+        //! Enqueues holders to be executed together, some of their queries replaced by a single query for the whole batch.
+        //! The futures returned by SQLQueryHolderBatch::AddHolder are set once every holder of the batch is executed.
+        //! Statements of the batch and of the holders need to be prepared with the CONNECTION_ASYNC flag.
+        void DelayQueryHolderBatch(SQLQueryHolderBatch* batch);
+
         /**
             Transaction context methods.
         */
@@ -211,6 +220,9 @@ class DatabaseWorkerPool
         //! Keeps all our MySQL connections alive, prevent the server from disconnecting us.
         void KeepAlive();
 
+        //! Queue depth, batches and latency of the async operations since the pool was opened.
+        DatabaseWorkerStats GetStats() const;
+
     private:
         uint32 OpenConnections(InternalIndex type, uint8 numConnections);
 
@@ -271,18 +271,10 @@ void Field::SetByteValue(void* newValue, DatabaseFieldTypes newType, uint32 leng
 
 void Field::SetStructuredValue(char* newValue, DatabaseFieldTypes newType, uint32 length)
 {
-    if (data.value)
-        CleanUp();
-
     // This value stores somewhat structured data that needs function style casting
-    if (newValue)
-    {
-        data.value = new char[length + 1];
-        memcpy(data.value, newValue, length);
-        *(reinterpret_cast<char*>(data.value) + length) = '\0';
-        data.length = length;
-    }
-
+    // MySQL null terminates every value of a fetched row and keeps the row until the result is freed
+    data.value = newValue;
+    data.length = newValue ? length : 0;
     data.type = newType;
     data.raw = false;
 }
@@ -114,7 +114,7 @@ class TC_DATABASE_API Field
         struct
         {
             uint32 length;            // Length (prepared strings only)
-            void* value;              // Actual data in memory
+            void* value;              // Actual data in memory, owned by the result set
             DatabaseFieldTypes type;  // Field type
             bool raw;                 // Raw bytes? (Prepared statement or ad hoc)
          } data;
@@ -125,9 +125,7 @@ class TC_DATABASE_API Field
 
         void CleanUp()
         {
-            // Field does not own the data if fetched with prepared statement
-            if (!data.raw)
-                delete[] ((char*)data.value);
+            // Field does not own the data, it lives in the result set (prepared statement arena or MySQL row)
             data.value = nullptr;
         }
 
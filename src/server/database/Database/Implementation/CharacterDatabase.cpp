@@ -18,6 +18,15 @@
 #include "CharacterDatabase.h"
 #include "MySQLPreparedStatement.h"
 
+// Login query selecting the rows of LOGIN_QUERY_BATCH_SIZE characters: single character query with the guid added after its columns
+static std::string MakeLoginBatchQuery(std::string const& columns, std::string const& from, std::string const& guidColumn, std::string const& suffix = "")
+{
+    std::string sql = "SELECT " + columns + ", " + guidColumn + " FROM " + from + " WHERE " + guidColumn + " IN (?";
+    for (uint32 i = 1; i < LOGIN_QUERY_BATCH_SIZE; ++i)
+        sql += ", ?";
+    return sql + ")" + suffix;
+}
+
 void CharacterDatabaseConnection::DoPrepareStatements()
 {
     if (!m_reconnecting)
@@ -94,7 +103,8 @@ void CharacterDatabaseConnection::DoPrepareStatements()
     PrepareStatement(CHAR_SEL_CHARACTER_EQUIPMENTSETS, "SELECT setguid, setindex, name, iconname, ignore_mask, item0, item1, item2, item3, item4, item5, item6, item7, item8, "
                      "item9, item10, item11, item12, item13, item14, item15, item16, item17, item18 FROM character_equipmentsets WHERE guid = ? ORDER BY setindex", CONNECTION_ASYNC);
                      */
-    PrepareStatement(CHAR_SEL_CHARACTER, "SELECT characters.guid, account, name, race, class, gender, level, xp, money, playerBytes, playerBytes2, playerFlags, position_x, position_y, position_z, map, instance_id, orientation, taximask, online, cinematic, totaltime, leveltime, logout_time, is_logout_resting, rest_bonus, resettalents_cost, resettalents_time, trans_x, trans_y, trans_z, trans_o, transguid, extra_flags, stable_slots, at_login, zone, death_expire_time, taxi_path, dungeon_difficulty, arena_pending_points, arenapoints, totalHonorPoints, todayHonorPoints, yesterdayHonorPoints, totalKills, todayKills, yesterdayKills, chosenTitle, watchedFaction, drunk, health, power1, power2, power3, power4, power5, exploredZones, equipmentCache, ammoId, knownTitles, actionBars, xp_blocked, IFNULL(custom_xp, 0.0) FROM characters LEFT OUTER JOIN character_custom_xp on characters.guid = character_custom_xp.guid WHERE characters.guid = ?", CONNECTION_ASYNC);
+    std::string characterColumns = "characters.guid, account, name, race, class, gender, level, xp, money, playerBytes, playerBytes2, playerFlags, position_x, position_y, position_z, map, instance_id, orientation, taximask, online, cinematic, totaltime, leveltime, logout_time, is_logout_resting, rest_bonus, resettalents_cost, resettalents_time, trans_x, trans_y, trans_z, trans_o, transguid, extra_flags, stable_slots, at_login, zone, death_expire_time, taxi_path, dungeon_difficulty, arena_pending_points, arenapoints, totalHonorPoints, todayHonorPoints, yesterdayHonorPoints, totalKills, todayKills, yesterdayKills, chosenTitle, watchedFaction, drunk, health, power1, power2, power3, power4, power5, exploredZones, equipmentCache, ammoId, knownTitles, actionBars, xp_blocked, IFNULL(custom_xp, 0.0)";
+    PrepareStatement(CHAR_SEL_CHARACTER, "SELECT " + characterColumns + " FROM characters LEFT OUTER JOIN character_custom_xp on characters.guid = character_custom_xp.guid WHERE characters.guid = ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_SEL_GROUP_MEMBER, "SELECT guid FROM group_member WHERE memberGuid = ?", CONNECTION_BOTH);
     PrepareStatement(CHAR_SEL_CHARACTER_INSTANCE, "SELECT id, permanent, map, difficulty, resettime FROM character_instance LEFT JOIN instance ON instance = id WHERE guid = ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_SEL_CHARACTER_AURAS, "SELECT casterGuid, itemGuid, spell, effectMask, recalculateMask, stackCount, amount0, amount1, amount2, "
@@ -161,6 +171,28 @@ void CharacterDatabaseConnection::DoPrepareStatements()
     PrepareStatement(CHAR_SEL_ITEM_INSTANCE, "SELECT " + itemCommonPart + " FROM item_instance WHERE guid = ?", CONNECTION_SYNCH);
     PrepareStatement(CHAR_SEL_AUCTION_ITEMS, "SELECT " + itemCommonPart + ", itemguid, itemEntry FROM auctionhouse ah JOIN item_instance ii ON ah.itemguid = ii.guid", CONNECTION_SYNCH);
     PrepareStatement(CHAR_SEL_GUILDBANK_ITEMS, "SELECT " + itemCommonPart + ", TabId, SlotId, item_guid, itemEntry FROM guild_bank_item gbi INNER JOIN item_instance ii ON gbi.item_guid = ii.guid where guildid = ?", CONNECTION_ASYNC);
+
+    // Batched login queries, same columns as the single character ones above
+    PrepareStatement(CHAR_SEL_CHARACTER_BATCH, MakeLoginBatchQuery(characterColumns, "characters LEFT OUTER JOIN character_custom_xp on characters.guid = character_custom_xp.guid", "characters.guid"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_GROUP_MEMBER_BATCH, MakeLoginBatchQuery("guid", "group_member", "memberGuid"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_CHARACTER_INSTANCE_BATCH, MakeLoginBatchQuery("id, permanent, map, difficulty, resettime", "character_instance LEFT JOIN instance ON instance = id", "guid"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_CHARACTER_AURAS_BATCH, MakeLoginBatchQuery("casterGuid, itemGuid, spell, effectMask, recalculateMask, stackCount, amount0, amount1, amount2, "
+        "base_amount0, base_amount1, base_amount2, maxDuration, remainTime, remainCharges, critChance, applyResilience", "character_aura", "guid"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_CHARACTER_SPELL_BATCH, MakeLoginBatchQuery("spell,active,disabled", "character_spell", "guid"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_CHARACTER_QUESTSTATUS_BATCH, MakeLoginBatchQuery("quest,status,explored,timer,mobcount1,mobcount2,mobcount3,mobcount4,itemcount1,itemcount2,itemcount3,itemcount4,playercount", "character_queststatus", "guid"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_CHARACTER_QUESTSTATUS_DAILY_BATCH, MakeLoginBatchQuery("quest,time", "character_queststatus_daily", "guid"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_CHARACTER_QUESTSTATUS_SEASONAL_BATCH, MakeLoginBatchQuery("quest, event", "character_queststatus_seasonal", "guid"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_CHARACTER_REPUTATION_BATCH, MakeLoginBatchQuery("faction, standing, flags", "character_reputation", "guid"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_CHARACTER_INVENTORY_BATCH, MakeLoginBatchQuery(itemCommonPart + ", bag, slot, item, itemEntry", "character_inventory ci JOIN item_instance ii ON ci.item = ii.guid", "ci.guid", " ORDER BY bag, slot"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_CHARACTER_ACTIONS_BATCH, MakeLoginBatchQuery("button,action,type,misc", "character_action", "guid", " ORDER BY button"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_CHARACTER_HOMEBIND_BATCH, MakeLoginBatchQuery("map,zone,position_x,position_y,position_z", "character_homebind", "guid"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_CHARACTER_SPELLCOOLDOWNS_BATCH, MakeLoginBatchQuery("spell, item, time, categoryId, categoryEnd", "character_spell_cooldown", "guid", " AND time > UNIX_TIMESTAMP()"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_GUILD_MEMBER_BATCH, MakeLoginBatchQuery("guildid, `rank`", "guild_member", "guid"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_CHARACTER_ARENAINFO_BATCH, MakeLoginBatchQuery("arenaTeamId, weekGames, seasonGames, seasonWins, personalRating", "arena_team_member", "guid"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_CHARACTER_SKILLS_BATCH, MakeLoginBatchQuery("skill, value, max", "character_skills", "guid"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_CHARACTER_BGDATA_BATCH, MakeLoginBatchQuery("instanceId, team, joinX, joinY, joinZ, joinO, joinMapId, taxiStart, taxiEnd, mountSpell", "character_battleground_data", "guid"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_CORPSE_LOCATION_BATCH, MakeLoginBatchQuery("mapId, posX, posY, posZ, orientation", "corpse", "guid"), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_SEL_CHARACTER_QUESTSTATUSREW_BATCH, MakeLoginBatchQuery("quest", "character_queststatus_rewarded", "guid", " AND active = 1"), CONNECTION_ASYNC);
     //next two (CHAR_REP_ITEM_INSTANCE and CHAR_UPD_ITEM_INSTANCE) must use exactly the same fields
     PrepareStatement(CHAR_REP_ITEM_INSTANCE, "REPLACE INTO item_instance (guid, owner_guid, itemEntry, container_guid, creatorGuid, giftCreatorGuid, count, duration, spell1_charges, spell2_charges, spell3_charges, spell4_charges, spell5_charges, flags, enchant1_id, enchant1_duration, enchant1_charges, enchant2_id, enchant2_duration, enchant2_charges, enchant3_id, enchant3_duration, enchant3_charges, enchant4_id, enchant4_duration, enchant4_charges, enchant5_id, enchant5_duration, enchant5_charges, enchant6_id, enchant6_duration, enchant6_charges, enchant7_id, enchant7_duration, enchant7_charges, enchant8_id, enchant8_duration, enchant8_charges, enchant9_id, enchant9_duration, enchant9_charges, enchant10_id, enchant10_duration, enchant10_charges, enchant11_id, enchant11_duration, enchant11_charges, property_seed, random_prop_id, durability, itemTextId) VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?)", CONNECTION_ASYNC);
     PrepareStatement(CHAR_UPD_ITEM_INSTANCE, "UPDATE item_instance SET guid = ? , owner_guid = ? , itemEntry = ? , container_guid = ? , creatorGuid = ? , giftCreatorGuid = ? , count = ? , duration = ? , spell1_charges = ? , spell2_charges = ? , spell3_charges = ? , spell4_charges = ? , spell5_charges = ? , flags = ? , enchant1_id = ? , enchant1_duration = ? , enchant1_charges = ? , enchant2_id = ? , enchant2_duration = ? , enchant2_charges = ? , enchant3_id = ? , enchant3_duration = ? , enchant3_charges = ? , enchant4_id = ? , enchant4_duration = ? , enchant4_charges = ? , enchant5_id = ? , enchant5_duration = ? , enchant5_charges = ? , enchant6_id = ? , enchant6_duration = ? , enchant6_charges = ? , enchant7_id = ? , enchant7_duration = ? , enchant7_charges = ? , enchant8_id = ? , enchant8_duration = ? , enchant8_charges = ? , enchant9_id = ? , enchant9_duration = ? , enchant9_charges = ? , enchant10_id = ? , enchant10_duration = ? , enchant10_charges = ? , enchant11_id = ? , enchant11_duration = ? , enchant11_charges = ? , property_seed = ? , random_prop_id = ? , durability = ?, itemTextId = ? WHERE guid = ?", CONNECTION_ASYNC);
@@ -268,6 +300,9 @@ void CharacterDatabaseConnection::DoPrepareStatements()
     // Auras
     PrepareStatement(CHAR_INS_AURA, "INSERT INTO character_aura (guid, casterGuid, itemGuid, spell, effectMask, recalculateMask, stackCount, amount0, amount1, amount2, base_amount0, base_amount1, base_amount2, maxDuration, remainTime, remainCharges, critChance, applyResilience) "
         "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_REP_AURA, "REPLACE INTO character_aura (guid, casterGuid, itemGuid, spell, effectMask, recalculateMask, stackCount, amount0, amount1, amount2, base_amount0, base_amount1, base_amount2, maxDuration, remainTime, remainCharges, critChance, applyResilience) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_DEL_CHAR_AURA_BY_KEY, "DELETE FROM character_aura WHERE guid = ? AND casterGuid = ? AND spell = ? AND effectMask = ?", CONNECTION_ASYNC);
 
     /*
     #ifdef LICH_KING
@@ -389,12 +424,16 @@ void CharacterDatabaseConnection::DoPrepareStatements()
         "todayKills, yesterdayKills, chosenTitle, watchedFaction, drunk, health, power1, power2, power3, "
         "power4, power5, latency, exploredZones, equipmentCache, ammoId, knownTitles, actionBars, xp_blocked) VALUES "
         "(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?)", CONNECTION_ASYNC);
-    PrepareStatement(CHAR_UPD_CHARACTER, "UPDATE characters SET name=?,race=?,class=?,gender=?,level=?,xp=?,money=?,playerBytes=?,playerBytes2=?,playerFlags=?,"
-        "map=?,instance_id=?,dungeon_difficulty=?,position_x=?,position_y=?,position_z=?,orientation=?,trans_x=?,trans_y=?,trans_z=?,trans_o=?,transguid=?,taximask=?,cinematic=?,totaltime=?,leveltime=?,rest_bonus=?,"
-        "logout_time=?,is_logout_resting=?,resettalents_cost=?,resettalents_time=?,extra_flags=?,stable_slots=?,at_login=?,zone=?,death_expire_time=?,taxi_path=?,"
+    // CHAR_UPD_CHARACTER_STATE columns first, then the columns which rarely change
+    PrepareStatement(CHAR_UPD_CHARACTER, "UPDATE characters SET level=?,xp=?,money=?,playerFlags=?,"
+        "map=?,instance_id=?,dungeon_difficulty=?,position_x=?,position_y=?,position_z=?,orientation=?,trans_x=?,trans_y=?,trans_z=?,trans_o=?,transguid=?,"
+        "totaltime=?,leveltime=?,rest_bonus=?,logout_time=?,is_logout_resting=?,zone=?,health=?,power1=?,power2=?,power3=?,power4=?,power5=?,latency=?,online=?,"
+        "name=?,race=?,class=?,gender=?,playerBytes=?,playerBytes2=?,taximask=?,cinematic=?,resettalents_cost=?,resettalents_time=?,extra_flags=?,stable_slots=?,at_login=?,death_expire_time=?,taxi_path=?,"
         "arenapoints=?,totalHonorPoints=?,todayHonorPoints=?,yesterdayHonorPoints=?,totalKills=?,todayKills=?,yesterdayKills=?,chosenTitle=?,"
-        "watchedFaction=?,drunk=?,health=?,power1=?,power2=?,power3=?,power4=?,power5=?,latency=?,exploredZones=?,"
-        "equipmentCache=?,ammoId=?,knownTitles=?,actionBars=?,xp_blocked=?,online=? WHERE guid=?", CONNECTION_ASYNC);
+        "watchedFaction=?,drunk=?,exploredZones=?,equipmentCache=?,ammoId=?,knownTitles=?,actionBars=?,xp_blocked=? WHERE guid=?", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_UPD_CHARACTER_STATE, "UPDATE characters SET level=?,xp=?,money=?,playerFlags=?,"
+        "map=?,instance_id=?,dungeon_difficulty=?,position_x=?,position_y=?,position_z=?,orientation=?,trans_x=?,trans_y=?,trans_z=?,trans_o=?,transguid=?,"
+        "totaltime=?,leveltime=?,rest_bonus=?,logout_time=?,is_logout_resting=?,zone=?,health=?,power1=?,power2=?,power3=?,power4=?,power5=?,latency=?,online=? WHERE guid=?", CONNECTION_ASYNC);
 
     PrepareStatement(CHAR_UPD_ADD_AT_LOGIN_FLAG, "UPDATE characters SET at_login = at_login | ? WHERE guid = ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_UPD_REM_AT_LOGIN_FLAG, "UPDATE characters set at_login = at_login & ~ ? WHERE guid = ?", CONNECTION_ASYNC);
@@ -117,6 +117,27 @@ enum CharacterDatabaseStatements : uint32
     */
     CHAR_SEL_CHARACTER_QUESTSTATUSREW,
 
+    // Login queries for LOGIN_QUERY_BATCH_SIZE characters, guid in the last column
+    CHAR_SEL_CHARACTER_BATCH,
+    CHAR_SEL_GROUP_MEMBER_BATCH,
+    CHAR_SEL_CHARACTER_INSTANCE_BATCH,
+    CHAR_SEL_CHARACTER_AURAS_BATCH,
+    CHAR_SEL_CHARACTER_SPELL_BATCH,
+    CHAR_SEL_CHARACTER_QUESTSTATUS_BATCH,
+    CHAR_SEL_CHARACTER_QUESTSTATUS_DAILY_BATCH,
+    CHAR_SEL_CHARACTER_QUESTSTATUS_SEASONAL_BATCH,
+    CHAR_SEL_CHARACTER_REPUTATION_BATCH,
+    CHAR_SEL_CHARACTER_INVENTORY_BATCH,
+    CHAR_SEL_CHARACTER_ACTIONS_BATCH,
+    CHAR_SEL_CHARACTER_HOMEBIND_BATCH,
+    CHAR_SEL_CHARACTER_SPELLCOOLDOWNS_BATCH,
+    CHAR_SEL_GUILD_MEMBER_BATCH,
+    CHAR_SEL_CHARACTER_ARENAINFO_BATCH,
+    CHAR_SEL_CHARACTER_SKILLS_BATCH,
+    CHAR_SEL_CHARACTER_BGDATA_BATCH,
+    CHAR_SEL_CORPSE_LOCATION_BATCH,
+    CHAR_SEL_CHARACTER_QUESTSTATUSREW_BATCH,
+
     CHAR_SEL_MAILITEMS,
     CHAR_SEL_AUCTION_ITEMS,
     CHAR_SEL_GUILDBANK_ITEMS,
@@ -223,6 +244,8 @@ enum CharacterDatabaseStatements : uint32
     CHAR_DEL_EQUIP_SET,
     */
     CHAR_INS_AURA,
+    CHAR_REP_AURA,
+    CHAR_DEL_CHAR_AURA_BY_KEY,
     /*
     CHAR_SEL_ACCOUNT_DATA,
     CHAR_REP_ACCOUNT_DATA,
@@ -313,6 +336,7 @@ enum CharacterDatabaseStatements : uint32
     */
     CHAR_INS_CHARACTER,
     CHAR_UPD_CHARACTER,
+    CHAR_UPD_CHARACTER_STATE,
 
     CHAR_UPD_ADD_AT_LOGIN_FLAG,
     CHAR_UPD_REM_AT_LOGIN_FLAG,
@@ -598,6 +622,9 @@ enum CharacterDatabaseStatements : uint32
 //number of fields in variable itemCommonPart. Some queries are combined with it
 #define CHAR_SEL_ITEM_INSTANCE_FIELDS_COUNT 47
 
+//number of guids given to the login queries of a batch (CHAR_SEL_*_BATCH). Unused ones are set to 0
+#define LOGIN_QUERY_BATCH_SIZE 50
+
 class TC_DATABASE_API CharacterDatabaseConnection : public MySQLConnection
 {
 public:
@@ -49,6 +49,8 @@ MySQLConnectionInfo::MySQLConnectionInfo(std::string const& infoString)
 MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_reconnects(0),
+m_retryOnReconnect(true),
 m_queue(nullptr),
 m_Mysql(nullptr),
 m_connectionInfo(connInfo),
@@ -57,6 +59,8 @@ m_connectionFlags(CONNECTION_SYNCH) { }
 MySQLConnection::MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_reconnects(0),
+m_retryOnReconnect(true),
 m_queue(queue),
 m_Mysql(nullptr),
 m_connectionInfo(connInfo),
@@ -182,7 +186,7 @@ bool MySQLConnection::Execute(char const* sql)
             TC_LOG_ERROR("sql.sql", "[%u] %s", lErrno, mysql_error(m_Mysql));
 
             if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
-                return Execute(sql);       // Try again
+                return m_retryOnReconnect && Execute(sql);       // Try again, unless the caller replays it
 
             return false;
         }
@@ -217,7 +221,7 @@ bool MySQLConnection::Execute(PreparedStatement* stmt)
         TC_LOG_ERROR("sql.sql", "SQL(p): %s\n [ERROR]: [%u] %s", m_mStmt->getQueryString().c_str(), lErrno, mysql_stmt_error(msql_STMT));
 
         if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
-            return Execute(stmt);       // Try again
+            return m_retryOnReconnect && Execute(stmt);       // Try again, unless the caller replays it
 
         m_mStmt->ClearParameters();
         return false;
@@ -229,7 +233,7 @@ bool MySQLConnection::Execute(PreparedStatement* stmt)
         TC_LOG_ERROR("sql.sql", "SQL(p): %s\n [ERROR]: [%u] %s", m_mStmt->getQueryString().c_str(), lErrno, mysql_stmt_error(msql_STMT));
 
         if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
-            return Execute(stmt);       // Try again
+            return m_retryOnReconnect && Execute(stmt);       // Try again, unless the caller replays it
 
         m_mStmt->ClearParameters();
         return false;
@@ -352,9 +356,9 @@ bool MySQLConnection::_Query(const char* sql, MySQLResult** pResult, MySQLField*
     return true;
 }
 
-void MySQLConnection::BeginTransaction()
+bool MySQLConnection::BeginTransaction()
 {
-    Execute("START TRANSACTION");
+    return Execute("START TRANSACTION");
 }
 
 void MySQLConnection::RollbackTransaction()
@@ -362,9 +366,9 @@ void MySQLConnection::RollbackTransaction()
     Execute("ROLLBACK");
 }
 
-void MySQLConnection::CommitTransaction()
+bool MySQLConnection::CommitTransaction()
 {
-    Execute("COMMIT");
+    return Execute("COMMIT");
 }
 
 int MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
@@ -547,6 +551,7 @@ bool MySQLConnection::_HandleMySQLErrno(uint32 errNo, uint8 attempts /*= 5*/)
                         (m_connectionFlags & CONNECTION_ASYNC) ? "asynchronous" : "synchronous");
 
                 m_reconnecting = false;
+                ++m_reconnects;
                 return true;
             }
 
@@ -49,6 +49,11 @@ struct TC_DATABASE_API MySQLConnectionInfo
     std::string database;
     std::string host;
     std::string port_or_socket;
+
+    // Async workers execute up to batchMaxSize adjacent one-way statements in one transaction,
+    // waiting at most batchMaxDelay ms for the queue to fill the batch
+    uint32 batchMaxSize = 1;
+    uint32 batchMaxDelay = 0;
 };
 
 class TC_DATABASE_API MySQLConnection
@@ -73,15 +78,22 @@ class TC_DATABASE_API MySQLConnection
         bool _Query(char const* sql, MySQLResult** pResult, MySQLField** pFields, uint64* pRowCount, uint32* pFieldCount);
         bool _Query(PreparedStatement* stmt, MySQLResult** pResult, uint64* pRowCount, uint32* pFieldCount);
 
-        void BeginTransaction();
+        bool BeginTransaction();
         void RollbackTransaction();
-        void CommitTransaction();
+        bool CommitTransaction();
         int ExecuteTransaction(SQLTransaction& transaction);
         size_t EscapeString(char* to, const char* from, size_t length);
         void Ping();
 
         uint32 GetLastError();
 
+        MySQLConnectionInfo const& GetConnectionInfo() const { return m_connectionInfo; }
+
+        /// Successful reconnections so far, each one loses the open transaction
+        uint32 GetReconnectCount() const { return m_reconnects; }
+        /// Whether Execute runs a statement again on the new connection after reconnecting, else it fails and the caller replays it
+        void SetRetryOnReconnect(bool retry) { m_retryOnReconnect = retry; }
+
     protected:
         /// Tries to acquire lock. If lock is acquired by another thread
         /// the calling parent will just try another connection
@@ -101,6 +113,8 @@ class TC_DATABASE_API MySQLConnection
         PreparedStatementContainer           m_stmts;         //! PreparedStatements storage
         bool                                 m_reconnecting;  //! Are we reconnecting?
         bool                                 m_prepareError;  //! Was there any error while preparing statements?
+        uint32                               m_reconnects;    //! Successful reconnections
+        bool                                 m_retryOnReconnect; //! Does Execute retry a statement after reconnecting?
 
     private:
         bool _HandleMySQLErrno(uint32 errNo, uint8 attempts = 5);
@@ -19,6 +19,7 @@
 #include "Errors.h"
 #include "MySQLConnection.h"
 #include "MySQLPreparedStatement.h"
+#include "QueryCompletion.h"
 #include "QueryResult.h"
 #include "Log.h"
 #include "MySQLWorkaround.h"
@@ -212,9 +213,13 @@ bool PreparedStatementTask::Execute()
         {
             delete result;
             m_result->set_value(PreparedQueryResult(nullptr));
+            if (m_completion)
+                m_completion->Complete();
             return false;
         }
         m_result->set_value(PreparedQueryResult(result));
+        if (m_completion)
+            m_completion->Complete();
         return true;
     }
 
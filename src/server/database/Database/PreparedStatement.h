@@ -21,6 +21,7 @@
 #include "Define.h"
 #include "SQLOperation.h"
 #include <future>
+#include <memory>
 #include <vector>
 
 #ifdef __APPLE__
@@ -71,6 +72,7 @@ struct PreparedStatementData
 
 //- Forward declare
 class MySQLPreparedStatement;
+class QueryCompletion;
 
 //- Upper-level class that is used in code
 class TC_DATABASE_API PreparedStatement
@@ -123,10 +125,15 @@ class TC_DATABASE_API PreparedStatementTask : public SQLOperation
 
         bool Execute() override;
         PreparedQueryResultFuture GetFuture() { return m_result->get_future(); }
+        void SetCompletion(std::shared_ptr<QueryCompletion> completion) { m_completion = std::move(completion); }
+
+        bool IsBatchable() const override { return !m_has_result; }
+        uint32 GetStatementIndex() const override { return m_stmt->GetIndex(); }
 
     protected:
         PreparedStatement* m_stmt;
         bool m_has_result;
         PreparedQueryResultPromise* m_result;
+        std::shared_ptr<QueryCompletion> m_completion;  //- Completed once the result is set, may be null
 };
 #endif
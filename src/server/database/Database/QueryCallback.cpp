@@ -17,6 +17,7 @@
 
 #include "QueryCallback.h"
 #include "Errors.h"
+#include "QueryCompletion.h"
 
 template<typename T, typename... Args>
 inline void Construct(T& t, Args&&... args)
@@ -105,16 +106,18 @@ private:
 };
 
 // Not using initialization lists to work around segmentation faults when compiling with clang without precompiled headers
-QueryCallback::QueryCallback(std::future<QueryResult>&& result)
+QueryCallback::QueryCallback(std::future<QueryResult>&& result, std::shared_ptr<QueryCompletion> completion)
 {
     _isPrepared = false;
     Construct(_string, std::move(result));
+    _completion = std::move(completion);
 }
 
-QueryCallback::QueryCallback(std::future<PreparedQueryResult>&& result)
+QueryCallback::QueryCallback(std::future<PreparedQueryResult>&& result, std::shared_ptr<QueryCompletion> completion)
 {
     _isPrepared = true;
     Construct(_prepared, std::move(result));
+    _completion = std::move(completion);
 }
 
 QueryCallback::QueryCallback(QueryCallback&& right)
@@ -122,6 +125,7 @@ QueryCallback::QueryCallback(QueryCallback&& right)
     _isPrepared = right._isPrepared;
     ConstructActiveMember(this);
     MoveFrom(this, std::move(right));
+    _completion = std::move(right._completion);
     _callbacks = std::move(right._callbacks);
 }
 
@@ -136,6 +140,7 @@ QueryCallback& QueryCallback::operator=(QueryCallback&& right)
             ConstructActiveMember(this);
         }
         MoveFrom(this, std::move(right));
+        _completion = std::move(right._completion);
         _callbacks = std::move(right._callbacks);
     }
     return *this;
@@ -173,6 +178,7 @@ QueryCallback&& QueryCallback::WithChainingPreparedCallback(std::function<void(Q
 void QueryCallback::SetNextQuery(QueryCallback&& next)
 {
     MoveFrom(this, std::move(next));
+    _completion = std::move(next._completion);
 }
 
 QueryCallback::Status QueryCallback::InvokeIfReady()
@@ -23,14 +23,18 @@
 #include <functional>
 #include <future>
 #include <list>
+#include <memory>
 #include <queue>
 #include <utility>
 
+class QueryCompletion;
+
 class TC_DATABASE_API QueryCallback
 {
 public:
-    explicit QueryCallback(QueryResultFuture&& result);
-    explicit QueryCallback(PreparedQueryResultFuture&& result);
+    // Without completion, the processor polls the future
+    explicit QueryCallback(QueryResultFuture&& result, std::shared_ptr<QueryCompletion> completion = nullptr);
+    explicit QueryCallback(PreparedQueryResultFuture&& result, std::shared_ptr<QueryCompletion> completion = nullptr);
     QueryCallback(QueryCallback&& right);
     QueryCallback& operator=(QueryCallback&& right);
     ~QueryCallback();
@@ -41,9 +45,12 @@ public:
     QueryCallback&& WithChainingCallback(std::function<void(QueryCallback&, QueryResult)>&& callback);
     QueryCallback&& WithChainingPreparedCallback(std::function<void(QueryCallback&, PreparedQueryResult)>&& callback);
 
-    // Moves std::future from next to this object
+    // Moves std::future (and its completion) from next to this object
     void SetNextQuery(QueryCallback&& next);
 
+    // Completion of the current query, may be null
+    std::shared_ptr<QueryCompletion> const& GetCompletion() const { return _completion; }
+
     enum Status
     {
         NotReady,
@@ -67,6 +74,7 @@ private:
         PreparedQueryResultFuture _prepared;
     };
     bool _isPrepared;
+    std::shared_ptr<QueryCompletion> _completion;
 
     struct QueryCallbackData;
     std::queue<QueryCallbackData, std::list<QueryCallbackData>> _callbacks;
@@ -16,10 +16,37 @@
  */
 
 #include "QueryCallbackProcessor.h"
-#include "QueryCallback.h"
+#include "QueryCompletion.h"
 #include <algorithm>
+#include <mutex>
 
-QueryCallbackProcessor::QueryCallbackProcessor()
+static std::mutex latencyStatsLock;
+static QueryLatencyStatsMap latencyStats;
+
+void QueryLatencyStats::Add(uint64 latency, uint64 readyWait)
+{
+    ++count;
+    latencySum += latency;
+    latencyMax = std::max(latencyMax, latency);
+    readyWaitSum += readyWait;
+
+    uint32 bucket = 0;
+    for (uint64 ms = latency / 1000; ms && bucket < BUCKETS - 1; ms >>= 1)
+        ++bucket;
+    ++buckets[bucket];
+}
+
+void QueryLatencyStats::Add(QueryLatencyStats const& other)
+{
+    count += other.count;
+    latencySum += other.latencySum;
+    latencyMax = std::max(latencyMax, other.latencyMax);
+    readyWaitSum += other.readyWaitSum;
+    for (uint32 i = 0; i < BUCKETS; ++i)
+        buckets[i] += other.buckets[i];
+}
+
+QueryCallbackProcessor::QueryCallbackProcessor() : _completions(std::make_shared<QueryCompletionQueue>()), _nextTicket(0)
 {
 }
 
@@ -29,20 +56,102 @@ QueryCallbackProcessor::~QueryCallbackProcessor()
 
 void QueryCallbackProcessor::AddQuery(QueryCallback&& query)
 {
-    _callbacks.emplace_back(std::move(query));
+    if (query.GetCompletion())
+        Watch(std::move(query));
+    else
+        _polledCallbacks.emplace_back(std::move(query));
+}
+
+void QueryCallbackProcessor::Watch(QueryCallback&& query)
+{
+    uint32 const ticket = ++_nextTicket;
+    std::shared_ptr<QueryCompletion> completion = query.GetCompletion();
+    _callbacks.emplace(ticket, std::move(query));
+    completion->Watch(_completions, ticket);
 }
 
 void QueryCallbackProcessor::ProcessReadyQueries()
 {
+    if (!_polledCallbacks.empty())
+        ProcessPolledQueries();
+
     if (_callbacks.empty())
         return;
 
-    std::vector<QueryCallback> updateCallbacks{ std::move(_callbacks) };
+    _completions->Drain(_ready);
+    for (uint32 ticket : _ready)
+    {
+        auto itr = _callbacks.find(ticket);
+        if (itr == _callbacks.end())
+            continue;
+
+        // callbacks may add queries to this processor
+        QueryCallback callback(std::move(itr->second));
+        _callbacks.erase(itr);
 
-    updateCallbacks.erase(std::remove_if(updateCallbacks.begin(), updateCallbacks.end(), [](QueryCallback& callback)
+        std::shared_ptr<QueryCompletion> completion = callback.GetCompletion();
+        QueryCompletion::Clock::time_point const now = QueryCompletion::Clock::now();
+        QueryCallback::Status status = callback.InvokeIfReady();
+        if (status == QueryCallback::NotReady)
+        {
+            // the result is set before completing, should not happen
+            Watch(std::move(callback));
+            continue;
+        }
+
+        LatencySample sample;
+        sample.database = completion->GetDatabase();
+        sample.statement = completion->GetStatement();
+        sample.latency = std::chrono::duration_cast<std::chrono::microseconds>(now - completion->GetEnqueueTime()).count();
+        sample.readyWait = std::chrono::duration_cast<std::chrono::microseconds>(now - completion->GetCompleteTime()).count();
+        _latencySamples.push_back(sample);
+
+        if (status == QueryCallback::NextStep)
+            AddQuery(std::move(callback));
+    }
+
+    if (!_latencySamples.empty())
+        FlushLatencySamples();
+}
+
+void QueryCallbackProcessor::ProcessPolledQueries()
+{
+    std::vector<QueryCallback> updateCallbacks{ std::move(_polledCallbacks) };
+
+    updateCallbacks.erase(std::remove_if(updateCallbacks.begin(), updateCallbacks.end(), [this](QueryCallback& callback)
     {
-        return callback.InvokeIfReady() == QueryCallback::Completed;
+        switch (callback.InvokeIfReady())
+        {
+            case QueryCallback::Completed:
+                return true;
+            case QueryCallback::NextStep:
+                // chained to a query which signals its completion
+                if (callback.GetCompletion())
+                {
+                    Watch(std::move(callback));
+                    return true;
+                }
+                return false;
+            default:
+                return false;
+        }
     }), updateCallbacks.end());
 
-    _callbacks.insert(_callbacks.end(), std::make_move_iterator(updateCallbacks.begin()), std::make_move_iterator(updateCallbacks.end()));
+    _polledCallbacks.insert(_polledCallbacks.end(), std::make_move_iterator(updateCallbacks.begin()), std::make_move_iterator(updateCallbacks.end()));
+}
+
+void QueryCallbackProcessor::FlushLatencySamples()
+{
+    {
+        std::lock_guard<std::mutex> lock(latencyStatsLock);
+        for (LatencySample const& sample : _latencySamples)
+            latencyStats[std::make_pair(std::string(sample.database), sample.statement)].Add(sample.latency, sample.readyWait);
+    }
+    _latencySamples.clear();
+}
+
+QueryLatencyStatsMap QueryCallbackProcessor::GetLatencyStats()
+{
+    std::lock_guard<std::mutex> lock(latencyStatsLock);
+    return latencyStats;
 }
@@ -19,10 +19,36 @@
 #define QueryCallbackProcessor_h__
 
 #include "Define.h"
+#include "QueryCallback.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
-class QueryCallback;
+class QueryCompletionQueue;
 
+// Time async queries waited before their callback was invoked, in microseconds
+struct QueryLatencyStats
+{
+    static uint32 const BUCKETS = 12;       // by latency, under 1 ms, 2 ms, 4 ms ... 1 s, the last one for 1 s and more
+
+    uint64 count = 0;
+    uint64 latencySum = 0;                  // from the query enqueued to its callback invoked
+    uint64 latencyMax = 0;
+    uint64 readyWaitSum = 0;                // from the query completed to its callback invoked
+    uint64 buckets[BUCKETS] = { };
+
+    void Add(uint64 latency, uint64 readyWait);
+    void Add(QueryLatencyStats const& other);
+};
+
+// by database name and prepared statement index (QueryCompletion::ADHOC_QUERY for raw queries)
+typedef std::map<std::pair<std::string, uint32>, QueryLatencyStats> QueryLatencyStatsMap;
+
+/* Callbacks of queries made with AsyncQuery are only looked at once the database worker signaled their
+   completion: each processor owns a completion queue, drained by ProcessReadyQueries, instead of polling
+   every pending future. Callbacks built from other futures are still polled. */
 class TC_DATABASE_API QueryCallbackProcessor
 {
 public:
@@ -32,11 +58,32 @@ public:
     void AddQuery(QueryCallback&& query);
     void ProcessReadyQueries();
 
+    static QueryLatencyStatsMap GetLatencyStats();
+
 private:
     QueryCallbackProcessor(QueryCallbackProcessor const&) = delete;
     QueryCallbackProcessor& operator=(QueryCallbackProcessor const&) = delete;
 
-    std::vector<QueryCallback> _callbacks;
+    struct LatencySample
+    {
+        char const* database;
+        uint32 statement;
+        uint64 latency;
+        uint64 readyWait;
+    };
+
+    void Watch(QueryCallback&& query);
+    void ProcessPolledQueries();
+    void FlushLatencySamples();
+
+    std::shared_ptr<QueryCompletionQueue> _completions;
+    std::unordered_map<uint32, QueryCallback> _callbacks;   // by ticket, waiting for their completion
+    std::vector<QueryCallback> _polledCallbacks;
+    uint32 _nextTicket;
+
+    // reused between updates
+    std::vector<uint32> _ready;
+    std::vector<LatencySample> _latencySamples;
 };
 
 #endif // QueryCallbackProcessor_h__
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2008-2019 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "QueryCompletion.h"
+
+void QueryCompletionQueue::Push(uint32 ticket)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _tickets.push_back(ticket);
+}
+
+void QueryCompletionQueue::Drain(std::vector<uint32>& tickets)
+{
+    tickets.clear();
+    std::lock_guard<std::mutex> lock(_lock);
+    tickets.swap(_tickets);
+}
+
+QueryCompletion::QueryCompletion(char const* database, uint32 statement) : _database(database), _statement(statement),
+    _enqueueTime(Clock::now()), _completed(false), _ticket(0)
+{
+}
+
+void QueryCompletion::Complete()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _completeTime = Clock::now();
+    _completed = true;
+    if (_queue)
+        _queue->Push(_ticket);
+}
+
+void QueryCompletion::Watch(std::shared_ptr<QueryCompletionQueue> queue, uint32 ticket)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _queue = std::move(queue);
+    _ticket = ticket;
+    if (_completed)
+        _queue->Push(_ticket);
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2008-2019 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QueryCompletion_h__
+#define QueryCompletion_h__
+
+#include "Define.h"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Tickets of the callbacks whose query completed, filled by the database workers and drained by the
+// thread owning the QueryCallbackProcessor
+class TC_DATABASE_API QueryCompletionQueue
+{
+public:
+    void Push(uint32 ticket);
+    // Moves the pushed tickets to tickets (cleared first)
+    void Drain(std::vector<uint32>& tickets);
+
+private:
+    std::mutex _lock;
+    std::vector<uint32> _tickets;
+};
+
+/* Shared by an async query task and its QueryCallback. The database worker completes it once the result
+   is set and pushes the ticket of the callback to the queue of the processor watching it, if any yet.
+   Also keeps the timings of the query for the latency stats. */
+class TC_DATABASE_API QueryCompletion
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static uint32 const ADHOC_QUERY = 0xFFFFFFFF;
+
+    // statement is the prepared statement index, or ADHOC_QUERY
+    QueryCompletion(char const* database, uint32 statement);
+
+    // Called by the database worker after setting the result
+    void Complete();
+    // Called by the processor owning the callback, the ticket is pushed at once if the query already completed
+    void Watch(std::shared_ptr<QueryCompletionQueue> queue, uint32 ticket);
+
+    char const* GetDatabase() const { return _database; }
+    uint32 GetStatement() const { return _statement; }
+    Clock::time_point GetEnqueueTime() const { return _enqueueTime; }
+    // Only valid once completed
+    Clock::time_point GetCompleteTime() const { return _completeTime; }
+
+private:
+    char const* _database;
+    uint32 _statement;
+    Clock::time_point _enqueueTime;
+    Clock::time_point _completeTime;
+
+    std::mutex _lock;
+    bool _completed;
+    std::shared_ptr<QueryCompletionQueue> _queue;
+    uint32 _ticket;
+};
+
+#endif // QueryCompletion_h__
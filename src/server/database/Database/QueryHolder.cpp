@@ -20,6 +20,7 @@
 #include "PreparedStatement.h"
 #include "Log.h"
 #include "QueryResult.h"
+#include <unordered_map>
 
 bool SQLQueryHolder::SetPreparedQuery(size_t index, PreparedStatement* stmt)
 {
@@ -92,3 +93,79 @@ bool SQLQueryHolderTask::Execute()
     m_result.set_value(m_holder);
     return true;
 }
+
+SQLQueryHolderBatch::~SQLQueryHolderBatch()
+{
+    for (auto const& batchedQuery : m_batchedQueries)
+        delete batchedQuery.second;
+}
+
+QueryResultHolderFuture SQLQueryHolderBatch::AddHolder(SQLQueryHolder* holder, uint32 key)
+{
+    m_holders.push_back({ holder, key, QueryResultHolderPromise() });
+    return m_holders.back().promise.get_future();
+}
+
+void SQLQueryHolderBatch::AddBatchedQuery(size_t index, PreparedStatement* stmt)
+{
+    m_batchedQueries.emplace_back(index, stmt);
+}
+
+SQLQueryHolderBatchTask::~SQLQueryHolderBatchTask()
+{
+    if (!m_executed)
+        for (auto const& entry : m_batch->m_holders)
+            delete entry.holder;
+
+    delete m_batch;
+}
+
+bool SQLQueryHolderBatchTask::Execute()
+{
+    m_executed = true;
+
+    /// execute the batched queries once and give each holder the rows with its key
+    std::vector<bool> batched;
+    std::unordered_map<uint32, std::vector<uint64>> rowsByKey;
+    for (auto const& batchedQuery : m_batch->m_batchedQueries)
+    {
+        size_t const index = batchedQuery.first;
+        if (batched.size() <= index)
+            batched.resize(index + 1, false);
+        batched[index] = true;
+
+        rowsByKey.clear();
+        std::shared_ptr<PreparedResultSet> result(m_conn->Query(batchedQuery.second));
+        uint32 const keyColumn = result ? result->GetFieldCount() - 1 : 0;
+        if (result && result->GetRowCount())
+        {
+            uint64 row = 0;
+            do
+                rowsByKey[(*result)[keyColumn].GetUInt32()].push_back(row++);
+            while (result->NextRow());
+        }
+
+        for (auto const& entry : m_batch->m_holders)
+        {
+            // holder doesn't use this query
+            if (index >= entry.holder->m_queries.size() || !entry.holder->m_queries[index].first)
+                continue;
+
+            auto itr = rowsByKey.find(entry.key);
+            entry.holder->SetPreparedResult(index, itr != rowsByKey.end() ? new PreparedResultSet(result, itr->second, keyColumn) : nullptr);
+        }
+    }
+
+    /// execute the other queries of each holder and pass the results
+    for (auto& entry : m_batch->m_holders)
+    {
+        for (size_t i = 0; i < entry.holder->m_queries.size(); ++i)
+            if (PreparedStatement* stmt = entry.holder->m_queries[i].first)
+                if (i >= batched.size() || !batched[i])
+                    entry.holder->SetPreparedResult(i, m_conn->Query(stmt));
+
+        entry.promise.set_value(entry.holder);
+    }
+
+    return true;
+}
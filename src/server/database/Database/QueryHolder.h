@@ -23,6 +23,7 @@
 class TC_DATABASE_API SQLQueryHolder
 {
     friend class SQLQueryHolderTask;
+    friend class SQLQueryHolderBatchTask;
     private:
         std::vector<std::pair<PreparedStatement*, PreparedQueryResult>> m_queries;
     public:
@@ -51,4 +52,45 @@ class TC_DATABASE_API SQLQueryHolderTask : public SQLOperation
         QueryResultHolderFuture GetFuture() { return m_result.get_future(); }
 };
 
+//- Holders executed together: some of their queries are replaced by a single query for the whole batch,
+//- whose rows are dispatched to the holders by the key selected in their last column
+class TC_DATABASE_API SQLQueryHolderBatch
+{
+    friend class SQLQueryHolderBatchTask;
+    private:
+        struct Entry
+        {
+            SQLQueryHolder* holder;
+            uint32 key;
+            QueryResultHolderPromise promise;
+        };
+
+        std::vector<Entry> m_holders;
+        std::vector<std::pair<size_t, PreparedStatement*>> m_batchedQueries;
+    public:
+        SQLQueryHolderBatch() { }
+        ~SQLQueryHolderBatch();
+        //! The future is set once the whole batch is executed
+        QueryResultHolderFuture AddHolder(SQLQueryHolder* holder, uint32 key);
+        //! Execute stmt instead of the query at index of every holder
+        void AddBatchedQuery(size_t index, PreparedStatement* stmt);
+        size_t GetSize() const { return m_holders.size(); }
+        uint32 GetKey(size_t holderIndex) const { return m_holders[holderIndex].key; }
+};
+
+class TC_DATABASE_API SQLQueryHolderBatchTask : public SQLOperation
+{
+    private:
+        SQLQueryHolderBatch* m_batch;
+        bool m_executed;
+
+    public:
+        SQLQueryHolderBatchTask(SQLQueryHolderBatch* batch)
+            : m_batch(batch), m_executed(false) { }
+
+        ~SQLQueryHolderBatchTask();
+
+        bool Execute() override;
+};
+
 #endif
@@ -73,6 +73,31 @@ static uint32 SizeForType(MYSQL_FIELD* field)
     }
 }
 
+// Alignment of the arena columns, enough for any native value (uint64, double, MYSQL_TIME)
+static std::size_t const ARENA_ALIGNMENT = 8;
+
+// Columns stored with their native size in the arena, the others are variable length text or bytes
+static bool IsFixedWidth(enum_field_types type)
+{
+    switch (type)
+    {
+        case MYSQL_TYPE_TINY_BLOB:
+        case MYSQL_TYPE_MEDIUM_BLOB:
+        case MYSQL_TYPE_LONG_BLOB:
+        case MYSQL_TYPE_BLOB:
+        case MYSQL_TYPE_STRING:
+        case MYSQL_TYPE_VAR_STRING:
+        case MYSQL_TYPE_DECIMAL:
+        case MYSQL_TYPE_NEWDECIMAL:
+            return false;
+        default:
+            return true;
+    }
+}
+
+std::atomic<bool> ResultSet::_valueCopiesEnabled(false);
+std::atomic<bool> PreparedResultSet::_arenaEnabled(true);
+
 DatabaseFieldTypes MysqlTypeToFieldType(enum_field_types type)
 {
     switch (type)
@@ -124,6 +149,8 @@ _result(result),
 _fields(fields)
 {
     _currentRow = new Field[_fieldCount];
+    if (AreValueCopiesEnabled())
+        _valueCopies.resize(_fieldCount);
 #ifdef TRINITY_STRICT_DATABASE_TYPE_CHECKS
     for (uint32 i = 0; i < _fieldCount; i++)
         _currentRow[i].SetMetadata(&_fields[i], i);
@@ -172,13 +199,27 @@ m_metadataResult(result)
     m_rowCount = mysql_stmt_num_rows(m_stmt);
 
     //- This is where we prepare the buffer based on metadata
+    //- Rows are fetched one at a time in a single row buffer, then moved to the arena:
+    //- fixed width columns are stored column by column with their native size, variable length values are
+    //- appended after them with their fetched length. The first bytes of the arena are never used, so that
+    //- an offset of 0 can stand for a null value until the final pointers are known.
+    //- Without the arena, every row has its own copy of the row buffer and the fields point into it.
+    bool const useArena = IsArenaEnabled();
     MySQLField* field = reinterpret_cast<MySQLField*>(mysql_fetch_fields(m_metadataResult));
     std::size_t rowSize = 0;
+    std::size_t arenaSize = ARENA_ALIGNMENT;
+    std::vector<std::size_t> columnOffsets(m_fieldCount, 0);
     for (uint32 i = 0; i < m_fieldCount; ++i)
     {
         uint32 size = SizeForType(&field[i]);
         rowSize += size;
 
+        if (useArena && IsFixedWidth(field[i].type))
+        {
+            columnOffsets[i] = arenaSize;
+            arenaSize += (std::size_t(size) * m_rowCount + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+        }
+
         m_rBind[i].buffer_type = field[i].type;
         m_rBind[i].buffer_length = size;
         m_rBind[i].length = &m_length[i];
@@ -187,10 +228,10 @@ m_metadataResult(result)
         m_rBind[i].is_unsigned = field[i].flags & UNSIGNED_FLAG;
     }
 
-    char* dataBuffer = new char[rowSize * m_rowCount];
+    char* rowBuffer = new char[useArena ? rowSize : rowSize * m_rowCount];
     for (uint32 i = 0, offset = 0; i < m_fieldCount; ++i)
     {
-        m_rBind[i].buffer = dataBuffer + offset;
+        m_rBind[i].buffer = rowBuffer + offset;
         offset += m_rBind[i].buffer_length;
     }
 
@@ -205,60 +246,71 @@ m_metadataResult(result)
         return;
     }
 
+    if (useArena)
+        m_arena.resize(arenaSize);
     m_rows.resize(uint32(m_rowCount) * m_fieldCount);
     while (_NextRow())
     {
         for (uint32 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
         {
+            Field& value = m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex];
+            DatabaseFieldTypes type = MysqlTypeToFieldType(m_rBind[fIndex].buffer_type);
             unsigned long buffer_length = m_rBind[fIndex].buffer_length;
             unsigned long fetched_length = *m_rBind[fIndex].length;
-            if (!*m_rBind[fIndex].is_null)
+            if (!*m_rBind[fIndex].is_null && !useArena)
             {
-                void* buffer = m_stmt->bind[fIndex].buffer;
-                switch (m_rBind[fIndex].buffer_type)
-                {
-                    case MYSQL_TYPE_TINY_BLOB:
-                    case MYSQL_TYPE_MEDIUM_BLOB:
-                    case MYSQL_TYPE_LONG_BLOB:
-                    case MYSQL_TYPE_BLOB:
-                    case MYSQL_TYPE_STRING:
-                    case MYSQL_TYPE_VAR_STRING:
-                        // warning - the string will not be null-terminated if there is no space for it in the buffer
-                        // when mysql_stmt_fetch returned MYSQL_DATA_TRUNCATED
-                        // we cannot blindly null-terminate the data either as it may be retrieved as binary blob and not specifically a string
-                        // in this case using Field::GetCString will result in garbage
-                        // TODO: remove Field::GetCString and use boost::string_ref (currently proposed for TS as string_view, maybe in C++17)
-                        if (fetched_length < buffer_length)
-                            *((char*)buffer + fetched_length) = '\0';
-                        break;
-                    default:
-                        break;
-                }
+                char* buffer = static_cast<char*>(m_stmt->bind[fIndex].buffer);
+                // the string is not null terminated if there was no space left for it in the buffer (MYSQL_DATA_TRUNCATED)
+                if (!IsFixedWidth(m_rBind[fIndex].buffer_type) && fetched_length < buffer_length)
+                    buffer[fetched_length] = '\0';
 
-                m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex].SetByteValue(
-                    buffer,
-                    MysqlTypeToFieldType(m_rBind[fIndex].buffer_type),
-                    fetched_length);
+                value.SetByteValue(buffer, type, fetched_length);
 
                 // move buffer pointer to next part
-                m_stmt->bind[fIndex].buffer = (char*)buffer + rowSize;
+                m_stmt->bind[fIndex].buffer = buffer + rowSize;
             }
-            else
+            else if (!*m_rBind[fIndex].is_null)
             {
-                m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex].SetByteValue(
-                    nullptr,
-                    MysqlTypeToFieldType(m_rBind[fIndex].buffer_type),
-                    *m_rBind[fIndex].length);
+                char const* buffer = static_cast<char const*>(m_rBind[fIndex].buffer);
+                std::size_t offset;
+                if (IsFixedWidth(m_rBind[fIndex].buffer_type))
+                {
+                    offset = columnOffsets[fIndex] + std::size_t(buffer_length) * m_rowPosition;
+                    memcpy(&m_arena[offset], buffer, buffer_length);
+                }
+                else
+                {
+                    // the value is truncated if it did not fit in the fetch buffer (MYSQL_DATA_TRUNCATED),
+                    // null terminate what we have so that strings can be used with Field::GetCString
+                    if (fetched_length > buffer_length)
+                        fetched_length = buffer_length;
+                    offset = m_arena.size();
+                    m_arena.insert(m_arena.end(), buffer, buffer + fetched_length);
+                    m_arena.push_back('\0');
+                }
+
+                value.SetByteValue(reinterpret_cast<void*>(offset), type, fetched_length);
             }
+            else
+                value.SetByteValue(nullptr, type, fetched_length);
 
 #ifdef TRINITY_STRICT_DATABASE_TYPE_CHECKS
-            m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex].SetMetadata(&field[fIndex], fIndex);
+            value.SetMetadata(&field[fIndex], fIndex);
 #endif
         }
         m_rowPosition++;
     }
     m_rowPosition = 0;
 
+    //- The arena doesn't move anymore, turn offsets into pointers
+    if (useArena)
+    {
+        m_arena.shrink_to_fit();
+        for (Field& value : m_rows)
+            if (value.data.value)
+                value.data.value = &m_arena[reinterpret_cast<std::size_t>(value.data.value)];
+    }
+
     /// All data is buffered, let go of mysql c api structures
     mysql_stmt_free_result(m_stmt);
 }
@@ -268,6 +320,27 @@ ResultSet::~ResultSet()
     CleanUp();
 }
 
+PreparedResultSet::PreparedResultSet(std::shared_ptr<PreparedResultSet> source, std::vector<uint64> const& rows, uint32 fieldCount) :
+m_rowCount(rows.size()),
+m_rowPosition(0),
+m_fieldCount(fieldCount),
+m_rBind(nullptr),
+m_stmt(nullptr),
+m_metadataResult(nullptr),
+m_source(std::move(source))
+{
+    ASSERT(m_fieldCount <= m_source->m_fieldCount);
+
+    //- Fields don't own their data, copying them is enough to share the arena of the source
+    m_rows.reserve(rows.size() * m_fieldCount);
+    for (uint64 row : rows)
+    {
+        ASSERT(row < m_source->m_rowCount);
+        Field const* fields = &m_source->m_rows[uint32(row) * m_source->m_fieldCount];
+        m_rows.insert(m_rows.end(), fields, fields + m_fieldCount);
+    }
+}
+
 PreparedResultSet::~PreparedResultSet()
 {
     CleanUp();
@@ -296,7 +369,22 @@ bool ResultSet::NextRow()
     }
 
     for (uint32 i = 0; i < _fieldCount; i++)
-        _currentRow[i].SetStructuredValue(row[i], MysqlTypeToFieldType(_fields[i].type), lengths[i]);
+    {
+        char* value = row[i];
+        if (!_valueCopies.empty())
+        {
+            _valueCopies[i].reset();
+            if (value)
+            {
+                _valueCopies[i].reset(new char[lengths[i] + 1]);
+                memcpy(_valueCopies[i].get(), value, lengths[i]);
+                _valueCopies[i][lengths[i]] = '\0';
+                value = _valueCopies[i].get();
+            }
+        }
+
+        _currentRow[i].SetStructuredValue(value, MysqlTypeToFieldType(_fields[i].type), lengths[i]);
+    }
 
     return true;
 }
@@ -330,6 +418,8 @@ void ResultSet::CleanUp()
         _currentRow = nullptr;
     }
 
+    _valueCopies.clear();
+
     if (_result)
     {
         mysql_free_result(_result);
@@ -363,7 +453,7 @@ void PreparedResultSet::CleanUp()
 
     if (m_rBind)
     {
-        delete[](char*)m_rBind->buffer;
+        delete[](char*)m_rBind->buffer;   // row buffer (every row without the arena), bound to the first column
         delete[] m_rBind;
         m_rBind = nullptr;
     }
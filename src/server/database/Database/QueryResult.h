@@ -21,6 +21,8 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include <atomic>
+#include <memory>
 #include <vector>
 
 class TC_DATABASE_API ResultSet
@@ -36,6 +38,10 @@ class TC_DATABASE_API ResultSet
         Field* Fetch() const { return _currentRow; }
         Field const& operator[](std::size_t index) const;
 
+        //! Results stored after enabling the copies give every value its own copy, as before the fields pointed into the MySQL row. For benchmarks.
+        static void SetValueCopiesEnabled(bool enabled) { _valueCopiesEnabled.store(enabled, std::memory_order_relaxed); }
+        static bool AreValueCopiesEnabled() { return _valueCopiesEnabled.load(std::memory_order_relaxed); }
+
     protected:
         uint64 _rowCount;
         Field* _currentRow;
@@ -45,6 +51,9 @@ class TC_DATABASE_API ResultSet
         void CleanUp();
         MySQLResult* _result;
         MySQLField* _fields;
+        std::vector<std::unique_ptr<char[]>> _valueCopies;    ///< Values of the current row, only with the value copies enabled
+
+        static std::atomic<bool> _valueCopiesEnabled;
 
         ResultSet(ResultSet const& right) = delete;
         ResultSet& operator=(ResultSet const& right) = delete;
@@ -54,6 +63,8 @@ class TC_DATABASE_API PreparedResultSet
 {
     public:
         PreparedResultSet(MySQLStmt* stmt, MySQLResult* result, uint64 rowCount, uint32 fieldCount);
+        //! Result made of some rows of another result, sharing its data. Only the first fieldCount columns are kept.
+        PreparedResultSet(std::shared_ptr<PreparedResultSet> source, std::vector<uint64> const& rows, uint32 fieldCount);
         ~PreparedResultSet();
 
         bool NextRow();
@@ -63,8 +74,13 @@ class TC_DATABASE_API PreparedResultSet
         Field* Fetch() const;
         Field const& operator[](std::size_t index) const;
 
+        //! Results stored after disabling the arena keep every row in its own copy of the row buffer, as before the arena. For benchmarks.
+        static void SetArenaEnabled(bool enabled) { _arenaEnabled.store(enabled, std::memory_order_relaxed); }
+        static bool IsArenaEnabled() { return _arenaEnabled.load(std::memory_order_relaxed); }
+
     protected:
         std::vector<Field> m_rows;
+        std::vector<char> m_arena;        ///< Data of every row, the fields point into it
         uint64 m_rowCount;
         uint64 m_rowPosition;
         uint32 m_fieldCount;
@@ -73,6 +89,9 @@ class TC_DATABASE_API PreparedResultSet
         MySQLBind* m_rBind;
         MySQLStmt* m_stmt;
         MySQLResult* m_metadataResult;    ///< Field metadata, returned by mysql_stmt_result_metadata
+        std::shared_ptr<PreparedResultSet> m_source;    ///< Result owning the data of a subset of its rows
+
+        static std::atomic<bool> _arenaEnabled;
 
         void CleanUp();
         bool _NextRow();
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include <chrono>
 
 //- Union that holds element data
 union SQLElementUnion
@@ -65,7 +66,15 @@ class TC_DATABASE_API SQLOperation
         virtual bool Execute() = 0;
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
+        //- One-way prepared statements, the async workers may execute several of them in one transaction
+        virtual bool IsBatchable() const { return false; }
+        //- Prepared statement index, for the latency stats
+        virtual uint32 GetStatementIndex() const { return NO_STATEMENT; }
+
+        static uint32 const NO_STATEMENT = 0xFFFFFFFF;
+
         MySQLConnection* m_conn;
+        std::chrono::steady_clock::time_point m_enqueueTime;    //- Set when pushed to the async queue
 
     private:
         SQLOperation(SQLOperation const& right) = delete;
@@ -69,6 +69,13 @@ void Transaction::Cleanup()
     _cleanedUp = true;
 }
 
+//- Report the failure to the flag set with SetFailedFlag, if any
+void Transaction::Fail()
+{
+    if (_failed)
+        _failed->store(true);
+}
+
 bool TransactionTask::Execute()
 {
     int errorCode = m_conn->ExecuteTransaction(m_trans);
@@ -95,6 +102,8 @@ bool TransactionTask::Execute()
         TC_LOG_ERROR("sql.sql", "Fatal deadlocked SQL Transaction, it will not be retried anymore. Thread Id: %s", threadId.c_str());
     }
 
+    m_trans->Fail();
+
     // Clean up now.
     m_trans->Cleanup();
 
@@ -22,6 +22,8 @@
 #include "DatabaseEnvFwd.h"
 #include "SQLOperation.h"
 #include "StringFormat.h"
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -48,12 +50,17 @@ class TC_DATABASE_API Transaction
 
         std::size_t GetSize() const { return m_queries.size(); }
 
+        //! Set to true if the transaction fails, a flag may be shared by several transactions
+        void SetFailedFlag(std::shared_ptr<std::atomic<bool>> failed) { _failed = std::move(failed); }
+
     protected:
         void Cleanup();
+        void Fail();
         std::vector<SQLElementData> m_queries;
 
     private:
         bool _cleanedUp;
+        std::shared_ptr<std::atomic<bool>> _failed;
 
 };
 
@@ -8,6 +8,8 @@
 #include "Chat.h"
 #include "CharacterCache.h"
 #include "GameTime.h"
+#include "WorldSession.h"
+#include <algorithm>
 
 #ifdef VOICECHAT
 #include "VoiceChat/VoiceChatMgr.h"
@@ -147,6 +149,7 @@ void Channel::Join(ObjectGuid p, const char *pass)
     pinfo.flags = 0;
     pinfo.invisible = (plr ? plr->GetSession()->GetSecurity() > SEC_PLAYER : false) && sWorld->getConfig(CONFIG_SILENTLY_GM_JOIN_TO_CHANNEL);
     players[p] = pinfo;
+    AddMemberSession(p, plr);
 
 #ifdef VOICECHAT
     // join voice chat
@@ -209,6 +212,7 @@ void Channel::Leave(ObjectGuid p, bool send)
         bool changeowner = players[p].IsOwner();
 
         players.erase(p);
+        RemoveMemberSession(p);
         if(m_announce && (!plr || plr->GetSession()->GetSecurity() == SEC_PLAYER || !sWorld->getConfig(CONFIG_SILENTLY_GM_JOIN_TO_CHANNEL) ) && this->GetName() != "world" && this->GetName() != "pvp") //announce auto-deactivated for the world & pvp channel
         {
             WorldPacket data;
@@ -288,6 +292,7 @@ void Channel::KickOrBan(ObjectGuid good, std::string const& badname, bool ban)
             if (GetName() != "world")
                 SendToAll(&data);
             players.erase(bad->GetGUID());
+            RemoveMemberSession(bad->GetGUID());
             bad->LeftChannel(this);
 
             if(changeowner)
@@ -748,28 +753,72 @@ void Channel::SetOwner(ObjectGuid guid, bool exclaim)
 
 void Channel::SendToAll(WorldPacket *data, ObjectGuid p)
 {
-    for(auto & player : players)
+    // skip the members ignoring p, both lists are sorted by guid
+    std::vector<ObjectGuid::LowType> ignoring;
+    if (p)
+        ignoring = sSocialMgr->GetIgnoringPlayers(p.GetCounter());
+
+    auto ignoringItr = ignoring.begin();
+    for (MemberSession const& member : m_memberSessions)
     {
-        Player *plr = ObjectAccessor::FindPlayer(player.first);
-        if(plr)
-        {
-            if(!p || !plr->GetSocial()->HasIgnore(p.GetCounter()))
-                plr->SendDirectMessage(data);
-        }
+        while (ignoringItr != ignoring.end() && *ignoringItr < member.guid)
+            ++ignoringItr;
+
+        if (ignoringItr != ignoring.end() && *ignoringItr == member.guid)
+            continue;
+
+        SendToMember(data, member);
     }
 }
 
 void Channel::SendToAllButOne(WorldPacket *data, ObjectGuid who)
 {
-    for(auto & player : players)
+    for (MemberSession const& member : m_memberSessions)
+        if (member.guid != who.GetCounter())
+            SendToMember(data, member);
+}
+
+void Channel::SendToMember(WorldPacket const* data, MemberSession const& member)
+{
+    Player* plr = nullptr;
+    if (member.session)
     {
-        if(player.first != who)
-        {
-            Player *plr = ObjectAccessor::FindPlayer(player.first);
-            if(plr)
-                plr->SendDirectMessage(data);
-        }
+        // members leave their channels at logout, the session cannot be gone
+        plr = member.session->GetPlayer();
+        if (plr && plr->GetGUID().GetCounter() != member.guid)
+            plr = nullptr;
     }
+    else
+        plr = ObjectAccessor::FindPlayer(ObjectGuid(HighGuid::Player, member.guid));
+
+    if (plr && plr->IsInWorld())
+        plr->SendDirectMessage(data);
+}
+
+void Channel::AddMemberSession(ObjectGuid guid, Player* player)
+{
+    MemberSession member;
+    member.guid = guid.GetCounter();
+    member.session = player ? player->GetSession() : nullptr;
+
+    auto itr = std::lower_bound(m_memberSessions.begin(), m_memberSessions.end(), member.guid, [](MemberSession const& left, ObjectGuid::LowType right)
+    {
+        return left.guid < right;
+    });
+    if (itr != m_memberSessions.end() && itr->guid == member.guid)
+        *itr = member;
+    else
+        m_memberSessions.insert(itr, member);
+}
+
+void Channel::RemoveMemberSession(ObjectGuid guid)
+{
+    auto itr = std::lower_bound(m_memberSessions.begin(), m_memberSessions.end(), guid.GetCounter(), [](MemberSession const& left, ObjectGuid::LowType right)
+    {
+        return left.guid < right;
+    });
+    if (itr != m_memberSessions.end() && itr->guid == guid.GetCounter())
+        m_memberSessions.erase(itr);
 }
 
 void Channel::SendToOne(WorldPacket *data, ObjectGuid who)
@@ -8,6 +8,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 enum ChatNotify
 {
@@ -142,6 +143,15 @@ class TC_GAME_API Channel
 
     typedef     std::map<ObjectGuid, PlayerInfo> PlayerList;
     PlayerList  players;
+
+    // Sessions of the members, used to send packets to all members without looking them up
+    struct MemberSession
+    {
+        ObjectGuid::LowType guid;
+        WorldSession* session;                              // null if the player was not found when joining
+    };
+    typedef     std::vector<MemberSession> MemberSessionList;
+    MemberSessionList m_memberSessions;                     // sorted by guid
     typedef     std::set<uint64> BannedList;
     BannedList  banned;
     typedef     std::map<uint64, time_t> GMBannedList;      // Banned by .chanban, <AccountGUID, Expiration date>
@@ -200,6 +210,10 @@ class TC_GAME_API Channel
 
         void SendToAllButOne(WorldPacket *data, ObjectGuid who);
         void SendToOne(WorldPacket *data, ObjectGuid who);
+        void SendToMember(WorldPacket const* data, MemberSession const& member);
+
+        void AddMemberSession(ObjectGuid guid, Player* player);
+        void RemoveMemberSession(ObjectGuid guid);
         
         bool IsBannedByGM(const ObjectGuid guid);
         void InsertInGMBannedList(ObjectGuid guid, uint64 expire) { gmbanned[guid] = expire; }
@@ -30,6 +30,8 @@
 #include "Spell.h"
 #include "SharedDefines.h"
 #include "ReputationMgr.h"
+#include "World.h"
+#include <tuple>
 
 char const* ConditionMgr::StaticSourceTypeData[CONDITION_SOURCE_TYPE_MAX] =
 {
@@ -787,6 +789,199 @@ std::string Condition::ToString(bool ext /*= false*/) const
     return ss.str();
 }
 
+CompiledConditionList::CompiledConditionList(ConditionContainer const& conditions) : _source(conditions)
+{
+    // else groups in order of first appearance
+    std::vector<std::pair<uint32, std::vector<Op>>> groups;
+    for (Condition* condition : conditions)
+    {
+        condition->CompiledList = this;
+        if (!condition->isLoaded())
+            continue;
+
+        auto itr = std::find_if(groups.begin(), groups.end(), [condition](std::pair<uint32, std::vector<Op>> const& group) { return group.first == condition->ElseGroup; });
+        if (itr == groups.end())
+        {
+            groups.emplace_back(condition->ElseGroup, std::vector<Op>());
+            itr = std::prev(groups.end());
+        }
+        itr->second.push_back({ condition, nullptr, GetCost(condition), !condition->ReferenceId && IsInvariantDuringTick(condition) });
+    }
+
+    for (auto& group : groups)
+    {
+        std::stable_sort(group.second.begin(), group.second.end(), [](Op const& left, Op const& right) { return left.cost < right.cost; });
+        _ops.insert(_ops.end(), group.second.begin(), group.second.end());
+        _groupEnds.push_back(_ops.size());
+    }
+
+    _tickCache.reset(new std::atomic<uint64>[_ops.size()]);
+    for (uint32 i = 0; i < _ops.size(); ++i)
+        _tickCache[i].store(std::numeric_limits<uint64>::max(), std::memory_order_relaxed);
+}
+
+void CompiledConditionList::Link(ConditionReferenceContainer const& references)
+{
+    for (Op& op : _ops)
+    {
+        if (!op.condition->ReferenceId)
+            continue;
+
+        ConditionReferenceContainer::const_iterator ref = references.find(op.condition->ReferenceId);
+        if (ref != references.end())
+            op.reference = Get(ref->second);
+    }
+}
+
+CompiledConditionList const* CompiledConditionList::Get(ConditionContainer const& conditions)
+{
+    if (conditions.empty())
+        return nullptr;
+
+    // lists built from loaded conditions by other means are not compiled
+    CompiledConditionList const* compiled = conditions.front()->CompiledList;
+    if (!compiled || compiled->_source != conditions)
+        return nullptr;
+
+    return compiled;
+}
+
+bool CompiledConditionList::Meets(ConditionSourceInfo& sourceInfo) const
+{
+    uint32 begin = 0;
+    for (uint32 end : _groupEnds)
+    {
+        uint32 i = begin;
+        for (; i < end; ++i)
+        {
+            Op const& op = _ops[i];
+            bool meets;
+            if (op.condition->ReferenceId)
+                meets = !op.reference || op.reference->Meets(sourceInfo); // missing references are ignored, checked at loading
+            else if (op.perTick)
+                meets = MeetsPerTick(i, sourceInfo);
+            else
+                meets = op.condition->Meets(sourceInfo);
+
+            if (!meets)
+                break;
+        }
+
+        if (i == end)
+            return true;
+
+        begin = end;
+    }
+
+    return false;
+}
+
+bool CompiledConditionList::MeetsPerTick(uint32 index, ConditionSourceInfo& sourceInfo) const
+{
+    Condition* condition = _ops[index].condition;
+    // the condition still fails without target
+    if (!sourceInfo.mConditionTargets[condition->ConditionTarget])
+        return condition->Meets(sourceInfo);
+
+    uint64 const tick = World::m_worldLoopCounter.load(std::memory_order_relaxed);
+    uint64 const cached = _tickCache[index].load(std::memory_order_relaxed);
+    if ((cached >> 1) == tick)
+    {
+        bool const meets = (cached & 1) != 0;
+        if (!meets)
+            sourceInfo.mLastFailedCondition = condition;
+        return meets;
+    }
+
+    bool const meets = condition->Meets(sourceInfo);
+    _tickCache[index].store((tick << 1) | uint64(meets), std::memory_order_relaxed);
+    return meets;
+}
+
+// Relative cost of a condition check, cheapest checks are done first
+uint8 CompiledConditionList::GetCost(Condition const* condition)
+{
+    if (condition->ReferenceId)
+        return 4;
+
+    switch (condition->ConditionType)
+    {
+        // cached per world update, a world state lookup, or a field of the target
+        case CONDITION_NONE:
+        case CONDITION_ACTIVE_EVENT:
+        case CONDITION_WORLD_STATE:
+        case CONDITION_WOW_PATCH:
+        case CONDITION_ACHIEVEMENT:
+        case CONDITION_REALM_ACHIEVEMENT:
+        case CONDITION_MAPID:
+        case CONDITION_ZONEID:
+        case CONDITION_AREAID:
+        case CONDITION_TEAM:
+        case CONDITION_CLASS:
+        case CONDITION_RACE:
+        case CONDITION_GENDER:
+        case CONDITION_LEVEL:
+        case CONDITION_DRUNKENSTATE:
+        case CONDITION_OBJECT_ENTRY_GUID:
+        case CONDITION_TYPE_MASK:
+        case CONDITION_ALIVE:
+        case CONDITION_HP_VAL:
+        case CONDITION_HP_PCT:
+        case CONDITION_PHASEMASK:
+        case CONDITION_SPAWNMASK:
+        case CONDITION_UNIT_STATE:
+        case CONDITION_CREATURE_TYPE:
+        case CONDITION_STAND_STATE:
+        case CONDITION_CHARMED:
+        case CONDITION_TAXI:
+        case CONDITION_FACTION:
+            return 0;
+        // lookups in the target containers
+        case CONDITION_AURA:
+        case CONDITION_REPUTATION_RANK:
+        case CONDITION_SKILL:
+        case CONDITION_QUESTREWARDED:
+        case CONDITION_QUESTTAKEN:
+        case CONDITION_QUEST_COMPLETE:
+        case CONDITION_QUEST_NONE:
+        case CONDITION_QUESTSTATE:
+        case CONDITION_DAILY_QUEST_DONE:
+        case CONDITION_SPELL:
+        case CONDITION_TITLE:
+        case CONDITION_PET_TYPE:
+        case CONDITION_INSTANCE_INFO:
+        case CONDITION_RELATION_TO:
+        case CONDITION_REACTION_TO:
+        case CONDITION_DISTANCE_TO:
+        case CONDITION_IN_WATER:
+            return 1;
+        // inventory scans
+        case CONDITION_ITEM:
+        case CONDITION_ITEM_EQUIPPED:
+            return 2;
+        // grid searches
+        case CONDITION_NEAR_CREATURE:
+        case CONDITION_NEAR_GAMEOBJECT:
+            return 3;
+        default:
+            return 2;
+    }
+}
+
+bool CompiledConditionList::IsInvariantDuringTick(Condition const* condition)
+{
+    switch (condition->ConditionType)
+    {
+        // not CONDITION_WORLD_STATE, scripts can change world states in the middle of a tick
+        case CONDITION_ACTIVE_EVENT:                        // events start and stop in the world update
+        case CONDITION_WOW_PATCH:
+        case CONDITION_REALM_ACHIEVEMENT:
+            return true;
+        default:
+            return false;
+    }
+}
+
 ConditionMgr::ConditionMgr() { }
 
 ConditionMgr::~ConditionMgr()
@@ -844,6 +1039,14 @@ uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionContainer cons
 }
 
 bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const
+{
+    if (CompiledConditionList const* compiled = CompiledConditionList::Get(conditions))
+        return compiled->Meets(sourceInfo);
+
+    return InterpretConditionList(sourceInfo, conditions);
+}
+
+bool ConditionMgr::InterpretConditionList(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const
 {
     //     groupId, groupCheckPassed
     std::map<uint32, bool> ElseGroupStore;
@@ -865,7 +1068,7 @@ bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo,
                 ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find(condition->ReferenceId);
                 if (ref != ConditionReferenceStore.end())
                 {
-                    if (!IsObjectMeetToConditionList(sourceInfo, (*ref).second))
+                    if (!InterpretConditionList(sourceInfo, (*ref).second))
                         ElseGroupStore[condition->ElseGroup] = false;
                 }
                 else
@@ -906,10 +1109,17 @@ bool ConditionMgr::IsObjectMeetToConditions(ConditionSourceInfo& sourceInfo, Con
     if (conditions.empty())
         return true;
 
-    TC_LOG_DEBUG("condition", "ConditionMgr::IsObjectMeetToConditions");
     return IsObjectMeetToConditionList(sourceInfo, conditions);
 }
 
+bool ConditionMgr::IsObjectMeetToConditionsInterpreted(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const
+{
+    if (conditions.empty())
+        return true;
+
+    return InterpretConditionList(sourceInfo, conditions);
+}
+
 bool ConditionMgr::CanHaveSourceGroupSet(ConditionSourceType sourceType)
 {
     return (sourceType == CONDITION_SOURCE_TYPE_CREATURE_LOOT_TEMPLATE ||
@@ -1306,7 +1516,47 @@ void ConditionMgr::LoadConditions(bool isReload)
     }
     while (result->NextRow());
 
-    TC_LOG_INFO("server.loading", ">> Loaded %u conditions in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
+    CompileConditionLists();
+
+    TC_LOG_INFO("server.loading", ">> Loaded %u conditions (%u lists) in %u ms", count, uint32(CompiledLists.size()), GetMSTimeDiffToNow(oldMSTime));
+}
+
+void ConditionMgr::CompileConditionLists()
+{
+    CompiledLists.clear();
+    auto compile = [this](ConditionContainer const& conditions)
+    {
+        if (!conditions.empty())
+            CompiledLists.push_back(std::make_unique<CompiledConditionList>(conditions));
+    };
+
+    for (auto const& itr : ConditionReferenceStore)
+        compile(itr.second);
+
+    for (ConditionsByEntryMap const& conditionsByEntry : ConditionStore)
+        for (auto const& itr : conditionsByEntry)
+            compile(itr.second);
+
+    for (ConditionEntriesByCreatureIdMap const* store : { &VehicleSpellConditionStore, &SpellClickEventConditionStore, &NpcVendorConditionContainerStore })
+        for (auto const& itr : *store)
+            for (auto const& conditionsByEntry : itr.second)
+                compile(conditionsByEntry.second);
+
+    for (auto const& itr : SmartEventConditionStore)
+        for (auto const& conditionsByEntry : itr.second)
+            compile(conditionsByEntry.second);
+
+    // Grouped conditions were added to loot templates, gossip menus and spells: all the conditions of a source
+    // are in the same list, in loading order
+    std::map<std::tuple<uint32, uint32, int32, uint32>, ConditionContainer> groupedLists;
+    for (Condition* condition : AllocatedMemoryStore)
+        groupedLists[std::make_tuple(uint32(condition->SourceType), condition->SourceGroup, condition->SourceEntry, condition->SourceId)].push_back(condition);
+
+    for (auto const& itr : groupedLists)
+        compile(itr.second);
+
+    for (auto const& compiled : CompiledLists)
+        compiled->Link(ConditionReferenceStore);
 }
 
 bool ConditionMgr::addToLootTemplate(Condition* cond, LootTemplate* loot) const
@@ -2366,6 +2616,8 @@ void ConditionMgr::LogUselessConditionValue(Condition* cond, uint8 index, uint32
 
 void ConditionMgr::Clean()
 {
+    CompiledLists.clear();
+
     for (auto & itr : ConditionReferenceStore)
     {
         for (ConditionContainer::const_iterator it = itr.second.begin(); it != itr.second.end(); ++it)
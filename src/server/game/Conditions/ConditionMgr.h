@@ -6,9 +6,12 @@
 #include "Define.h"
 #include "Hash.h"
 #include <array>
+#include <atomic>
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 class Creature;
 class Player;
@@ -16,6 +19,7 @@ class Unit;
 class WorldObject;
 class LootTemplate;
 struct Condition;
+class CompiledConditionList;
 
 enum ConditionTypes
 {                                                           // value1           value2         value3
@@ -188,6 +192,7 @@ struct Condition
     uint32                  ScriptId;
     uint8                   ConditionTarget;
     bool                    NegativeCondition;
+    CompiledConditionList const* CompiledList;  // compiled form of the list the condition belongs to, set after loading
 
     Condition()
     {
@@ -206,6 +211,7 @@ struct Condition
         ErrorTextId        = 0;
         ScriptId           = 0;
         NegativeCondition  = false;
+        CompiledList       = nullptr;
     }
 
     bool Meets(ConditionSourceInfo& sourceInfo);
@@ -223,6 +229,47 @@ typedef std::map<uint32, ConditionsByEntryMap> ConditionEntriesByCreatureIdMap;
 typedef std::map<std::pair<int32, uint32 /*SAI source_type*/>, ConditionsByEntryMap> SmartEventConditionContainer;
 typedef std::map<uint32, ConditionContainer> ConditionReferenceContainer;//only used for references
 
+/* A condition list (all the conditions of one source) compiled after loading: loaded conditions grouped
+   by else group in a flat array, each group ordered cheapest check first so that it stops at the first
+   failed condition as soon as possible, references pointing to the compiled referenced lists.
+   Conditions which cannot change during a world update (active events, patch, realm achievements) are
+   evaluated once per world update and their result is shared by all the evaluations of that update.
+   Meets gives the same result as ConditionMgr::IsObjectMeetToConditionList on the source list, but
+   sourceInfo.mLastFailedCondition may name another failed condition when several fail.
+*/
+class TC_GAME_API CompiledConditionList
+{
+    public:
+        explicit CompiledConditionList(ConditionContainer const& conditions);
+
+        // Must be called once all lists are created, references are resolved with the compiled referenced lists
+        void Link(ConditionReferenceContainer const& references);
+        bool Meets(ConditionSourceInfo& sourceInfo) const;
+
+        ConditionContainer const& GetSource() const { return _source; }
+        // List compiled from these conditions, if any
+        static CompiledConditionList const* Get(ConditionContainer const& conditions);
+
+    private:
+        struct Op
+        {
+            Condition* condition;
+            CompiledConditionList const* reference;             // compiled referenced list, for reference conditions
+            uint8 cost;
+            bool perTick;                                       // result cached for the current world update
+        };
+
+        bool MeetsPerTick(uint32 index, ConditionSourceInfo& sourceInfo) const;
+        static uint8 GetCost(Condition const* condition);
+        static bool IsInvariantDuringTick(Condition const* condition);
+
+        ConditionContainer _source;
+        std::vector<Op> _ops;
+        std::vector<uint32> _groupEnds;                         // end of each else group in _ops
+        // (world loop << 1) | result, per op
+        std::unique_ptr<std::atomic<uint64>[]> _tickCache;
+};
+
 class TC_GAME_API ConditionMgr
 {
     private:
@@ -255,6 +302,10 @@ class TC_GAME_API ConditionMgr
         bool IsObjectMeetingSmartEventConditions(int32 entryOrGuid, uint32 eventId, uint32 sourceType, Unit* unit, WorldObject* baseObject) const;
         bool IsObjectMeetingVendorItemConditions(uint32 creatureId, uint32 itemId, Player* player, Creature* vendor) const;
 
+        // Same as IsObjectMeetToConditions, ignoring the compiled lists. For tests and benchmarks
+        bool IsObjectMeetToConditionsInterpreted(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const;
+        std::vector<std::unique_ptr<CompiledConditionList>> const& GetCompiledLists() const { return CompiledLists; }
+
         struct ConditionTypeInfo
         {
             char const* Name;
@@ -272,6 +323,8 @@ class TC_GAME_API ConditionMgr
         bool addToGossipMenuItems(Condition* cond) const;
         bool addToSpellImplicitTargetConditions(Condition* cond) const;
         bool IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const;
+        bool InterpretConditionList(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const;
+        void CompileConditionLists();
 
         static void LogUselessConditionValue(Condition* cond, uint8 index, uint32 value);
 
@@ -284,6 +337,7 @@ class TC_GAME_API ConditionMgr
         ConditionEntriesByCreatureIdMap   SpellClickEventConditionStore;
         ConditionEntriesByCreatureIdMap   NpcVendorConditionContainerStore;
         SmartEventConditionContainer      SmartEventConditionStore;
+        std::vector<std::unique_ptr<CompiledConditionList>> CompiledLists;
 };
 
 #define sConditionMgr ConditionMgr::instance()
@@ -223,6 +223,8 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
 
 void LoadDBCStores(const std::string& dataPath)
 {
+    uint32 oldMSTime = GetMSTime();
+
     std::string dbcPath = dataPath+"dbc/";
 
     const uint32 DBCFilesCount = 58;
@@ -547,7 +549,7 @@ void LoadDBCStores(const std::string& dataPath)
 #define LOAD_DBC_EXT(store, file, dbtable, dbformat, dbpk) LoadDBC(availableDbcLocales, bad_dbc_files, store, dbcPath, file, dbtable, dbformat, dbpk)
     //no dbc ext for now for TBC
 
-    TC_LOG_INFO("server.loading", ">> Loaded %d data stores", DBCFilesCount );
+    TC_LOG_INFO("server.loading", ">> Loaded %d data stores in %u ms (%s)", DBCFilesCount, GetMSTimeDiffToNow(oldMSTime), DBCFileLoader::IsMemoryMapped() ? "memory mapped" : "read");
 }
 
 SimpleFactionsList const* GetFactionTeamList(uint32 faction)
@@ -10,6 +10,7 @@
 #include "Duration.h"
 #include "Loot.h"
 #include "WorldPacket.h"
+#include "UpdateLOD.h"
 
 #include <list>
 #include <string>
@@ -433,6 +434,8 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         void AtEngage(Unit* target) override;
         void AtDisengage() override;
 
+        CreatureUpdateLODState& GetUpdateLODState() { return m_updateLODState; }
+
         std::string GetDebugInfo() const override;
 
     protected:
@@ -510,6 +513,8 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         bool m_triggerJustAppeared;
         bool m_respawnCompatibilityMode;
 
+        CreatureUpdateLODState m_updateLODState;
+
         CreatureTemplate const* m_creatureInfo;                 // in heroic mode can different from ObjectMgr::GetCreatureTemplate(GetEntry())
         CreatureData const* m_creatureData;
 
@@ -1208,6 +1208,8 @@ void GameObject::EnableCollision(bool enable)
         return;
 
     m_model->enable(enable);
+    if (Map* map = FindMap())
+        map->InvalidateLineOfSightCache();
 }
 
 void GameObject::UpdateModel()
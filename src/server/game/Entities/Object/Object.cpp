@@ -37,6 +37,7 @@
 
 #include "TemporarySummon.h"
 #include "DynamicTree.h"
+#include <array>
 
 constexpr float VisibilityDistances[AsUnderlyingType(VisibilityDistanceType::Max)] =
 {
@@ -1076,6 +1077,46 @@ bool WorldObject::IsSelfOrInSameMap(WorldObject const* obj) const
     return IsInMap(obj);
 }
 
+void WorldObject::AreWithinLOS(WorldObject const* const* objects, uint32 count, float ox, float oy, float oz, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags, bool* results)
+{
+    // same rays as IsWithinLOS, reversed. They start from (ox, oy, oz) raised by the collision height of the object,
+    // the objects sharing a map, phase mask and collision height make one fan
+    typedef std::tuple<Map const*, uint32, float> FanKey;
+    std::map<FanKey, std::vector<uint32>> fans;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        results[i] = true;
+        if (objects[i]->IsInWorld())
+            fans[FanKey(objects[i]->GetMap(), objects[i]->GetPhaseMask(), objects[i]->GetCollisionHeight())].push_back(i);
+    }
+
+    std::vector<Position> targets;
+    std::unique_ptr<bool[]> fanResults(new bool[count]);
+    for (auto const& fan : fans)
+    {
+        float const z = oz + std::get<2>(fan.first);
+        targets.clear();
+        for (uint32 i : fan.second)
+        {
+            WorldObject const* object = objects[i];
+            float x, y, tz;
+            if (object->GetTypeId() == TYPEID_PLAYER)
+            {
+                object->GetPosition(x, y, tz);
+                tz += object->GetCollisionHeight();
+            }
+            else
+                object->GetHitSpherePointFor({ ox, oy, z }, x, y, tz);
+
+            targets.emplace_back(x, y, tz + 2.0f);
+        }
+
+        std::get<0>(fan.first)->isInLineOfSight(ox, oy, z + 2.0f, targets.data(), targets.size(), std::get<1>(fan.first), checks, ignoreFlags, fanResults.get());
+        for (uint32 j = 0; j < fan.second.size(); ++j)
+            results[fan.second[j]] = fanResults[j];
+    }
+}
+
 bool WorldObject::IsWithinLOSInMap(const WorldObject* obj, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
 {
     if (!IsInMap(obj)) 
@@ -1310,21 +1351,32 @@ void WorldObject::UpdateAllowedPositionZ(uint32 phaseMask, uint32 mapId, float x
 // excludeCollisionHeight should only be true if you had collision, it wont add it to raycasts for dest position.
 float WorldObject::SelectBestZForDestination(float x, float y, float z, bool excludeCollisionHeight) const
 {
-    if (Unit const* unit = ToUnit())
-    {
-        float const ground = GetFloorZ();
-        bool const isInAir = (G3D::fuzzyGt(unit->GetPositionZ(), ground + GROUND_HEIGHT_TOLERANCE) || G3D::fuzzyLt(unit->GetPositionZ(), ground - GROUND_HEIGHT_TOLERANCE));
-       if (isInAir)
-       {
-            // creatures never get MOVEMENTFLAG_PLAYER_FLYING, check it additionally for them
-            if (Creature const* creature = ToCreature())
-                if (creature->CanFly())
-                    return z;
-
-            if (unit->IsFlying())
-                return z;
-        }
-    }
+    return SelectBestZForDestination(x, y, z, excludeCollisionHeight, GetMap()->GetGridMapHeight(GetPositionX(), GetPositionY()), GetMap()->GetGridMapHeight(x, y));
+}
+
+bool WorldObject::KeepsDestinationZ() const
+{
+    Unit const* unit = ToUnit();
+    if (!unit)
+        return false;
+
+    float const ground = GetFloorZ();
+    bool const isInAir = (G3D::fuzzyGt(unit->GetPositionZ(), ground + GROUND_HEIGHT_TOLERANCE) || G3D::fuzzyLt(unit->GetPositionZ(), ground - GROUND_HEIGHT_TOLERANCE));
+    if (!isInAir)
+        return false;
+
+    // creatures never get MOVEMENTFLAG_PLAYER_FLYING, check it additionally for them
+    if (Creature const* creature = ToCreature())
+        if (creature->CanFly())
+            return true;
+
+    return unit->IsFlying();
+}
+
+float WorldObject::SelectBestZForDestination(float x, float y, float z, bool excludeCollisionHeight, float myGridHeight, float destGridHeight) const
+{
+    if (KeepsDestinationZ())
+        return z;
 
     float myX, myY, myZ;
     GetPosition(myX, myY, myZ);
@@ -1332,12 +1384,10 @@ float WorldObject::SelectBestZForDestination(float x, float y, float z, bool exc
     float const myCollisionHeight = GetCollisionHeight();
     float const destCollisionHeight = excludeCollisionHeight ? 0.0f : myCollisionHeight;
 
-    float const myGridHeight = GetMap()->GetGridMapHeight(myX, myY);
     float const myVmapFloor = std::max(GetMap()->GetVMapFloor(myX, myY, myZ, 150.0f, myCollisionHeight),
         GetMap()->GetGameObjectFloor(GetPhaseMask(), myX, myY, myZ, 150.0f, myCollisionHeight));
 
     // which of these 3 do I want ?
-    float const destGridHeight = GetMap()->GetGridMapHeight(x, y);
     float const destCeil = GetMap()->GetCeil(GetPhaseMask(), x, y, z, 150.0f, destCollisionHeight);
     float const destVmapFloor = std::max(GetMap()->GetVMapFloor(x, y, z, 150.0f, destCollisionHeight),
         GetMap()->GetGameObjectFloor(GetPhaseMask(), x, y, z, 150.0f, destCollisionHeight));
@@ -2159,23 +2209,50 @@ void WorldObject::MovePositionToFirstWalkableCollision(Position &pos, float dist
     if (col)
         dist = std::sqrt((pos.m_positionX - destx)*(pos.m_positionX - destx) + (pos.m_positionY - desty)*(pos.m_positionY - desty));
 
-    destz = SelectBestZForDestination(destx, desty, destz, col);
+    float step = dist / 10.0f;
+
+    // flying units keep their z, they don't need any grid height
+    bool const keepZ = KeepsDestinationZ();
+
+    // sample the grid heights of our position and the destination, the points we may step back to are only sampled if we do
+    std::array<float, 12> pointsX, pointsY, gridHeights;
+    pointsX[0] = GetPositionX();
+    pointsY[0] = GetPositionY();
+    pointsX[1] = destx;
+    pointsY[1] = desty;
+    if (!keepZ)
+    {
+        GetMap()->GetGridMapHeights(pointsX.data(), pointsY.data(), gridHeights.data(), 2);
+        destz = SelectBestZForDestination(destx, desty, destz, col, gridHeights[0], gridHeights[1]);
+    }
+    bool stepsSampled = false;
 
     TC_LOG_DEBUG("vmap", "WorldObject::MovePositionToFirstWalkableCollision: Called with %f,%f. Target Z set to %f.", destx, desty, destz);
-    
-    float step = dist / 10.0f;
 
     for (uint8 j = 0; j < 10; ++j)
     {
         // do not allow too big z changes. I too much changes, try again to get a position a little bit closer.
         if (fabs(pos.m_positionZ - destz) > 7.5f)
         {
-            destx -= step * std::cos(angle);
-            desty -= step * std::sin(angle);
+            if (!stepsSampled)
+            {
+                for (uint8 i = 2; i < pointsX.size(); ++i)
+                {
+                    pointsX[i] = pointsX[i - 1] - step * std::cos(angle);
+                    pointsY[i] = pointsY[i - 1] - step * std::sin(angle);
+                }
+                if (!keepZ)
+                    GetMap()->GetGridMapHeights(pointsX.data() + 2, pointsY.data() + 2, gridHeights.data() + 2, pointsX.size() - 2);
+                stepsSampled = true;
+            }
+
+            destx = pointsX[j + 2];
+            desty = pointsY[j + 2];
             destz = pos.m_positionZ; //reset destz at each step before updating it
             // There should not be any collision between our position and destx, desty, pos.m_positionZ at this point.
             // Use pos.m_positionZ here because destz was not good.
-            destz = SelectBestZForDestination(destx, desty, destz, col);
+            if (!keepZ)
+                destz = SelectBestZForDestination(destx, desty, destz, col, gridHeights[0], gridHeights[j + 2]);
         }
         // we have correct destz now
         else
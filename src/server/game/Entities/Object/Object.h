@@ -454,6 +454,10 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         //Set Z to closest allowed position, depending on given fly/swim/waterwalk abilities given
         static void UpdateAllowedPositionZ(uint32 phaseMask, uint32 mapId, float x, float y, float &z, bool canSwim, bool canFly, bool waterWalk, float collisionHeight, float maxDist = 50.0f);
         float SelectBestZForDestination(float x, float y, float z, bool excludeCollisionHeight) const;
+        // Same with the grid map heights at our position and at destination already sampled
+        float SelectBestZForDestination(float x, float y, float z, bool excludeCollisionHeight, float myGridHeight, float destGridHeight) const;
+        // True if SelectBestZForDestination keeps the given z, for flying units away from the ground
+        bool KeepsDestinationZ() const;
 
         void GetRandomPoint(Position const& pos, float distance, float &rand_x, float &rand_y, float &rand_z) const;
         Position GetRandomPoint(Position const &srcPos, float distance) const;
@@ -510,6 +514,8 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         bool IsWithinDistInMap(WorldObject const* obj, float dist2compare, bool is3D = true, bool incOwnRadius = true, bool incTargetRadius = true) const;
         bool IsWithinLOS(float x, float y, float z, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
         bool IsWithinLOSInMap(WorldObject const* obj, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
+        // IsWithinLOS(x, y, z) for count objects, the rays are cast together as fans from (x, y, z). Sets results[i] for objects[i]
+        static void AreWithinLOS(WorldObject const* const* objects, uint32 count, float x, float y, float z, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags, bool* results);
         Position GetHitSpherePointFor(Position const& dest) const;
         void GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z) const;
         bool isInFront(WorldObject const* target, float arc = M_PI) const;
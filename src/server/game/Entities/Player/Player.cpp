@@ -61,6 +61,7 @@
 #include "CharacterCache.h"
 #include "UpdateFieldFlags.h"
 #include "CharacterDatabase.h"
+#include "Monitor.h"
 #include "PlayerTaxi.h"
 #include "CinematicMgr.h"
 #include "PlayerAntiCheat.h"
@@ -74,6 +75,7 @@
 #include "PoolMgr.h"
 #include "WorldStatePackets.h"
 #include "TicketMgr.h"
+#include "WhoListStorage.h"
 
 #ifdef PLAYERBOT
 #include "PlayerbotAI.h"
@@ -274,6 +276,7 @@ Player::Player(WorldSession *session) :
     m_ammoDPS = 0.0f;
 
     m_temporaryUnsummonedPetNumber = 0;
+    m_fullVisibilityUpdate = true;
     //cache for UNIT_CREATED_BY_SPELL to allow
     //returning reagents for temporarily removed pets
     //when dying/logging out
@@ -297,6 +300,7 @@ Player::Player(WorldSession *session) :
     m_resetTalentsCost = 0;
     m_resetTalentsTime = 0;
     m_itemUpdateQueueBlocked = false;
+    m_saveFailed = std::make_shared<std::atomic<bool>>(false);
 
     for (unsigned char & m_forced_speed_change : m_forced_speed_changes)
         m_forced_speed_change = 0;
@@ -2043,6 +2047,8 @@ void Player::AddToWorld()
         if(m_items[i])
             m_items[i]->AddToWorld();
 
+    sWhoListStorageMgr->MarkDirty(GetGUID());
+
     //WR HACK, remove me. Fog of Corruption
     if (HasAura(45717))
         CastSpell(this, 45917, true); //Soul Sever - instakill
@@ -2071,6 +2077,8 @@ void Player::RemoveFromWorld()
         if(m_items[i])
             m_items[i]->RemoveFromWorld();
 
+    sWhoListStorageMgr->MarkDirty(GetGUID());
+
     if (isSpectator())
         SetSpectate(false);
 
@@ -2567,6 +2575,7 @@ void Player::SetGMVisible(bool on)
     else
         transparence_spell = 37800; //Transparency 50%
 
+    sWhoListStorageMgr->MarkDirty(GetGUID());
 
     if(on)
     {
@@ -6982,6 +6991,8 @@ void Player::UpdateZone(uint32 newZone, uint32 newArea)
     // inform outdoor pvp
     if (oldZoneId != m_zoneUpdateId)
     {
+        sWhoListStorageMgr->MarkDirty(GetGUID());
+
         sOutdoorPvPMgr->HandlePlayerLeaveZone(this, oldZoneId);
 #ifdef LICH_KING
         sBattlefieldMgr->HandlePlayerLeaveZone(this, oldZoneId);
@@ -17147,6 +17158,11 @@ bool Player::_LoadHomeBind(PreparedQueryResult result)
 /*********************************************************/
 
 void Player::SaveToDB(bool create /*=false*/)
+{
+    _SaveToDB(create, sWorld->getBoolConfig(CONFIG_PLAYER_SAVE_DIFFERENTIAL));
+}
+
+PlayerSaveStats Player::_SaveToDB(bool create, bool differential)
 {
     // delay auto save at any saves (manual, in code, or autosave)
     m_nextSave = sWorld->getConfig(CONFIG_INTERVAL_SAVE);
@@ -17155,7 +17171,7 @@ void Player::SaveToDB(bool create /*=false*/)
     if (IsBeingTeleportedFar())
     {
         ScheduleDelayedOperation(DELAYED_SAVE_PLAYER);
-        return;
+        return PlayerSaveStats();
     }
 
     // first save/honor gain after midnight will also update the player's honor fields
@@ -17165,9 +17181,14 @@ void Player::SaveToDB(bool create /*=false*/)
         sScriptMgr->OnPlayerSave(this); 
 
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
+    trans->SetFailedFlag(m_saveFailed);
     PreparedStatement* stmt = nullptr;
     uint8 index = 0;
 
+    // create writes every row, and so does the save following a failed one: the rows it skipped may never have been written
+    if (create || m_saveFailed->exchange(false))
+        m_saveState.Invalidate();
+
     auto finiteAlways = [](float f) { return std::isfinite(f) ? f : 0.0f; };
 
     if (create)
@@ -17294,23 +17315,91 @@ void Player::SaveToDB(bool create /*=false*/)
     }
     else
     {
-        /*PrepareStatement(CHAR_UPD_CHARACTER, "UPDATE characters SET name=?,race=?,class=?,gender=?,level=?,xp=?,money=?,playerBytes=?,playerBytes2=?,playerFlags=?,"
-            "map=?,instance_id=?,dungeon_difficulty=?,position_x=?,position_y=?,position_z=?,orientation=?,trans_x=?,trans_y=?,trans_z=?,trans_o=?,transguid=?,taximask=?,cinematic=?,totaltime=?,leveltime=?,rest_bonus=?,"
-            "logout_time=?,is_logout_resting=?,resettalents_cost=?,resettalents_time=?,extra_flags=?,stable_slots=?,at_login=?,zone=?,death_expire_time=?,taxi_path=?,"
-            "arenapoints=?,totalHonorPoints=?,todayHonorPoints=?,yesterdayHonorPoints=?,totalKills=?,todayKills=?,yesterdayKills=?,chosenTitle=?,"
-            "watchedFaction=?,drunk=?,health=?,power1=?,power2=?,power3=?,power4=?,power5=?,latency=?,exploredZones=?,"
-            "equipmentCache=?,ammoId=?,knownTitles=?,actionBars=?,online=?,xp_blocked=? WHERE guid=?", CONNECTION_ASYNC);*/
-        // Update query
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_CHARACTER);
-        stmt->setString(index++, GetName());
-        stmt->setUInt8(index++, GetRace());
-        stmt->setUInt8(index++, GetClass());
-        stmt->setUInt8(index++, GetByteValue(PLAYER_BYTES_3, PLAYER_BYTES_3_OFFSET_GENDER));   // save gender from PLAYER_BYTES_3, UNIT_BYTES_0 changes with every transform effect
+        bool const online = IsInWorld() && !GetSession()->PlayerLogout();
+        // the logout save writes every row
+        if (!online || !differential)
+            m_saveState.Invalidate();
+
+        PlayerSavedCharacterColumns columns;
+        columns.name = GetName();
+        columns.race = GetRace();
+        columns.class_ = GetClass();
+        columns.gender = GetByteValue(PLAYER_BYTES_3, PLAYER_BYTES_3_OFFSET_GENDER);   // save gender from PLAYER_BYTES_3, UNIT_BYTES_0 changes with every transform effect
+        columns.playerBytes = GetUInt32Value(PLAYER_BYTES);
+        columns.playerBytes2 = GetUInt32Value(PLAYER_BYTES_2); //sun: keep this field for reskin case!
+
+        std::ostringstream ss;
+        ss << m_taxi;
+        columns.taxiMask = ss.str();
+        columns.cinematic = m_cinematic;
+        columns.resetTalentsCost = m_resetTalentsCost;
+        columns.resetTalentsTime = uint32(m_resetTalentsTime);
+        columns.extraFlags = (uint16)m_ExtraFlags;
+        columns.stableSlots = m_stableSlots;
+        columns.atLoginFlags = (uint16)m_atLoginFlags;
+        columns.deathExpireTime = uint32(m_deathExpireTime);
+
+        ss.str("");
+        ss << m_taxi.SaveTaxiDestinationsToString();
+        columns.taxiPath = ss.str();
+        columns.arenaPoints = GetArenaPoints();
+        columns.honorPoints = GetHonorPoints();
+        columns.todayContribution = GetUInt32Value(PLAYER_FIELD_TODAY_CONTRIBUTION);
+        columns.yesterdayContribution = GetUInt32Value(PLAYER_FIELD_YESTERDAY_CONTRIBUTION);
+        columns.lifetimeHonorableKills = GetUInt32Value(PLAYER_FIELD_LIFETIME_HONORABLE_KILLS);
+        columns.todayKills = GetUInt16Value(PLAYER_FIELD_KILLS, 0);
+        columns.yesterdayKills = GetUInt16Value(PLAYER_FIELD_KILLS, 1);
+        columns.chosenTitle = GetUInt32Value(PLAYER_CHOSEN_TITLE);
+        columns.watchedFaction = GetUInt32Value(PLAYER_FIELD_WATCHED_FACTION_INDEX);
+        columns.drunk = GetDrunkValue();
+
+        ss.str("");
+        for (uint32 i = 0; i < PLAYER_EXPLORED_ZONES_SIZE; ++i)
+            ss << GetUInt32Value(PLAYER_EXPLORED_ZONES_1 + i) << ' ';
+        columns.exploredZones = ss.str();
+
+        ss.str("");
+        // cache equipment...
+#ifdef LICH_KING
+        for (uint32 i = 0; i < EQUIPMENT_SLOT_END * 2; ++i)
+            ss << GetUInt32Value(PLAYER_VISIBLE_ITEM_1_ENTRYID + i) << ' ';
+
+        // ...and bags for enum opcode
+        for (uint32 i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_END; ++i)
+        {
+            if (Item* item = GetItemByPos(INVENTORY_SLOT_BAG_0, i))
+                ss << item->GetEntry();
+            else
+                ss << '0';
+            ss << " 0 ";
+        }
+#else
+        for (uint32 i = 0; i < 304; ++i) {
+            if (i % 16 == 2 || i % 16 == 3) //save only PLAYER_VISIBLE_ITEM_*_0 + PLAYER_VISIBLE_ITEM_*_PROPERTIES
+                ss << GetUInt32Value(PLAYER_VISIBLE_ITEM_1_CREATOR + i) << " ";
+        }
+#endif
+        columns.equipmentCache = ss.str();
+        columns.ammoId = GetUInt32Value(PLAYER_AMMO_ID);
+
+        ss.str("");
+#ifdef LICH_KING
+        for (uint32 i = 0; i < KNOWN_TITLES_SIZE * 2; ++i)
+            ss << GetUInt32Value(PLAYER__FIELD_KNOWN_TITLES + i) << ' ';
+#else
+        for (uint32 i = 0; i < 2; ++i)
+            ss << GetUInt32Value(PLAYER_FIELD_KNOWN_TITLES + i) << " ";
+#endif
+        columns.knownTitles = ss.str();
+        columns.actionBars = GetByteValue(PLAYER_FIELD_BYTES, PLAYER_FIELD_BYTES_OFFSET_ACTION_BAR_TOGGLES);
+        columns.xpBlocked = m_isXpBlocked;
+
+        // Update query, without the columns which rarely change if none of them did
+        bool const fullRow = !m_saveState.valid || columns != m_saveState.character;
+        stmt = CharacterDatabase.GetPreparedStatement(fullRow ? CHAR_UPD_CHARACTER : CHAR_UPD_CHARACTER_STATE);
         stmt->setUInt8(index++, GetLevel());
         stmt->setUInt32(index++, GetUInt32Value(PLAYER_XP));
         stmt->setUInt32(index++, GetMoney());
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_BYTES));
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_BYTES_2)); //sun: keep this field for reskin case!
         stmt->setUInt32(index++, GetUInt32Value(PLAYER_FLAGS));
 
         if (!IsBeingTeleported())
@@ -17343,10 +17432,6 @@ void Player::SaveToDB(bool create /*=false*/)
             transLowGUID = GetTransport()->GetGUID().GetCounter();
         stmt->setUInt32(index++, transLowGUID);
 
-        std::ostringstream ss;
-        ss << m_taxi;
-        stmt->setString(index++, ss.str());
-        stmt->setUInt8(index++, m_cinematic);
         stmt->setUInt32(index++, m_Played_time[PLAYED_TIME_TOTAL]);
         stmt->setUInt32(index++, m_Played_time[PLAYED_TIME_LEVEL]);
         stmt->setFloat(index++, finiteAlways(m_rest_bonus));
@@ -17354,81 +17439,61 @@ void Player::SaveToDB(bool create /*=false*/)
         stmt->setUInt8(index++, (HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_RESTING) ? 1 : 0));
         //save, far from tavern/city
         //save, but in tavern/city
-        stmt->setUInt32(index++, m_resetTalentsCost);
-        stmt->setUInt32(index++, uint32(m_resetTalentsTime));
-        stmt->setUInt16(index++, (uint16)m_ExtraFlags);
-        stmt->setUInt8(index++, m_stableSlots);
-        stmt->setUInt16(index++, (uint16)m_atLoginFlags);
         stmt->setUInt16(index++, GetZoneId());
-        stmt->setUInt32(index++, uint32(m_deathExpireTime));
-
-        ss.str("");
-        ss << m_taxi.SaveTaxiDestinationsToString();
-
-        stmt->setString(index++, ss.str());
-        stmt->setUInt32(index++, GetArenaPoints());
-        stmt->setUInt32(index++, GetHonorPoints());
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_FIELD_TODAY_CONTRIBUTION));
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_FIELD_YESTERDAY_CONTRIBUTION));
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_FIELD_LIFETIME_HONORABLE_KILLS));
-        stmt->setUInt16(index++, GetUInt16Value(PLAYER_FIELD_KILLS, 0));
-        stmt->setUInt16(index++, GetUInt16Value(PLAYER_FIELD_KILLS, 1));
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_CHOSEN_TITLE));
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_FIELD_WATCHED_FACTION_INDEX));
-        stmt->setUInt8(index++, GetDrunkValue());
         stmt->setUInt32(index++, GetHealth());
 
         for (uint32 i = 0; i < MAX_POWERS; ++i)
             stmt->setUInt32(index++, GetPower(Powers(i)));
 
         stmt->setUInt32(index++, GetSession()->GetLatency());
-
-        ss.str("");
-        for (uint32 i = 0; i < PLAYER_EXPLORED_ZONES_SIZE; ++i)
-            ss << GetUInt32Value(PLAYER_EXPLORED_ZONES_1 + i) << ' ';
-        stmt->setString(index++, ss.str());
-
-        ss.str("");
-        // cache equipment...
-#ifdef LICH_KING
-        for (uint32 i = 0; i < EQUIPMENT_SLOT_END * 2; ++i)
-            ss << GetUInt32Value(PLAYER_VISIBLE_ITEM_1_ENTRYID + i) << ' ';
-
-        // ...and bags for enum opcode
-        for (uint32 i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_END; ++i)
-        {
-            if (Item* item = GetItemByPos(INVENTORY_SLOT_BAG_0, i))
-                ss << item->GetEntry();
-            else
-                ss << '0';
-            ss << " 0 ";
-        }
-#else
-        for (uint32 i = 0; i < 304; ++i) {
-            if (i % 16 == 2 || i % 16 == 3) //save only PLAYER_VISIBLE_ITEM_*_0 + PLAYER_VISIBLE_ITEM_*_PROPERTIES
-                ss << GetUInt32Value(PLAYER_VISIBLE_ITEM_1_CREATOR + i) << " ";
+        stmt->setUInt8(index++, online ? 1 : 0);
+
+        if (fullRow)
+        {
+            stmt->setString(index++, columns.name);
+            stmt->setUInt8(index++, columns.race);
+            stmt->setUInt8(index++, columns.class_);
+            stmt->setUInt8(index++, columns.gender);
+            stmt->setUInt32(index++, columns.playerBytes);
+            stmt->setUInt32(index++, columns.playerBytes2);
+            stmt->setString(index++, columns.taxiMask);
+            stmt->setUInt8(index++, columns.cinematic);
+            stmt->setUInt32(index++, columns.resetTalentsCost);
+            stmt->setUInt32(index++, columns.resetTalentsTime);
+            stmt->setUInt16(index++, columns.extraFlags);
+            stmt->setUInt8(index++, columns.stableSlots);
+            stmt->setUInt16(index++, columns.atLoginFlags);
+            stmt->setUInt32(index++, columns.deathExpireTime);
+            stmt->setString(index++, columns.taxiPath);
+            stmt->setUInt32(index++, columns.arenaPoints);
+            stmt->setUInt32(index++, columns.honorPoints);
+            stmt->setUInt32(index++, columns.todayContribution);
+            stmt->setUInt32(index++, columns.yesterdayContribution);
+            stmt->setUInt32(index++, columns.lifetimeHonorableKills);
+            stmt->setUInt16(index++, columns.todayKills);
+            stmt->setUInt16(index++, columns.yesterdayKills);
+            stmt->setUInt32(index++, columns.chosenTitle);
+            stmt->setUInt32(index++, columns.watchedFaction);
+            stmt->setUInt8(index++, columns.drunk);
+            stmt->setString(index++, columns.exploredZones);
+            stmt->setString(index++, columns.equipmentCache);
+            stmt->setUInt32(index++, columns.ammoId);
+            stmt->setString(index++, columns.knownTitles);
+            stmt->setUInt8(index++, columns.actionBars);
+            stmt->setUInt8(index++, columns.xpBlocked);
+            m_saveState.character = std::move(columns);
         }
-#endif
-        stmt->setString(index++, ss.str());
-        stmt->setUInt32(index++, GetUInt32Value(PLAYER_AMMO_ID));
-
-        ss.str("");
-#ifdef LICH_KING
-        for (uint32 i = 0; i < KNOWN_TITLES_SIZE * 2; ++i)
-            ss << GetUInt32Value(PLAYER__FIELD_KNOWN_TITLES + i) << ' ';
-#else
-        for (uint32 i = 0; i < 2; ++i)
-            ss << GetUInt32Value(PLAYER_FIELD_KNOWN_TITLES + i) << " ";
-#endif
+        else
+            ++m_saveStats.partialCharacterRows;
 
-        stmt->setString(index++, ss.str());
-        stmt->setUInt8(index++, GetByteValue(PLAYER_FIELD_BYTES, PLAYER_FIELD_BYTES_OFFSET_ACTION_BAR_TOGGLES));
-        stmt->setUInt8(index++, m_isXpBlocked);
-        stmt->setUInt8(index++, IsInWorld() && !GetSession()->PlayerLogout() ? 1 : 0);
         stmt->setUInt32(index++, GetGUID().GetCounter());
     }
 
     trans->Append(stmt);
+    ++m_saveStats.rowsWritten;
+    ++m_saveStats.saves;
+    if (!m_saveState.valid)
+        ++m_saveStats.fullSaves;
 
     if(m_mailsUpdated)                                     //save mails only when needed
         _SaveMail(trans);
@@ -17452,9 +17517,19 @@ void Player::SaveToDB(bool create /*=false*/)
 
     CharacterDatabase.CommitTransaction(trans);
 
+    // every row was written, the next saves only write what changed
+    if (!create && IsInWorld() && !GetSession()->PlayerLogout() && differential)
+        m_saveState.valid = true;
+
+    sMonitor->AddPlayerSaveStats(m_saveStats);
+    PlayerSaveStats const stats = m_saveStats;
+    m_saveStats = PlayerSaveStats();
+
     // save pet (hunter pet level and experience and all type pets health/mana).
     if(Pet* pet = GetPet())
         pet->SavePetToDB(PET_SAVE_AS_CURRENT);
+
+    return stats;
 }
 
 // fast save function for item/money cheating preventing - save only inventory and money state
@@ -17500,10 +17575,17 @@ void Player::_SaveActions(SQLTransaction trans)
 
 void Player::_SaveAuras(SQLTransaction trans)
 {
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
-    stmt->setUInt32(0, GetGUID().GetCounter());
-    trans->Append(stmt);
+    PreparedStatement* stmt;
+    bool const full = !m_saveState.valid;
+    if (full)
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
+        stmt->setUInt32(0, GetGUID().GetCounter());
+        trans->Append(stmt);
+        m_saveState.auras.clear();
+    }
 
+    std::map<PlayerSaveState::AuraKey, PlayerSavedAura> savedAuras;
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
         if (!itr->second->CanBeSaved())
@@ -17511,70 +17593,119 @@ void Player::_SaveAuras(SQLTransaction trans)
 
         Aura* aura = itr->second;
 
-        int32 damage[MAX_SPELL_EFFECTS];
-        int32 baseDamage[MAX_SPELL_EFFECTS];
+        PlayerSavedAura row;
         uint8 effMask = 0;
-        uint8 recalculateMask = 0;
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
             if (AuraEffect const* effect = aura->GetEffect(i))
             {
-                baseDamage[i] = effect->GetBaseAmount();
-                damage[i] = effect->GetAmount();
+                row.baseAmount[i] = effect->GetBaseAmount();
+                row.amount[i] = effect->GetAmount();
                 effMask |= 1 << i;
                 if (effect->CanBeRecalculated())
-                    recalculateMask |= 1 << i;
-            }
-            else
-            {
-                baseDamage[i] = 0;
-                damage[i] = 0;
+                    row.recalculateMask |= 1 << i;
             }
         }
+        row.castItemGuid = aura->GetCastItemGUID().GetRawValue();
+        row.stackAmount = aura->GetStackAmount();
+        row.maxDuration = aura->GetMaxDuration();
+        row.duration = aura->GetDuration();
+        row.charges = aura->GetCharges();
+        row.critChance = aura->GetCritChance();
+        row.applyResilience = aura->CanApplyResilience();
+
+        PlayerSaveState::AuraKey const key(aura->GetCasterGUID().GetRawValue(), aura->GetId(), effMask);
+        auto saved = m_saveState.auras.find(key);
+        bool const unchanged = saved != m_saveState.auras.end() && saved->second == row;
+        if (saved != m_saveState.auras.end())
+            m_saveState.auras.erase(saved);
+
+        if (unchanged)
+        {
+            ++m_saveStats.rowsSkipped;
+            savedAuras.emplace(key, row);
+            continue;
+        }
 
         uint8 index = 0;
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_AURA);
+        stmt = CharacterDatabase.GetPreparedStatement(full ? CHAR_INS_AURA : CHAR_REP_AURA);
         stmt->setUInt32(index++, GetGUID().GetCounter());
-        stmt->setUInt64(index++, itr->second->GetCasterGUID().GetRawValue());
-        stmt->setUInt64(index++, itr->second->GetCastItemGUID().GetRawValue());
-        stmt->setUInt32(index++, itr->second->GetId());
+        stmt->setUInt64(index++, std::get<0>(key));
+        stmt->setUInt64(index++, row.castItemGuid);
+        stmt->setUInt32(index++, std::get<1>(key));
         stmt->setUInt8(index++, effMask);
-        stmt->setUInt8(index++, recalculateMask);
-        stmt->setUInt8(index++, itr->second->GetStackAmount());
-        stmt->setInt32(index++, damage[0]);
-        stmt->setInt32(index++, damage[1]);
-        stmt->setInt32(index++, damage[2]);
-        stmt->setInt32(index++, baseDamage[0]);
-        stmt->setInt32(index++, baseDamage[1]);
-        stmt->setInt32(index++, baseDamage[2]);
-        stmt->setInt32(index++, itr->second->GetMaxDuration());
-        stmt->setInt32(index++, itr->second->GetDuration());
-        stmt->setUInt8(index++, itr->second->GetCharges());
-        stmt->setFloat(index++, itr->second->GetCritChance());
-        stmt->setBool(index++, itr->second->CanApplyResilience());
+        stmt->setUInt8(index++, row.recalculateMask);
+        stmt->setUInt8(index++, row.stackAmount);
+        stmt->setInt32(index++, row.amount[0]);
+        stmt->setInt32(index++, row.amount[1]);
+        stmt->setInt32(index++, row.amount[2]);
+        stmt->setInt32(index++, row.baseAmount[0]);
+        stmt->setInt32(index++, row.baseAmount[1]);
+        stmt->setInt32(index++, row.baseAmount[2]);
+        stmt->setInt32(index++, row.maxDuration);
+        stmt->setInt32(index++, row.duration);
+        stmt->setUInt8(index++, row.charges);
+        stmt->setFloat(index++, row.critChance);
+        stmt->setBool(index++, row.applyResilience);
+        trans->Append(stmt);
+        ++m_saveStats.rowsWritten;
+        savedAuras.emplace(key, row);
+    }
+
+    // saved auras which are gone
+    for (auto const& itr : m_saveState.auras)
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA_BY_KEY);
+        stmt->setUInt32(0, GetGUID().GetCounter());
+        stmt->setUInt64(1, std::get<0>(itr.first));
+        stmt->setUInt32(2, std::get<1>(itr.first));
+        stmt->setUInt8(3, std::get<2>(itr.first));
         trans->Append(stmt);
+        ++m_saveStats.rowsWritten;
     }
+
+    m_saveState.auras.swap(savedAuras);
 }
 
 void Player::_SaveBGData(SQLTransaction& trans)
 {
+    PlayerSavedBGData bgData;
+    bgData.instanceId = m_bgData.bgInstanceID;
+    bgData.team = m_bgData.bgTeam;
+    bgData.joinPos[0] = m_bgData.joinPos.GetPositionX();
+    bgData.joinPos[1] = m_bgData.joinPos.GetPositionY();
+    bgData.joinPos[2] = m_bgData.joinPos.GetPositionZ();
+    bgData.joinPos[3] = m_bgData.joinPos.GetOrientation();
+    bgData.joinMapId = m_bgData.joinPos.GetMapId();
+    bgData.taxiPath[0] = m_bgData.taxiPath[0];
+    bgData.taxiPath[1] = m_bgData.taxiPath[1];
+    bgData.mountSpell = m_bgData.mountSpell;
+
+    if (m_saveState.valid && bgData == m_saveState.bgData)
+    {
+        ++m_saveStats.rowsSkipped;
+        return;
+    }
+
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYER_BGDATA);
     stmt->setUInt32(0, GetGUID().GetCounter());
     trans->Append(stmt);
     /* guid, bgInstanceID, bgTeam, x, y, z, o, map, taxi[0], taxi[1], mountSpell */
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_PLAYER_BGDATA);
     stmt->setUInt32(0, GetGUID().GetCounter());
-    stmt->setUInt32(1, m_bgData.bgInstanceID);
-    stmt->setUInt16(2, m_bgData.bgTeam);
-    stmt->setFloat(3, m_bgData.joinPos.GetPositionX());
-    stmt->setFloat(4, m_bgData.joinPos.GetPositionY());
-    stmt->setFloat(5, m_bgData.joinPos.GetPositionZ());
-    stmt->setFloat(6, m_bgData.joinPos.GetOrientation());
-    stmt->setUInt16(7, m_bgData.joinPos.GetMapId());
-    stmt->setUInt16(8, m_bgData.taxiPath[0]);
-    stmt->setUInt16(9, m_bgData.taxiPath[1]);
-    stmt->setUInt16(10, m_bgData.mountSpell);
+    stmt->setUInt32(1, bgData.instanceId);
+    stmt->setUInt16(2, bgData.team);
+    stmt->setFloat(3, bgData.joinPos[0]);
+    stmt->setFloat(4, bgData.joinPos[1]);
+    stmt->setFloat(5, bgData.joinPos[2]);
+    stmt->setFloat(6, bgData.joinPos[3]);
+    stmt->setUInt16(7, bgData.joinMapId);
+    stmt->setUInt16(8, bgData.taxiPath[0]);
+    stmt->setUInt16(9, bgData.taxiPath[1]);
+    stmt->setUInt16(10, bgData.mountSpell);
     trans->Append(stmt);
+    ++m_saveStats.rowsWritten;
+    m_saveState.bgData = bgData;
 }
 
 void Player::_SaveInventory(SQLTransaction trans)
@@ -17618,6 +17749,23 @@ void Player::_SaveInventory(SQLTransaction trans)
         itr.item->SetEnchantmentDuration(itr.slot,itr.leftduration);
     }
 
+    // inventory rows of the items not in the update queue are left as they are
+    uint64 items = 0;
+    for (uint8 i = 0; i < PLAYER_SLOTS_COUNT; ++i)
+    {
+        if (!m_items[i])
+            continue;
+
+        ++items;
+        if (Bag const* bag = m_items[i]->ToBag())
+            for (uint32 j = 0; j < bag->GetBagSize(); ++j)
+                if (bag->GetItemByPos(j))
+                    ++items;
+    }
+    uint64 const written = std::count_if(m_itemUpdateQueue.begin(), m_itemUpdateQueue.end(), [](Item const* item) { return item && item->GetState() != ITEM_UNCHANGED; });
+    m_saveStats.rowsWritten += written;
+    m_saveStats.rowsSkipped += items > written ? items - written : 0;
+
     // if no changes
     if (m_itemUpdateQueue.empty()) return;
 
@@ -17762,6 +17910,10 @@ void Player::_SaveQuestStatus(SQLTransaction& trans)
 
     bool keepAbandoned = true; //TC!(sWorld->GetCleaningFlags() & CharacterDatabaseCleaner::CLEANING_FLAG_QUESTSTATUS);
 
+    // statuses and rewarded quests not in the save maps are left as they are
+    uint64 const tracked = m_QuestStatus.size() + m_RewardedQuests.size();
+    uint64 written = 0;
+
     for (saveItr = m_QuestStatusSave.begin(); saveItr != m_QuestStatusSave.end(); ++saveItr)
     {
         if (saveItr->second == QUEST_DEFAULT_SAVE_TYPE)
@@ -17786,6 +17938,7 @@ void Player::_SaveQuestStatus(SQLTransaction& trans)
 
                 stmt->setUInt16(index, statusItr->second.PlayerCount);
                 trans->Append(stmt);
+                ++written;
             }
         }
         else
@@ -17794,6 +17947,7 @@ void Player::_SaveQuestStatus(SQLTransaction& trans)
             stmt->setUInt32(0, GetGUID().GetCounter());
             stmt->setUInt32(1, saveItr->first);
             trans->Append(stmt);
+            ++written;
         }
     }
 
@@ -17807,6 +17961,7 @@ void Player::_SaveQuestStatus(SQLTransaction& trans)
             stmt->setUInt32(0, GetGUID().GetCounter());
             stmt->setUInt32(1, saveItr->first);
             trans->Append(stmt);
+            ++written;
 
         }
         else if (saveItr->second == QUEST_FORCE_DELETE_SAVE_TYPE || !keepAbandoned)
@@ -17815,11 +17970,15 @@ void Player::_SaveQuestStatus(SQLTransaction& trans)
             stmt->setUInt32(0, GetGUID().GetCounter());
             stmt->setUInt32(1, saveItr->first);
             trans->Append(stmt);
+            ++written;
         }
     }
 
     m_RewardedQuestsSave.clear();
 
+    m_saveStats.rowsWritten += written;
+    m_saveStats.rowsSkipped += tracked > written ? tracked - written : 0;
+
     if (!isTransaction)
         CharacterDatabase.CommitTransaction(trans);
 }
@@ -17942,12 +18101,24 @@ void Player::_SaveSpells(SQLTransaction trans)
     for (PlayerSpellMap::const_iterator itr = m_spells.begin(), next = m_spells.begin(); itr != m_spells.end(); itr = next)
     {
         ++next;
+        if (itr->second->state == PLAYERSPELL_UNCHANGED)
+        {
+            ++m_saveStats.rowsSkipped;
+            continue;
+        }
+
         if (itr->second->state == PLAYERSPELL_REMOVED || itr->second->state == PLAYERSPELL_CHANGED)
+        {
             trans->PAppend("DELETE FROM character_spell WHERE guid = '%u' and spell = '%u'", GetGUID().GetCounter(), itr->first);
+            ++m_saveStats.rowsWritten;
+        }
 
         // add only changed/new not dependent spells
         if ((!itr->second->dependent && itr->second->state == PLAYERSPELL_NEW) || itr->second->state == PLAYERSPELL_CHANGED)
+        {
             trans->PAppend("INSERT INTO character_spell (guid,spell,active,disabled) VALUES ('%u','%u','%u','%u')", GetGUID().GetCounter(), itr->first, uint32(itr->second->active), uint32(itr->second->disabled));
+            ++m_saveStats.rowsWritten;
+        }
 
         if (itr->second->state == PLAYERSPELL_REMOVED)
             _removeSpell(itr->first);
@@ -20104,7 +20275,7 @@ void Player::UpdateVisibilityOf(WorldObject* target)
 {
     if(HaveAtClient(target))
     {
-        if (!CanSeeOrDetect(target, false, true))
+        if (!CanSeeOrDetect(target, false, true, false, World::GetVisibilityHysteresis()))
         {
             if (target->GetTypeId() == TYPEID_UNIT)
                 BeforeVisibilityDestroy<Creature>(target->ToCreature(), this);
@@ -20168,7 +20339,7 @@ void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::set<Unit*>& vi
 
     if(HaveAtClient(target))
     {
-        if (!CanSeeOrDetect(target, false, true))
+        if (!CanSeeOrDetect(target, false, true, false, World::GetVisibilityHysteresis()))
         {
             BeforeVisibilityDestroy<T>(target, this);
 
@@ -20199,7 +20370,10 @@ template void Player::UpdateVisibilityOf(DynamicObject* target, UpdateData& data
 void Player::UpdateObjectVisibility(bool forced)
 {
     if (!forced)
+    {
+        m_fullVisibilityUpdate = true;
         AddToNotify(NOTIFY_VISIBILITY_CHANGED);
+    }
     else
     {
         Unit::UpdateObjectVisibility(true);
@@ -20207,11 +20381,17 @@ void Player::UpdateObjectVisibility(bool forced)
     }
 }
 
+void Player::UpdateObjectVisibilityOnRelocation()
+{
+    AddToNotify(NOTIFY_VISIBILITY_CHANGED);
+}
+
 void Player::UpdateVisibilityForPlayer()
 {
     // updates visibility of all objects around point of view for current player
+    // objects up to the hysteresis distance must be visited too, or they would be removed from client
     Trinity::VisibleNotifier notifier(*this);
-    Cell::VisitAllObjects(m_seer, notifier, GetSightRange());
+    Cell::VisitAllObjects(m_seer, notifier, GetSightRange() + World::GetVisibilityHysteresis());
     notifier.SendToSelf();   // send gathered data
 }
 
@@ -23791,6 +23971,7 @@ void Player::SetInGuild(uint32 guildId)
 {
     SetUInt32Value(PLAYER_GUILDID, guildId);
     sCharacterCache->UpdateCharacterGuildId(GetGUID(), guildId);
+    sWhoListStorageMgr->MarkDirty(GetGUID());
 }
 
 void Player::SetRank(uint32 rankId)
@@ -14,9 +14,11 @@
 #include "Util.h"                                           // for Tokens typedef
 #include "SpellMgr.h"
 #include "PlayerTaxi.h"
+#include "PlayerSaveState.h"
 
 #include<string>
 #include<vector>
+#include <atomic>
 #include <memory>
 
 struct Mail;
@@ -1024,11 +1026,15 @@ class LoginQueryHolder : public SQLQueryHolder
 private:
     uint32 m_accountId;
     ObjectGuid m_guid;
+    uint32 m_queueTime;
 public:
     LoginQueryHolder(uint32 accountId, ObjectGuid guid)
-        : m_accountId(accountId), m_guid(guid) { }
+        : m_accountId(accountId), m_guid(guid), m_queueTime(0) { }
     ObjectGuid GetGuid() const { return m_guid; }
     uint32 GetAccountId() const { return m_accountId; }
+    // Time (GetMSTime) at which the login was queued in sLoginQueryBatcher, 0 if not queued
+    uint32 GetQueueTime() const { return m_queueTime; }
+    void SetQueueTime(uint32 time) { m_queueTime = time; }
     bool Initialize();
 };
 
@@ -1078,6 +1084,7 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
 {
     friend class WorldSession;
     friend class Spell;
+    friend class TestPlayer;
     friend void Item::AddItemToUpdateQueueOf(Player *player);
     friend void Item::RemoveItemFromUpdateQueueOf(Player *player);
     public:
@@ -2238,6 +2245,10 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
 
         void SendInitialVisiblePackets(Unit* target);
 		void UpdateObjectVisibility(bool forced = true) override;
+		// visibility update after a move of the player only, see PlayerRelocationNotifier
+		void UpdateObjectVisibilityOnRelocation();
+		bool NeedsFullVisibilityUpdate() const { return m_fullVisibilityUpdate; }
+		void SetFullVisibilityUpdated() { m_fullVisibilityUpdate = false; }
 		void UpdateVisibilityForPlayer();
 		void UpdateVisibilityOf(WorldObject* target);
 		void UpdateTriggerVisibility();
@@ -2471,6 +2482,8 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
         /***                   SAVE SYSTEM                     ***/
         /*********************************************************/
 
+        // SaveToDB, with differential saves or not whatever the config. Returns the rows written and skipped by the save
+        PlayerSaveStats _SaveToDB(bool create, bool differential);
         void _SaveActions(SQLTransaction trans);
         void _SaveAuras(SQLTransaction trans);
         void _SaveInventory(SQLTransaction trans);
@@ -2632,6 +2645,8 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
 
         // Temporarily removed pet cache
         uint32 m_temporaryUnsummonedPetNumber;
+        // something else than the player position changed since the last relocation notify
+        bool m_fullVisibilityUpdate;
         uint32 m_oldpetspell;
 
         uint32 _activeCheats; //mask from PlayerCommandStates
@@ -2708,6 +2723,11 @@ class TC_GAME_API Player : public Unit, public GridObject<Player>
 
 		WorldLocation _corpseLocation;
 
+        // What was last written to the characters, auras and bg data rows, to only save what changed since
+        PlayerSaveState m_saveState;
+        PlayerSaveStats m_saveStats;
+        std::shared_ptr<std::atomic<bool>> m_saveFailed;    // set by the database workers when a save transaction fails
+
     public:
         bool m_kickatnextupdate;
 };
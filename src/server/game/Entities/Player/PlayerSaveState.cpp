@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2008-2019 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PlayerSaveState.h"
+#include <cstring>
+
+void PlayerSaveStats::Add(PlayerSaveStats const& other)
+{
+    saves += other.saves;
+    fullSaves += other.fullSaves;
+    rowsWritten += other.rowsWritten;
+    rowsSkipped += other.rowsSkipped;
+    partialCharacterRows += other.partialCharacterRows;
+}
+
+bool PlayerSavedCharacterColumns::operator==(PlayerSavedCharacterColumns const& other) const
+{
+    return std::tie(race, class_, gender, playerBytes, playerBytes2, cinematic, resetTalentsCost, resetTalentsTime, extraFlags, stableSlots,
+            atLoginFlags, deathExpireTime, arenaPoints, honorPoints, todayContribution, yesterdayContribution, lifetimeHonorableKills,
+            todayKills, yesterdayKills, chosenTitle, watchedFaction, drunk, ammoId, actionBars, xpBlocked)
+        == std::tie(other.race, other.class_, other.gender, other.playerBytes, other.playerBytes2, other.cinematic, other.resetTalentsCost,
+            other.resetTalentsTime, other.extraFlags, other.stableSlots, other.atLoginFlags, other.deathExpireTime, other.arenaPoints,
+            other.honorPoints, other.todayContribution, other.yesterdayContribution, other.lifetimeHonorableKills, other.todayKills,
+            other.yesterdayKills, other.chosenTitle, other.watchedFaction, other.drunk, other.ammoId, other.actionBars, other.xpBlocked)
+        && name == other.name && taxiMask == other.taxiMask && taxiPath == other.taxiPath && exploredZones == other.exploredZones
+        && equipmentCache == other.equipmentCache && knownTitles == other.knownTitles;
+}
+
+bool PlayerSavedAura::operator==(PlayerSavedAura const& other) const
+{
+    // floats are compared bitwise, the saved value is what matters
+    return castItemGuid == other.castItemGuid && recalculateMask == other.recalculateMask && stackAmount == other.stackAmount
+        && !memcmp(amount, other.amount, sizeof(amount)) && !memcmp(baseAmount, other.baseAmount, sizeof(baseAmount))
+        && maxDuration == other.maxDuration && duration == other.duration && charges == other.charges
+        && !memcmp(&critChance, &other.critChance, sizeof(critChance)) && applyResilience == other.applyResilience;
+}
+
+bool PlayerSavedBGData::operator==(PlayerSavedBGData const& other) const
+{
+    return instanceId == other.instanceId && team == other.team && !memcmp(joinPos, other.joinPos, sizeof(joinPos))
+        && joinMapId == other.joinMapId && taxiPath[0] == other.taxiPath[0] && taxiPath[1] == other.taxiPath[1]
+        && mountSpell == other.mountSpell;
+}
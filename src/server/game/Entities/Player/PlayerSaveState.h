@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2008-2019 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PlayerSaveState_h__
+#define PlayerSaveState_h__
+
+#include "Define.h"
+#include <map>
+#include <string>
+#include <tuple>
+
+// Character rows written and skipped by saves, since startup
+struct PlayerSaveStats
+{
+    uint64 saves = 0;
+    uint64 fullSaves = 0;                   // saves writing every row (first save of a session, logout, differential saves disabled)
+    uint64 rowsWritten = 0;                 // rows inserted, replaced, updated or deleted
+    uint64 rowsSkipped = 0;                 // rows left as they were since the last save
+    uint64 partialCharacterRows = 0;        // characters rows updated without their rarely changing columns
+
+    void Add(PlayerSaveStats const& other);
+};
+
+// characters columns which rarely change, the full row is only updated when one of them changed
+struct PlayerSavedCharacterColumns
+{
+    std::string name;
+    uint8 race = 0;
+    uint8 class_ = 0;
+    uint8 gender = 0;
+    uint32 playerBytes = 0;
+    uint32 playerBytes2 = 0;
+    std::string taxiMask;
+    uint8 cinematic = 0;
+    uint32 resetTalentsCost = 0;
+    uint32 resetTalentsTime = 0;
+    uint16 extraFlags = 0;
+    uint8 stableSlots = 0;
+    uint16 atLoginFlags = 0;
+    uint32 deathExpireTime = 0;
+    std::string taxiPath;
+    uint32 arenaPoints = 0;
+    uint32 honorPoints = 0;
+    uint32 todayContribution = 0;
+    uint32 yesterdayContribution = 0;
+    uint32 lifetimeHonorableKills = 0;
+    uint16 todayKills = 0;
+    uint16 yesterdayKills = 0;
+    uint32 chosenTitle = 0;
+    uint32 watchedFaction = 0;
+    uint8 drunk = 0;
+    std::string exploredZones;
+    std::string equipmentCache;
+    uint32 ammoId = 0;
+    std::string knownTitles;
+    uint8 actionBars = 0;
+    uint8 xpBlocked = 0;
+
+    bool operator==(PlayerSavedCharacterColumns const& other) const;
+    bool operator!=(PlayerSavedCharacterColumns const& other) const { return !(*this == other); }
+};
+
+// character_aura row, without its key
+struct PlayerSavedAura
+{
+    uint64 castItemGuid = 0;
+    uint8 recalculateMask = 0;
+    uint8 stackAmount = 0;
+    int32 amount[3] = { };
+    int32 baseAmount[3] = { };
+    int32 maxDuration = 0;
+    int32 duration = 0;
+    uint8 charges = 0;
+    float critChance = 0.0f;
+    bool applyResilience = false;
+
+    bool operator==(PlayerSavedAura const& other) const;
+    bool operator!=(PlayerSavedAura const& other) const { return !(*this == other); }
+};
+
+// character_battleground_data row, without its key
+struct PlayerSavedBGData
+{
+    uint32 instanceId = 0;
+    uint16 team = 0;
+    float joinPos[4] = { };
+    uint16 joinMapId = 0;
+    uint16 taxiPath[2] = { };
+    uint16 mountSpell = 0;
+
+    bool operator==(PlayerSavedBGData const& other) const;
+    bool operator!=(PlayerSavedBGData const& other) const { return !(*this == other); }
+};
+
+/* Rows as written by the last save of the player, the following saves only write the rows (and for
+   the characters row, the columns) which differ. Only valid once a save wrote every row: the first save
+   of a session writes everything, and so does the logout save, so that rows changed outside of the
+   saves are never kept beyond the session. A failed save transaction invalidates the state, the next
+   save writes every row again. */
+struct PlayerSaveState
+{
+    typedef std::tuple<uint64, uint32, uint8> AuraKey;     // casterGuid, spell, effectMask
+
+    bool valid = false;
+    PlayerSavedCharacterColumns character;
+    std::map<AuraKey, PlayerSavedAura> auras;
+    PlayerSavedBGData bgData;
+
+    void Invalidate()
+    {
+        valid = false;
+        auras.clear();
+    }
+};
+
+#endif // PlayerSaveState_h__
@@ -27,6 +27,7 @@
 #include "ObjectMgr.h"
 #include "World.h"
 #include "Util.h"
+#include <algorithm>
 
 PlayerSocial::PlayerSocial()
 {
@@ -78,6 +79,9 @@ bool PlayerSocial::AddToSocialList(ObjectGuid::LowType friend_guid, bool _ignore
     if (_mute)
         flag = SOCIAL_FLAG_MUTED;
 
+    if (flag == SOCIAL_FLAG_IGNORED)
+        sSocialMgr->AddIgnore(GetPlayerGUID(), friend_guid);
+
     auto itr = m_playerSocialMap.find(friend_guid);
     if(itr != m_playerSocialMap.end())
     {
@@ -110,6 +114,9 @@ void PlayerSocial::RemoveFromSocialList(ObjectGuid::LowType friend_guid, bool _i
     if (_mute)
         flag = SOCIAL_FLAG_MUTED;
 
+    if (flag == SOCIAL_FLAG_IGNORED)
+        sSocialMgr->RemoveIgnore(GetPlayerGUID(), friend_guid);
+
     itr->second.Flags &= ~flag;
     if(itr->second.Flags == 0)
     {
@@ -199,7 +206,48 @@ void SocialMgr::RemovePlayerSocial(ObjectGuid::LowType guid)
 {
     auto itr = m_socialMap.find(guid);
     if(itr != m_socialMap.end())
+    {
+        for (auto const& social : itr->second.m_playerSocialMap)
+            if (social.second.Flags & SOCIAL_FLAG_IGNORED)
+                RemoveIgnore(guid, social.first);
+
         m_socialMap.erase(itr);
+    }
+}
+
+std::vector<ObjectGuid::LowType> SocialMgr::GetIgnoringPlayers(ObjectGuid::LowType guid) const
+{
+    std::lock_guard<std::mutex> lock(m_ignoredByLock);
+    auto itr = m_ignoredBy.find(guid);
+    if (itr == m_ignoredBy.end())
+        return std::vector<ObjectGuid::LowType>();
+
+    return itr->second;
+}
+
+void SocialMgr::AddIgnore(ObjectGuid::LowType player, ObjectGuid::LowType ignored)
+{
+    std::lock_guard<std::mutex> lock(m_ignoredByLock);
+    std::vector<ObjectGuid::LowType>& players = m_ignoredBy[ignored];
+    auto itr = std::lower_bound(players.begin(), players.end(), player);
+    if (itr == players.end() || *itr != player)
+        players.insert(itr, player);
+}
+
+void SocialMgr::RemoveIgnore(ObjectGuid::LowType player, ObjectGuid::LowType ignored)
+{
+    std::lock_guard<std::mutex> lock(m_ignoredByLock);
+    auto mapItr = m_ignoredBy.find(ignored);
+    if (mapItr == m_ignoredBy.end())
+        return;
+
+    std::vector<ObjectGuid::LowType>& players = mapItr->second;
+    auto itr = std::lower_bound(players.begin(), players.end(), player);
+    if (itr != players.end() && *itr == player)
+        players.erase(itr);
+
+    if (players.empty())
+        m_ignoredBy.erase(mapItr);
 }
 
 void SocialMgr::GetFriendInfo(Player *player, ObjectGuid::LowType friendGUID, FriendInfo &friendInfo)
@@ -340,6 +388,8 @@ PlayerSocial* SocialMgr::LoadFromDB(PreparedQueryResult result, ObjectGuid::LowT
         note = fields[2].GetString();
 
         social->m_playerSocialMap[friend_guid] = FriendInfo(flags, note);
+        if (flags & SOCIAL_FLAG_IGNORED)
+            AddIgnore(guid, friend_guid);
 
         // client's friends list and ignore list limit
         if(social->m_playerSocialMap.size() >= (SOCIALMGR_FRIEND_LIMIT + SOCIALMGR_IGNORE_LIMIT))
@@ -6,6 +6,9 @@
 #include "Common.h"
 #include "ObjectGuid.h"
 #include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 class SocialMgr;
 class PlayerSocial;
@@ -145,8 +148,20 @@ class TC_GAME_API SocialMgr
         // Loading
         PlayerSocial* LoadFromDB(PreparedQueryResult result, ObjectGuid::LowType guid);
         PlayerSocial* GetDefault(ObjectGuid::LowType guid);
+
+        // Loaded players having the given player in their ignore list, sorted by guid
+        std::vector<ObjectGuid::LowType> GetIgnoringPlayers(ObjectGuid::LowType guid) const;
     private:
+        friend class PlayerSocial;
+        void AddIgnore(ObjectGuid::LowType player, ObjectGuid::LowType ignored);
+        void RemoveIgnore(ObjectGuid::LowType player, ObjectGuid::LowType ignored);
+
         SocialMap m_socialMap;
+
+        // reverse of the ignore lists of loaded players: ignored player => players ignoring him
+        typedef std::unordered_map<ObjectGuid::LowType, std::vector<ObjectGuid::LowType>> IgnoredByMap;
+        IgnoredByMap m_ignoredBy;
+        mutable std::mutex m_ignoredByLock;
 };
 
 #define sSocialMgr SocialMgr::instance()
@@ -52,6 +52,7 @@
 #include "MoveSplineInit.h"
 #include "UnitAI.h"
 #include "SmartAI.h"
+#include "WhoListStorage.h"
 
 #include <math.h>
 #include <array>
@@ -7549,6 +7550,9 @@ void Unit::SetVisible(bool x)
     else
         m_serverSideVisibility.SetValue(SERVERSIDE_VISIBILITY_GM, SEC_PLAYER);
 
+    if (GetTypeId() == TYPEID_PLAYER)
+        sWhoListStorageMgr->MarkDirty(GetGUID());
+
     UpdateObjectVisibility();
 }
 
@@ -8396,7 +8400,10 @@ void Unit::SetLevel(uint32 lvl)
         (this->ToPlayer())->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_LEVEL);
 
     if (GetTypeId() == TYPEID_PLAYER)
+    {
         sCharacterCache->UpdateCharacterLevel(ToPlayer()->GetGUID().GetCounter(), lvl);
+        sWhoListStorageMgr->MarkDirty(GetGUID());
+    }
 }
 
 void Unit::SetHealth(uint32 val)
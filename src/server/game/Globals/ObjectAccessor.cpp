@@ -22,10 +22,238 @@
 #include "MapInstanced.h"
 #include "World.h"
 #include "Transport.h"
+#include <atomic>
 #include <cmath>
+#include <limits>
 #include <boost/thread/shared_mutex.hpp>
 #include <boost/thread/locks.hpp>
 
+namespace
+{
+    /*
+    Epochs of the threads reading the player lookup tables. For the duration of a lookup, a reader
+    publishes in the slot of its thread the epoch it started at. Every replaced map advances the
+    epoch and is retired at the epoch it was current in, it is freed once no reader started at or
+    before this epoch is still reading. Threads without a slot left read under the write lock.
+    */
+    class PlayerLookupReaders
+    {
+        struct Slot;
+
+    public:
+        static constexpr uint64 IDLE = std::numeric_limits<uint64>::max();
+        static constexpr uint32 MAX_READERS = 256;
+
+        class Guard
+        {
+        public:
+            explicit Guard(PlayerLookupReaders& readers) : _slot(readers.GetSlot())
+            {
+                if (_slot)
+                    _slot->epoch.store(readers._epoch.load());
+            }
+
+            ~Guard()
+            {
+                if (_slot)
+                    _slot->epoch.store(IDLE);
+            }
+
+            bool IsRegistered() const { return _slot != nullptr; }
+
+        private:
+            Slot* _slot;
+        };
+
+        PlayerLookupReaders() : _epoch(0) { }
+
+        /// Returns the epoch the map just replaced was current in, readers starting later cannot see it
+        uint64 Advance() { return _epoch.fetch_add(1); }
+
+        /// Oldest epoch a reader started at, IDLE if none is reading
+        uint64 GetOldestReader() const
+        {
+            uint64 oldest = IDLE;
+            for (Slot const& slot : _slots)
+                oldest = std::min(oldest, slot.epoch.load());
+            return oldest;
+        }
+
+    private:
+        struct Slot
+        {
+            std::atomic<uint64> epoch { IDLE };
+            std::atomic<bool> used { false };
+        };
+
+        // Slot of the calling thread, taken at its first lookup and released when it exits
+        struct SlotOwner
+        {
+            explicit SlotOwner(PlayerLookupReaders& readers) : slot(nullptr)
+            {
+                for (Slot& candidate : readers._slots)
+                {
+                    bool expected = false;
+                    if (candidate.used.compare_exchange_strong(expected, true))
+                    {
+                        slot = &candidate;
+                        break;
+                    }
+                }
+            }
+
+            ~SlotOwner()
+            {
+                if (slot)
+                    slot->used.store(false);
+            }
+
+            Slot* slot;
+        };
+
+        Slot* GetSlot()
+        {
+            thread_local SlotOwner owner(*this);
+            return owner.slot;
+        }
+
+        std::atomic<uint64> _epoch;
+        Slot _slots[MAX_READERS];
+    };
+
+    PlayerLookupReaders& GetPlayerLookupReaders()
+    {
+        static PlayerLookupReaders readers;
+        return readers;
+    }
+
+    /*
+    Player lookup table read without any lock, in read-copy-update fashion.
+    The table is split in shards, each one an immutable map published through an atomic pointer.
+    Writers copy the shard they change and publish the copy, the replaced map is freed by
+    Reclaim once every reader which could have loaded it is done, see PlayerLookupReaders.
+    */
+    template<class Key, class Hash = std::hash<Key>>
+    class PlayerLookupTable
+    {
+        static constexpr uint32 SHARD_COUNT = 64;
+        typedef std::unordered_map<Key, Player*, Hash> Shard;
+
+    public:
+        PlayerLookupTable()
+        {
+            for (std::atomic<Shard const*>& shard : _shards)
+                shard.store(new Shard(), std::memory_order_relaxed);
+        }
+
+        ~PlayerLookupTable()
+        {
+            for (std::atomic<Shard const*>& shard : _shards)
+                delete shard.load(std::memory_order_relaxed);
+            for (auto const& retired : _retired)
+                delete retired.second;
+        }
+
+        Player* Find(Key const& key) const
+        {
+            PlayerLookupReaders::Guard guard(GetPlayerLookupReaders());
+            if (!guard.IsRegistered())
+            {
+                std::lock_guard<std::mutex> lock(_writeLock);
+                return Find(*_shards[GetShardIndex(key)].load(), key);
+            }
+
+            return Find(*_shards[GetShardIndex(key)].load(), key);
+        }
+
+        void Insert(Key const& key, Player* player)
+        {
+            Modify(key, [&](Shard& shard) { shard[key] = player; });
+        }
+
+        void Remove(Key const& key)
+        {
+            Modify(key, [&](Shard& shard) { shard.erase(key); });
+        }
+
+        // Frees the replaced maps no reader can be using anymore
+        void Reclaim()
+        {
+            std::lock_guard<std::mutex> lock(_writeLock);
+            if (_retired.empty())
+                return;
+
+            uint64 const oldestReader = GetPlayerLookupReaders().GetOldestReader();
+            auto itr = std::remove_if(_retired.begin(), _retired.end(), [oldestReader](std::pair<uint64, Shard const*> const& retired)
+            {
+                if (retired.first >= oldestReader)
+                    return false;
+
+                delete retired.second;
+                return true;
+            });
+            _retired.erase(itr, _retired.end());
+        }
+
+    private:
+        static Player* Find(Shard const& shard, Key const& key)
+        {
+            auto itr = shard.find(key);
+            return itr != shard.end() ? itr->second : nullptr;
+        }
+
+        uint32 GetShardIndex(Key const& key) const
+        {
+            return uint32(Hash()(key) % SHARD_COUNT);
+        }
+
+        template<class F>
+        void Modify(Key const& key, F&& modify)
+        {
+            std::lock_guard<std::mutex> lock(_writeLock);
+            std::atomic<Shard const*>& shard = _shards[GetShardIndex(key)];
+            Shard const* current = shard.load(std::memory_order_relaxed);
+            Shard* copy = new Shard(*current);
+            modify(*copy);
+            shard.store(copy);
+            _retired.emplace_back(GetPlayerLookupReaders().Advance(), current);
+        }
+
+        std::atomic<Shard const*> _shards[SHARD_COUNT];
+        mutable std::mutex _writeLock;
+        std::vector<std::pair<uint64 /*epoch*/, Shard const*>> _retired;
+    };
+
+    PlayerLookupTable<ObjectGuid>& GetPlayerGuidTable()
+    {
+        static PlayerLookupTable<ObjectGuid> table;
+        return table;
+    }
+
+    // Player names keyed by FoldPlayerName
+    PlayerLookupTable<std::string>& GetPlayerNameTable()
+    {
+        static PlayerLookupTable<std::string> table;
+        return table;
+    }
+
+    // Lower case ASCII letters, names differing only by the case of ASCII letters get the same key
+    // without going through normalizePlayerName. Other characters are kept as is.
+    std::string FoldPlayerName(std::string const& name, bool& ascii)
+    {
+        std::string folded(name);
+        ascii = true;
+        for (char& c : folded)
+        {
+            if (c >= 'A' && c <= 'Z')
+                c = char(c - 'A' + 'a');
+            else if (uint8(c) >= 0x80)
+                ascii = false;
+        }
+        return folded;
+    }
+}
+
 
 template<class T>
 void HashMapHolder<T>::Insert(T* o)
@@ -52,6 +280,31 @@ T* HashMapHolder<T>::Find(ObjectGuid guid)
     return (itr != GetContainer().end()) ? itr->second : NULL;
 }
 
+template<>
+void HashMapHolder<Player>::Insert(Player* o)
+{
+    boost::unique_lock<boost::shared_mutex> lock(*GetLock());
+
+    GetContainer()[o->GetGUID()] = o;
+    GetPlayerGuidTable().Insert(o->GetGUID(), o);
+}
+
+template<>
+void HashMapHolder<Player>::Remove(Player* o)
+{
+    boost::unique_lock<boost::shared_mutex> lock(*GetLock());
+
+    GetContainer().erase(o->GetGUID());
+    GetPlayerGuidTable().Remove(o->GetGUID());
+}
+
+// Lookups do not take the lock, see PlayerLookupTable
+template<>
+Player* HashMapHolder<Player>::Find(ObjectGuid guid)
+{
+    return GetPlayerGuidTable().Find(guid);
+}
+
 template<class T>
 auto HashMapHolder<T>::GetContainer() -> MapType&
 {
@@ -76,27 +329,33 @@ template class TC_GAME_API HashMapHolder<MotionTransport>;
 
 namespace PlayerNameMapHolder
 {
-    typedef std::unordered_map<std::string, Player*> MapType;
-    static MapType PlayerNameMap;
-
     void Insert(Player* p)
     {
-        PlayerNameMap[p->GetName()] = p;
+        bool ascii;
+        GetPlayerNameTable().Insert(FoldPlayerName(p->GetName(), ascii), p);
     }
 
     void Remove(Player* p)
     {
-        PlayerNameMap.erase(p->GetName());
+        bool ascii;
+        GetPlayerNameTable().Remove(FoldPlayerName(p->GetName(), ascii));
     }
 
     Player* Find(std::string const& name)
     {
+        bool ascii;
+        if (Player* player = GetPlayerNameTable().Find(FoldPlayerName(name, ascii)))
+            return player;
+
+        // case of non ASCII letters needs the full normalization
+        if (ascii)
+            return nullptr;
+
         std::string charName(name);
         if (!normalizePlayerName(charName))
             return nullptr;
 
-        auto itr = PlayerNameMap.find(charName);
-        return (itr != PlayerNameMap.end()) ? itr->second : nullptr;
+        return GetPlayerNameTable().Find(FoldPlayerName(charName, ascii));
     }
 } // namespace PlayerNameMapHolder
 
@@ -254,6 +513,12 @@ Player* ObjectAccessor::FindConnectedPlayerByName(std::string const& name)
     return PlayerNameMapHolder::Find(name);
 }
 
+void ObjectAccessor::ReclaimPlayerLookups()
+{
+    GetPlayerGuidTable().Reclaim();
+    GetPlayerNameTable().Reclaim();
+}
+
 void ObjectAccessor::SaveAllPlayers()
 {
     boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
@@ -47,6 +47,11 @@ public:
     static boost::shared_mutex* GetLock();
 };
 
+// Players are also stored in a lookup table read without the lock
+template<> TC_GAME_API void HashMapHolder<Player>::Insert(Player* o);
+template<> TC_GAME_API void HashMapHolder<Player>::Remove(Player* o);
+template<> TC_GAME_API Player* HashMapHolder<Player>::Find(ObjectGuid guid);
+
 namespace ObjectAccessor
 {
 		// these functions return objects only if in map of specified object
@@ -65,6 +70,7 @@ namespace ObjectAccessor
         
 		// these functions return objects if found in whole world
 		// ACCESS LIKE THAT IS NOT THREAD SAFE
+		// player lookups by guid or name do not lock, see ReclaimPlayerLookups
 		TC_GAME_API Player* FindPlayer(ObjectGuid const&);
 		/* Find a player in all connected players by name, thread-safe. */
 		TC_GAME_API Player* FindPlayerByName(std::string const& name);
@@ -99,6 +105,10 @@ namespace ObjectAccessor
 		template<>
 		void RemoveObject(Player* player);
 
+		/* Frees the replaced player lookup tables no lookup is still reading. Called by World once per tick,
+		   after the maps updates. */
+		TC_GAME_API void ReclaimPlayerLookups();
+
 		TC_GAME_API void SaveAllPlayers();
 
 		//void UpdateObjectVisibility(WorldObject *obj);
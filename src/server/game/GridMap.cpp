@@ -6,6 +6,13 @@
 #include "DBCStores.h"
 #include "Management/VMapFactory.h"
 #include "Management/MMapManager.h"
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GRIDMAP_SSE2
+#include <emmintrin.h>
+#endif
 
 u_map_magic MapMagic        = { {'M','A','P','S'} };
 u_map_magic MapVersionMagic = { {'v','1','.','8'} };
@@ -495,6 +502,98 @@ float GridMap::getHeightFromUint16(float x, float y, bool walkableOnly) const
     return (float)((a * x) + (b * y) + c)*_gridIntHeightMultiplier + _gridHeight;
 }
 
+void GridMap::getHeights(float const* x, float const* y, float* heights, uint32 count) const
+{
+    if (_gridGetHeight == &GridMap::getHeightFromFloat && m_V8 && m_V9)
+        getHeightsFromGrid<float>(m_V8, m_V9, 1.0f, 0.0f, x, y, heights, count);
+    else if (_gridGetHeight == &GridMap::getHeightFromUint16 && m_uint16_V8 && m_uint16_V9)
+        getHeightsFromGrid<uint16>(m_uint16_V8, m_uint16_V9, _gridIntHeightMultiplier, _gridHeight, x, y, heights, count);
+    else if (_gridGetHeight == &GridMap::getHeightFromUint8 && m_uint8_V8 && m_uint8_V9)
+        getHeightsFromGrid<uint8>(m_uint8_V8, m_uint8_V9, _gridIntHeightMultiplier, _gridHeight, x, y, heights, count);
+    else
+        std::fill(heights, heights + count, _gridHeight);
+}
+
+/* Evaluates four points per iteration: the cell coordinates and the triangle planes are computed
+in SSE registers, only the five height samples of each point are fetched one by one.
+The planes of the four triangles are computed for every point and the right one is selected with
+masks, which gives the same result as the branches of getHeightFromFloat/Uint16/Uint8. */
+template<typename T>
+void GridMap::getHeightsFromGrid(T const* v8, T const* v9, float multiplier, float offset, float const* x, float const* y, float* heights, uint32 count) const
+{
+    uint32 i = 0;
+#ifdef GRIDMAP_SSE2
+    __m128 const resolution = _mm_set1_ps(float(MAP_RESOLUTION));
+    __m128 const gridCenter = _mm_set1_ps(32.0f);
+    __m128 const gridSize = _mm_set1_ps(SIZE_OF_GRIDS);
+    __m128i const cellMask = _mm_set1_epi32(MAP_RESOLUTION - 1);
+    __m128 const one = _mm_set1_ps(1.0f);
+
+    alignas(16) int32 cellX[4];
+    alignas(16) int32 cellY[4];
+    alignas(16) float h1[4], h2[4], h3[4], h4[4], h5[4];
+    alignas(16) int32 hole[4];
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 fx = _mm_mul_ps(resolution, _mm_sub_ps(gridCenter, _mm_div_ps(_mm_loadu_ps(x + i), gridSize)));
+        __m128 fy = _mm_mul_ps(resolution, _mm_sub_ps(gridCenter, _mm_div_ps(_mm_loadu_ps(y + i), gridSize)));
+        __m128i ix = _mm_cvttps_epi32(fx);
+        __m128i iy = _mm_cvttps_epi32(fy);
+        fx = _mm_sub_ps(fx, _mm_cvtepi32_ps(ix));
+        fy = _mm_sub_ps(fy, _mm_cvtepi32_ps(iy));
+        _mm_store_si128((__m128i*)cellX, _mm_and_si128(ix, cellMask));
+        _mm_store_si128((__m128i*)cellY, _mm_and_si128(iy, cellMask));
+
+        for (uint32 lane = 0; lane < 4; ++lane)
+        {
+            hole[lane] = isHole(cellX[lane], cellY[lane]) ? -1 : 0;
+            T const* v9h1 = &v9[cellX[lane] * 129 + cellY[lane]];
+            h1[lane] = float(v9h1[0]);
+            h2[lane] = float(v9h1[129]);
+            h3[lane] = float(v9h1[1]);
+            h4[lane] = float(v9h1[130]);
+            h5[lane] = 2 * float(v8[cellX[lane] * 128 + cellY[lane]]);
+        }
+
+        __m128 const vh1 = _mm_load_ps(h1);
+        __m128 const vh2 = _mm_load_ps(h2);
+        __m128 const vh3 = _mm_load_ps(h3);
+        __m128 const vh4 = _mm_load_ps(h4);
+        __m128 const vh5 = _mm_load_ps(h5);
+
+        // triangles 1 to 4, see getHeightFromFloat
+        __m128 const a1 = _mm_sub_ps(vh2, vh1);
+        __m128 const b1 = _mm_sub_ps(_mm_sub_ps(vh5, vh1), vh2);
+        __m128 const a2 = _mm_sub_ps(_mm_sub_ps(vh5, vh1), vh3);
+        __m128 const b2 = _mm_sub_ps(vh3, vh1);
+        __m128 const a3 = _mm_sub_ps(_mm_add_ps(vh2, vh4), vh5);
+        __m128 const b3 = _mm_sub_ps(vh4, vh2);
+        __m128 const a4 = _mm_sub_ps(vh4, vh3);
+        __m128 const b4 = _mm_sub_ps(_mm_add_ps(vh3, vh4), vh5);
+        __m128 const c34 = _mm_sub_ps(vh5, vh4);
+
+        __m128 const upper = _mm_cmplt_ps(_mm_add_ps(fx, fy), one);
+        __m128 const right = _mm_cmpgt_ps(fx, fy);
+        auto select = [](__m128 mask, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); };
+
+        __m128 const a = select(upper, select(right, a1, a2), select(right, a3, a4));
+        __m128 const b = select(upper, select(right, b1, b2), select(right, b3, b4));
+        __m128 const c = select(upper, vh1, c34);
+
+        __m128 height = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, fx), _mm_mul_ps(b, fy)), c);
+        if (!std::is_same<T, float>::value)
+            height = _mm_add_ps(_mm_mul_ps(height, _mm_set1_ps(multiplier)), _mm_set1_ps(offset));
+
+        height = select(_mm_castsi128_ps(_mm_load_si128((__m128i const*)hole)), _mm_set1_ps(INVALID_HEIGHT), height);
+        _mm_storeu_ps(heights + i, height);
+    }
+#endif
+
+    for (; i < count; ++i)
+        heights[i] = getHeight(x[i], y[i]);
+}
+
 bool GridMap::isHole(int row, int col) const
 {
     if (!_holes)
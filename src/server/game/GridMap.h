@@ -109,6 +109,8 @@ class TC_GAME_API GridMap
     float getHeightFromUint16(float x, float y, bool walkableOnly = false) const;
     float getHeightFromUint8(float x, float y, bool walkableOnly = false) const;
     float getHeightFromFlat(float x, float y, bool walkableOnly = false) const;
+    template<typename T>
+    void getHeightsFromGrid(T const* v8, T const* v9, float multiplier, float offset, float const* x, float const* y, float* heights, uint32 count) const;
     
 public:
     GridMap();
@@ -118,6 +120,8 @@ public:
 
     uint16 getArea(float x, float y) const;
     inline float getHeight(float x, float y, bool walkableOnly = false) const {return (this->*_gridGetHeight)(x, y, walkableOnly);}
+    // Same as getHeight for count points at once, all points must be in this grid
+    void getHeights(float const* x, float const* y, float* heights, uint32 count) const;
     float getMinHeight(float x, float y) const;
     float getLiquidLevel(float x, float y) const;
     ZLiquidStatus GetLiquidStatus(float x, float y, float z, uint8 ReqLiquidTypeMask, LiquidData* data = nullptr, float collisionHeight = 2.03128f); // DEFAULT_COLLISION_HEIGHT in Object.h
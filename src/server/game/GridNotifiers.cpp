@@ -124,6 +124,21 @@ inline void CreatureUnitRelocationWorker(Creature* c, Unit* u)
     }
 }
 
+PlayerRelocationNotifier::PlayerRelocationNotifier(Player &player) : VisibleNotifier(player),
+    i_relocationOnly(!player.NeedsFullVisibilityUpdate() && player.m_seer == &player && player.IsAlive())
+{
+}
+
+bool PlayerRelocationNotifier::IsStillVisible(WorldObject const* target) const
+{
+    // stealth detection depends on distance, always check stealthed objects
+    if (!i_relocationOnly || target->m_stealth.GetFlags() || !i_player.HaveAtClient(target))
+        return false;
+
+    float sightRange = i_player.GetSightRange(target);
+    return i_player.GetExactDist2dSq(target) <= sightRange * sightRange;
+}
+
 void PlayerRelocationNotifier::Visit(PlayerMapType &m)
 {
     for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
@@ -132,7 +147,8 @@ void PlayerRelocationNotifier::Visit(PlayerMapType &m)
 
         vis_guids.erase(player->GetGUID());
 
-        i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
+        if (!IsStillVisible(player))
+            i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
 
         if (player->m_seer->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
             continue;
@@ -151,7 +167,8 @@ void PlayerRelocationNotifier::Visit(CreatureMapType &m)
 
         vis_guids.erase(c->GetGUID());
 
-        i_player.UpdateVisibilityOf(c, i_data, i_visibleNow);
+        if (!IsStillVisible(c))
+            i_player.UpdateVisibilityOf(c, i_data, i_visibleNow);
 
         if (relocated_for_ai && !c->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
             CreatureUnitRelocationWorker(c, &i_player);
@@ -229,6 +246,7 @@ void DelayedUnitRelocation::Visit(PlayerMapType &m)
         cell2.Visit(pair2, c2grid_relocation, i_map, *viewPoint, i_radius);
 
         relocate.SendToSelf();
+        player->SetFullVisibilityUpdated();
     }
 }
 
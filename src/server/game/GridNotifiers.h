@@ -43,13 +43,19 @@ namespace Trinity
 		void Visit(DynamicObjectMapType &);
 	};
 
+    // When only the player moved since the last notify, objects visible at client that stay inside the
+    // sight range are not checked again: changes of their own state are sent by their own notifiers
     struct TC_GAME_API PlayerRelocationNotifier : public VisibleNotifier
     {
-        PlayerRelocationNotifier(Player &player) : VisibleNotifier(player) {}
+        bool i_relocationOnly;
 
-        template<class T> inline void Visit(GridRefManager<T> &m) { VisibleNotifier::Visit(m); }
+        PlayerRelocationNotifier(Player &player);
+
+        template<class T> void Visit(GridRefManager<T> &m);
 		void Visit(CreatureMapType &);
 		void Visit(PlayerMapType &);
+
+        bool IsStillVisible(WorldObject const* target) const;
     };
 
 	struct TC_GAME_API CreatureRelocationNotifier
@@ -140,7 +146,8 @@ namespace Trinity
     struct TC_GAME_API ObjectUpdater
     {
         uint32 i_timeDiff;
-        explicit ObjectUpdater(const uint32 &diff) : i_timeDiff(diff) {}
+        UpdateLODScheduler* i_updateLOD;
+        explicit ObjectUpdater(const uint32 &diff, UpdateLODScheduler* updateLOD = nullptr) : i_timeDiff(diff), i_updateLOD(updateLOD) {}
         template<class T> void Visit(GridRefManager<T> &m);
         void Visit(PlayerMapType &) {}
         void Visit(CorpseMapType &) {}
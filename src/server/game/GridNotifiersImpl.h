@@ -32,8 +32,16 @@ inline void
 Trinity::ObjectUpdater::Visit(CreatureMapType &m)
 {
     for(auto & iter : m)
-        if(iter.GetSource()->IsInWorld())
-            iter.GetSource()->Update(i_timeDiff);
+    {
+        Creature* creature = iter.GetSource();
+        if (!creature->IsInWorld())
+            continue;
+
+        // creatures far from players may have their update delayed
+        uint32 const diff = i_updateLOD ? i_updateLOD->Schedule(creature, i_timeDiff) : i_timeDiff;
+        if (diff)
+            creature->Update(diff);
+    }
 }
 
 template<class T>
@@ -46,6 +54,17 @@ inline void Trinity::VisibleNotifier::Visit(GridRefManager<T> &m)
 	}
 }
 
+template<class T>
+inline void Trinity::PlayerRelocationNotifier::Visit(GridRefManager<T> &m)
+{
+    for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        vis_guids.erase(iter->GetSource()->GetGUID());
+        if (!IsStillVisible(iter->GetSource()))
+            i_player.UpdateVisibilityOf(iter->GetSource(), i_data, i_visibleNow);
+    }
+}
+
 // SEARCHERS & LIST SEARCHERS & WORKERS
 
 // WorldObject searchers & workers
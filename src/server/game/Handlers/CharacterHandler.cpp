@@ -30,6 +30,8 @@
 #include "ArenaTeamMgr.h"
 #include "ReputationMgr.h"
 #include "GameTime.h"
+#include "LoginQueryBatcher.h"
+#include "Monitor.h"
 
 #ifdef VOICECHAT
 #include "VoiceChat/VoiceChatMgr.h"
@@ -57,7 +59,7 @@ public:
     PlayerbotHolder* GetPlayerbotHolder() { return playerbotHolder; }
 };
 
-Player* PlayerbotHolder::AddPlayerBot(ObjectGuid playerGuid, uint32 masterAccount, bool testingBot)
+PlayerbotLoginQueryHolder* PlayerbotHolder::CreateLoginQueryHolder(ObjectGuid playerGuid, uint32 masterAccount)
 {
     // has bot already been added?x
     Player* bot = ObjectAccessor::FindPlayer(playerGuid);
@@ -76,16 +78,56 @@ Player* PlayerbotHolder::AddPlayerBot(ObjectGuid playerGuid, uint32 masterAccoun
         return nullptr;
     }
 
-    QueryResultHolderFuture future = CharacterDatabase.DelayQueryHolder(holder);
+    return holder;
+}
+
+Player* PlayerbotHolder::AddPlayerBot(ObjectGuid playerGuid, uint32 masterAccount, bool testingBot)
+{
+    PlayerbotLoginQueryHolder* holder = CreateLoginQueryHolder(playerGuid, masterAccount);
+    if (!holder)
+        return nullptr;
+
+    QueryResultHolderFuture future = sLoginQueryBatcher->Enqueue(holder);
+    sLoginQueryBatcher->Flush();
     future.get();
 
+    return LoginPlayerBot(holder, testingBot);
+}
+
+std::vector<Player*> PlayerbotHolder::AddPlayerBots(std::vector<ObjectGuid> const& playerGuids, uint32 masterAccount)
+{
+    // queue all the logins before waiting for the first one, so that they are loaded in as few batches as possible
+    std::vector<std::pair<PlayerbotLoginQueryHolder*, QueryResultHolderFuture>> logins(playerGuids.size());
+    for (size_t i = 0; i < playerGuids.size(); ++i)
+    {
+        logins[i].first = CreateLoginQueryHolder(playerGuids[i], masterAccount);
+        if (logins[i].first)
+            logins[i].second = sLoginQueryBatcher->Enqueue(logins[i].first);
+    }
+    sLoginQueryBatcher->Flush();
+
+    std::vector<Player*> bots(playerGuids.size(), nullptr);
+    for (size_t i = 0; i < logins.size(); ++i)
+    {
+        if (!logins[i].first)
+            continue;
+
+        logins[i].second.get();
+        bots[i] = LoginPlayerBot(logins[i].first, false);
+    }
+    return bots;
+}
+
+Player* PlayerbotHolder::LoginPlayerBot(PlayerbotLoginQueryHolder* holder, bool testingBot)
+{
+    uint32 masterAccount = holder->GetMasterAccountId();
     WorldSession* masterSession = masterAccount ? sWorld->FindSession(masterAccount) : nullptr;
     uint32 botAccountId = holder->GetAccountId();
     WorldSession *botSession = new WorldSession(botAccountId, BUILD_243, "rndbot", nullptr, SEC_PLAYER, 2, 0, LOCALE_enUS, 0, false);
 
     botSession->HandlePlayerLogin(holder); // will delete lqh
 
-    bot = botSession->GetPlayer();
+    Player* bot = botSession->GetPlayer();
     if (!bot)
     {
         delete botSession;
@@ -653,7 +695,7 @@ void WorldSession::HandlePlayerLoginOpcode( WorldPacket & recvData )
         return;
     }
 
-    _charLoginCallback = CharacterDatabase.DelayQueryHolder((SQLQueryHolder*)holder);
+    _charLoginCallback = sLoginQueryBatcher->Enqueue(holder);
 }
 
 void WorldSession::_HandlePlayerLogin(Player* pCurrChar, LoginQueryHolder* holder)
@@ -1021,6 +1063,15 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder* holder)
 {
     ObjectGuid playerGuid = holder->GetGuid();
 
+    if (holder->GetQueueTime())
+    {
+        LoginBatchStats stats;
+        stats.logins = 1;
+        stats.latencyMax = GetMSTimeDiffToNow(holder->GetQueueTime());
+        stats.latencySum = stats.latencyMax;
+        sMonitor->AddLoginBatchStats(stats);
+    }
+
     Player* pCurrChar = new Player(this);
 
     pCurrChar->GetMotionMaster()->Initialize(); //sun: initialize motion before loading auras instead
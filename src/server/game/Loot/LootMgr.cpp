@@ -85,7 +85,8 @@ class LootTemplate::LootGroup                               // A set of loot def
         bool HasQuestDrop() const;                          // True if group includes at least 1 quest drop entry
         bool HasQuestDropForPlayer(Player const * player) const;
                                                             // The same for active quests of the player
-        void Process(Loot& loot, uint16 lootMode) const;    // Rolls an item from the group (if any) and adds the item to the loot
+        void Process(Loot& loot, uint16 lootMode, bool linear) const; // Rolls an item from the group (if any) and adds the item to the loot
+        void Compile();                                     // Builds the alias table of the group (after loading)
         float RawTotalChance() const;                       // Overall chance for the group (without equal chanced items)
         float TotalChance() const;                          // Overall chance for the group
 
@@ -95,10 +96,21 @@ class LootTemplate::LootGroup                               // A set of loot def
         LootStoreItemList* GetEqualChancedItemList() { return &EqualChanced; }
         void CopyConditions(ConditionContainer conditions);
     private:
+        struct AliasSlot
+        {
+            LootStoreItem* item;                            // null for the slot of the chance left to the equal chanced entries
+            double threshold;                               // probability to take the slot item, else the alias slot item
+            uint32 alias;
+        };
+
         LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
         LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
+        std::vector<AliasSlot> AliasTable;                  // Walker alias table of the explicitly chanced entries, filled by Compile()
+        std::vector<LootStoreItem*> EqualChancedItems;
+        bool Compiled = false;                              // false until Compile(), or if the linear roll must be kept
 
         LootStoreItem const* Roll(Loot& loot, uint16 lootMode) const;   // Rolls an item from the group, returns NULL if all miss their chances
+        LootStoreItem const* RollLinear(Loot& loot, uint16 lootMode) const;
 
         // This class must never be copied - storing pointers
         LootGroup(LootGroup const&) = delete;
@@ -186,6 +198,9 @@ uint32 LootStore::LoadLootTable()
 
     Verify();                                           // Checks validity of the loot store
 
+    for (auto& itr : m_LootTemplates)
+        itr.second->Compile();
+
     return count;
 }
 
@@ -365,8 +380,94 @@ void LootTemplate::LootGroup::AddEntry(LootStoreItem* item)
         EqualChanced.push_back(item);
 }
 
+// Builds the alias table (Vose's method) of the explicitly chanced entries, with one more outcome for the
+// chance left to the equal chanced entries, so that Roll samples the group in constant time
+void LootTemplate::LootGroup::Compile()
+{
+    AliasTable.clear();
+    EqualChancedItems.assign(EqualChanced.begin(), EqualChanced.end());
+
+    // The linear roll gives each entry exactly its chance only while the chances add up to 100% at most.
+    // Beyond, the entries at the end of the list are cut and their order matters: keep the linear roll
+    float totalChance = 0.0f;
+    for (LootStoreItem const* item : ExplicitlyChanced)
+        totalChance += item->chance;
+
+    Compiled = totalChance <= 100.0f;
+    if (!Compiled || ExplicitlyChanced.empty())
+        return;
+
+    uint32 const count = ExplicitlyChanced.size() + 1;
+    std::vector<double> scaled;
+    scaled.reserve(count);
+    AliasTable.reserve(count);
+    for (LootStoreItem* item : ExplicitlyChanced)
+    {
+        scaled.push_back(item->chance / 100.0 * count);
+        AliasTable.push_back({ item, 1.0, uint32(AliasTable.size()) });
+    }
+    scaled.push_back((100.0 - totalChance) / 100.0 * count);
+    AliasTable.push_back({ nullptr, 1.0, uint32(AliasTable.size()) });
+
+    std::vector<uint32> small, large;
+    for (uint32 i = 0; i < count; ++i)
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+
+    while (!small.empty() && !large.empty())
+    {
+        uint32 const less = small.back();
+        small.pop_back();
+        uint32 const more = large.back();
+
+        AliasTable[less].threshold = scaled[less];
+        AliasTable[less].alias = more;
+        scaled[more] -= 1.0 - scaled[less];
+        if (scaled[more] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+    // slots left in either list are full, up to rounding errors, and keep threshold 1
+}
+
 // Rolls an item from the group, returns NULL if all miss their chances
+// Same distribution as RollLinear: with chances adding up to 100% at most, an explicitly chanced entry filtered out
+// gives its chance to the equal chanced entries, and picking among all equal chanced entries until a valid one
+// is found is picking among the valid ones.
 LootStoreItem const* LootTemplate::LootGroup::Roll(Loot& loot, uint16 lootMode) const
+{
+    if (!Compiled)
+        return RollLinear(loot, lootMode);
+
+    LootGroupInvalidSelector isInvalid(loot, lootMode);
+    if (!AliasTable.empty())
+    {
+        double const roll = rand_norm() * AliasTable.size();
+        uint32 const slot = std::min(uint32(roll), uint32(AliasTable.size() - 1));
+        AliasSlot const& aliasSlot = AliasTable[slot];
+        LootStoreItem* item = roll - slot < aliasSlot.threshold ? aliasSlot.item : AliasTable[aliasSlot.alias].item;
+        if (item && !isInvalid(item))
+            return item;
+    }
+
+    if (EqualChancedItems.empty())
+        return nullptr;
+
+    LootStoreItem* item = EqualChancedItems[urand(0, EqualChancedItems.size() - 1)];
+    if (!isInvalid(item))
+        return item;
+
+    LootStoreItemList possibleLoot = EqualChanced;
+    possibleLoot.remove_if(isInvalid);
+    if (!possibleLoot.empty())
+        return Trinity::Containers::SelectRandomContainerElement(possibleLoot);
+
+    return nullptr;
+}
+
+// Rolls an item from the group walking the entry lists, used when the group could not be compiled
+LootStoreItem const* LootTemplate::LootGroup::RollLinear(Loot& loot, uint16 lootMode) const
 {
     LootStoreItemList possibleLoot = ExplicitlyChanced;
     possibleLoot.remove_if(LootGroupInvalidSelector(loot, lootMode));
@@ -429,9 +530,9 @@ void LootTemplate::LootGroup::CopyConditions(ConditionContainer /*conditions*/)
 }
 
 // Rolls an item from the group (if any takes its chance) and adds the item to the loot
-void LootTemplate::LootGroup::Process(Loot& loot, uint16 lootMode) const
+void LootTemplate::LootGroup::Process(Loot& loot, uint16 lootMode, bool linear) const
 {
-    if (LootStoreItem const * item = Roll(loot, lootMode))
+    if (LootStoreItem const * item = linear ? RollLinear(loot, lootMode) : Roll(loot, lootMode))
         loot.AddItem(*item);
 }
 
@@ -546,8 +647,32 @@ void LootTemplate::CopyConditions(LootItem* li) const
     }
 }
 
+// Resolves the chance modifiers of the non-grouped entries (no item template lookup at roll) and compiles the groups
+void LootTemplate::Compile()
+{
+    FlatEntries.clear();
+    FlatEntries.reserve(Entries.size());
+    for (LootStoreItem* item : Entries)
+    {
+        // same modifiers as LootStoreItem::Roll
+        uint32 rate = MAX_RATES;
+        if (item->reference > 0)
+            rate = RATE_DROP_ITEM_REFERENCED;
+        else if (ItemTemplate const* proto = sObjectMgr->GetItemTemplate(item->itemid))
+            rate = qualityToRate[proto->Quality];
+
+        FlatEntries.push_back({ item, rate });
+    }
+
+    for (auto group : Groups)
+        if (group)
+            group->Compile();
+
+    Compiled = true;
+}
+
 // Rolls for every item in the template and adds the rolled items the the loot
-void LootTemplate::Process(Loot& loot, bool rate, uint16 lootMode, uint8 groupId) const
+void LootTemplate::Process(Loot& loot, bool rate, uint16 lootMode, uint8 groupId, bool linear) const
 {
     if (groupId)                                            // Group reference uses own processing of the group
     {
@@ -557,38 +682,68 @@ void LootTemplate::Process(Loot& loot, bool rate, uint16 lootMode, uint8 groupId
         if (!Groups[groupId - 1])
             return;
 
-        Groups[groupId - 1]->Process(loot, lootMode);
+        Groups[groupId - 1]->Process(loot, lootMode, linear);
         return;
     }
 
     // Rolling non-grouped items
-    for (LootStoreItemList::const_iterator i = Entries.begin(); i != Entries.end(); ++i)
+    if (Compiled && !linear)
     {
-        LootStoreItem* item = *i;
-        if (!(item->lootmode & lootMode))                       // Do not add if mode mismatch
-            continue;
+        for (CompiledEntry const& entry : FlatEntries)
+        {
+            LootStoreItem* item = entry.item;
+            if (!(item->lootmode & lootMode))                   // Do not add if mode mismatch
+                continue;
 
-        if (!item->Roll(rate))
-            continue;                                           // Bad luck for the entry
+            if (item->chance < 100.0f)
+            {
+                // the quality modifier of items applies even without rate, see LootStoreItem::Roll
+                float modifier = 1.0f;
+                if (entry.rate != MAX_RATES && (rate || item->reference == 0))
+                    modifier = sWorld->GetRate(Rates(entry.rate));
+                if (!roll_chance_f(item->chance * modifier))
+                    continue;                                   // Bad luck for the entry
+            }
 
-        if (item->reference > 0)                            // References processing
+            ProcessEntry(loot, item, rate, lootMode, linear);
+        }
+    }
+    else
+    {
+        for (LootStoreItemList::const_iterator i = Entries.begin(); i != Entries.end(); ++i)
         {
-            LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(item->reference);
-            if (!Referenced)
-                continue;                                       // Error message already printed at loading stage
+            LootStoreItem* item = *i;
+            if (!(item->lootmode & lootMode))                   // Do not add if mode mismatch
+                continue;
+
+            if (!item->Roll(rate))
+                continue;                                       // Bad luck for the entry
 
-            uint32 maxcount = uint32(float(item->maxcount) /** sWorld->GetRate(RATE_DROP_ITEM_REFERENCED_AMOUNT)*/);
-            for (uint32 loop = 0; loop < maxcount; ++loop)      // Ref multiplicator
-                Referenced->Process(loot, rate, lootMode, item->groupid);
+            ProcessEntry(loot, item, rate, lootMode, linear);
         }
-        else                                                    // Plain entries (not a reference, not grouped)
-            loot.AddItem(*item);                                // Chance is already checked, just add
     }
 
     // Now processing groups
     for (auto group : Groups)
         if (group)
-            group->Process(loot, lootMode);
+            group->Process(loot, lootMode, linear);
+}
+
+// Adds a non-grouped entry which took its chance to the loot
+void LootTemplate::ProcessEntry(Loot& loot, LootStoreItem const* item, bool rate, uint16 lootMode, bool linear)
+{
+    if (item->reference > 0)                                // References processing
+    {
+        LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(item->reference);
+        if (!Referenced)
+            return;                                         // Error message already printed at loading stage
+
+        uint32 maxcount = uint32(float(item->maxcount) /** sWorld->GetRate(RATE_DROP_ITEM_REFERENCED_AMOUNT)*/);
+        for (uint32 loop = 0; loop < maxcount; ++loop)      // Ref multiplicator
+            Referenced->Process(loot, rate, lootMode, item->groupid, linear);
+    }
+    else                                                    // Plain entries (not a reference, not grouped)
+        loot.AddItem(*item);                                // Chance is already checked, just add
 }
 
 // True if template includes at least 1 quest drop entry
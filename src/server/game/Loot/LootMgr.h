@@ -108,8 +108,11 @@ class TC_GAME_API LootTemplate
 
         // Adds an entry to the group (at loading stage)
         void AddEntry(LootStoreItem* item);
+        // Builds the flat entry list and the group alias tables used by Process, once all entries are added
+        void Compile();
         // Rolls for every item in the template and adds the rolled items the the loot
-        void Process(Loot& loot, bool rate, uint16 lootMode, uint8 groupId = 0) const;
+        // linear: ignore the compiled tables and roll the entry lists as before, for the distribution tests
+        void Process(Loot& loot, bool rate, uint16 lootMode, uint8 groupId = 0, bool linear = false) const;
         void CopyConditions(const ConditionContainer& conditions);
         void CopyConditions(LootItem* li) const;
 
@@ -125,8 +128,19 @@ class TC_GAME_API LootTemplate
         bool isReference(uint32 id);
         
     private:
+        struct CompiledEntry
+        {
+            LootStoreItem* item;
+            uint32 rate;                                    // chance modifier (Rates), MAX_RATES if none
+        };
+        typedef std::vector<CompiledEntry> CompiledEntries;
+
         LootStoreItemList Entries;                          // not grouped only
         LootGroups        Groups;                           // groups have own (optimised) processing, grouped entries go there
+        CompiledEntries   FlatEntries;                      // Entries with their rate resolved, filled by Compile()
+        bool              Compiled = false;
+
+        static void ProcessEntry(Loot& loot, LootStoreItem const* item, bool rate, uint16 lootMode, bool linear);
 
         // Objects of this class must never be copied, we are storing pointers in container
         LootTemplate(LootTemplate const&) = delete;
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2008-2019 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LineOfSightCache.h"
+#include "ModelIgnoreFlags.h"
+#include "World.h"
+#include <cmath>
+#include <cstring>
+
+// a map update casting more rays than this starts again from an empty cache
+static std::size_t const LINE_OF_SIGHT_CACHE_MAX_RAYS = 65536;
+
+void LineOfSightCacheStats::Add(LineOfSightCacheStats const& other)
+{
+    hits += other.hits;
+    misses += other.misses;
+}
+
+bool LineOfSightCache::Key::operator==(Key const& other) const
+{
+    return std::memcmp(ends, other.ends, sizeof(ends)) == 0 && phaseMask == other.phaseMask
+        && ignoreFlags == other.ignoreFlags && checks == other.checks;
+}
+
+std::size_t LineOfSightCache::KeyHash::operator()(Key const& key) const
+{
+    uint64 hash = 14695981039346656037ULL;
+    auto combine = [&hash](uint32 value)
+    {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+
+    for (int32 end : key.ends)
+        combine(uint32(end));
+    combine(key.phaseMask);
+    combine(key.ignoreFlags);
+    combine(key.checks);
+    return std::size_t(hash ^ (hash >> 32));
+}
+
+LineOfSightCache::LineOfSightCache() : _enabled(false)
+{
+}
+
+void LineOfSightCache::Reset()
+{
+    _rays.clear();
+    _stats = LineOfSightCacheStats();
+    _enabled = sWorld->getBoolConfig(CONFIG_LOS_CACHE_ENABLED);
+}
+
+LineOfSightCache::Key LineOfSightCache::MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phaseMask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    Key key;
+    float const ends[6] = { x1, y1, z1, x2, y2, z2 };
+    for (uint8 i = 0; i < 6; ++i)
+        key.ends[i] = int32(std::floor(ends[i] / LINE_OF_SIGHT_CACHE_PRECISION));
+    key.phaseMask = phaseMask;
+    key.ignoreFlags = uint32(ignoreFlags);
+    key.checks = uint8(checks);
+    return key;
+}
+
+bool LineOfSightCache::Find(Key const& key, bool& inLineOfSight)
+{
+    auto itr = _rays.find(key);
+    if (itr == _rays.end())
+    {
+        ++_stats.misses;
+        return false;
+    }
+
+    ++_stats.hits;
+    inLineOfSight = itr->second;
+    return true;
+}
+
+void LineOfSightCache::Insert(Key const& key, bool inLineOfSight)
+{
+    if (_rays.size() >= LINE_OF_SIGHT_CACHE_MAX_RAYS)
+        _rays.clear();
+
+    _rays[key] = inLineOfSight;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2008-2019 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_LINE_OF_SIGHT_CACHE_H
+#define TRINITY_LINE_OF_SIGHT_CACHE_H
+
+#include "Define.h"
+#include "SharedDefines.h"
+#include <unordered_map>
+
+namespace VMAP { enum class ModelIgnoreFlags : uint32; }
+
+struct LineOfSightCacheStats
+{
+    uint64 hits = 0;
+    uint64 misses = 0;
+
+    void Add(LineOfSightCacheStats const& other);
+};
+
+// size in yards to which the ends of cached rays are rounded
+float const LINE_OF_SIGHT_CACHE_PRECISION = 0.25f;
+
+/*
+Results of Map::isInLineOfSight during one map update. Rays are keyed by their ends rounded
+to LINE_OF_SIGHT_CACHE_PRECISION, so rays between close points share their result.
+The cache is emptied before each map update and whenever a gameobject model of the map changes.
+*/
+class TC_GAME_API LineOfSightCache
+{
+public:
+    struct Key
+    {
+        int32 ends[6];
+        uint32 phaseMask;
+        uint32 ignoreFlags;
+        uint8 checks;
+
+        bool operator==(Key const& other) const;
+    };
+
+    LineOfSightCache();
+
+    // Reads the config and forgets every ray, to call before each map update
+    void Reset();
+    // Forgets every ray, to call when the dynamic collision of the map changes
+    void Invalidate() { _rays.clear(); }
+
+    bool IsEnabled() const { return _enabled; }
+
+    Key MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phaseMask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+    // Returns true and sets inLineOfSight if the ray was already cast
+    bool Find(Key const& key, bool& inLineOfSight);
+    void Insert(Key const& key, bool inLineOfSight);
+
+    LineOfSightCacheStats const& GetStats() const { return _stats; }
+
+private:
+    struct KeyHash
+    {
+        std::size_t operator()(Key const& key) const;
+    };
+
+    bool _enabled;
+    std::unordered_map<Key, bool, KeyHash> _rays;
+    LineOfSightCacheStats _stats;
+};
+
+#endif
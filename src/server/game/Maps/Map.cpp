@@ -29,6 +29,7 @@
 #include "PoolMgr.h"
 #include "DynamicTree.h"
 #include "Battleground.h"
+#include "Monitor.h"
 #include "GridMap.h"
 #include "ObjectGridLoader.h"
 #include "Pet.h"
@@ -79,8 +80,6 @@ Map::~Map()
 
     if (!m_scriptSchedule.empty())
         sMapMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
-
-    MMAP::MMapFactory::createOrGetMMapManager()->unloadMapInstance(GetId(), i_InstanceId);
 }
 
 void Map::ReloadMMap(int gx, int gy)
@@ -722,7 +721,7 @@ void Map::ProcessRelocationNotifies(const uint32 diff)
                 Cell cell(pair);
                 cell.SetNoCreate();
 
-                Trinity::DelayedUnitRelocation cell_relocation(cell, pair, *this, MAX_VISIBILITY_DISTANCE);
+                Trinity::DelayedUnitRelocation cell_relocation(cell, pair, *this, MAX_VISIBILITY_DISTANCE + World::GetVisibilityHysteresis());
                 TypeContainerVisitor<Trinity::DelayedUnitRelocation, GridTypeMapContainer  > grid_object_relocation(cell_relocation);
                 TypeContainerVisitor<Trinity::DelayedUnitRelocation, WorldTypeMapContainer > world_object_relocation(cell_relocation);
                 Visit(cell, grid_object_relocation);
@@ -858,7 +857,27 @@ void Map::Update(const uint32& t_diff)
 
     resetMarkedCells();
 
-    Trinity::ObjectUpdater updater(t_diff);
+    _updateLOD.Reset(GetVisibilityRange());
+    _lineOfSightCache.Reset();
+    if (_updateLOD.IsEnabled())
+    {
+        for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+        {
+            Player* player = itr->GetSource();
+            if (!player || !player->IsInWorld())
+                continue;
+
+            _updateLOD.AddSource(player);
+            if (WorldObject* viewPoint = player->GetViewpoint())
+                _updateLOD.AddSource(viewPoint);
+        }
+
+        for (WorldObject* obj : m_activeForcedNonPlayers)
+            if (obj && obj->IsInWorld())
+                _updateLOD.AddSource(obj);
+    }
+
+    Trinity::ObjectUpdater updater(t_diff, &_updateLOD);
     // for creature
     TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
     // for pets
@@ -866,6 +885,8 @@ void Map::Update(const uint32& t_diff)
 
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
+    // cells around players are visited first, creatures in sight of a player are never delayed
+    _updateLOD.SetVisitingPlayerCells(true);
     for(m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
         Player* player = m_mapRefIter->GetSource();
@@ -881,6 +902,15 @@ void Map::Update(const uint32& t_diff)
         // If player is using far sight or mind vision, visit that object too
         if (WorldObject* viewPoint = player->GetViewpoint())
             VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
+    }
+    _updateLOD.SetVisitingPlayerCells(false);
+
+    for(m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    {
+        Player* player = m_mapRefIter->GetSource();
+
+        if (!player || !player->IsInWorld())
+            continue;
 
         // Handle updates for creatures in combat with player and are more than 60 yards away
         if (player->IsInCombat())
@@ -919,6 +949,11 @@ void Map::Update(const uint32& t_diff)
         VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
     }
 
+    if (_updateLOD.IsEnabled())
+        sMonitor->AddCreatureUpdateLODStats(_updateLOD.GetStats());
+    if (_lineOfSightCache.IsEnabled())
+        sMonitor->AddLineOfSightCacheStats(_lineOfSightCache.GetStats());
+
     //update our transports
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
     {
@@ -1090,7 +1125,7 @@ void Map::PlayerRelocation(Player *player, float x, float y, float z, float orie
     }
 
     player->UpdatePositionData();
-    player->UpdateObjectVisibility(false);
+    player->UpdateObjectVisibilityOnRelocation();
 }
 
 void Map::CreatureRelocation(Creature *creature, float x, float y, float z, float ang)
@@ -1932,6 +1967,26 @@ float Map::GetGridMapHeight(float x, float y) const
     return INVALID_HEIGHT;
 }
 
+void Map::GetGridMapHeights(float const* x, float const* y, float* heights, uint32 count) const
+{
+    uint32 i = 0;
+    while (i < count)
+    {
+        int gx = (int)(32 - x[i] / SIZE_OF_GRIDS);
+        int gy = (int)(32 - y[i] / SIZE_OF_GRIDS);
+        uint32 end = i + 1;
+        while (end < count && (int)(32 - x[end] / SIZE_OF_GRIDS) == gx && (int)(32 - y[end] / SIZE_OF_GRIDS) == gy)
+            ++end;
+
+        if (GridMap* gmap = const_cast<Map*>(this)->GetGrid(x[i], y[i]))
+            gmap->getHeights(x + i, y + i, heights + i, end - i);
+        else
+            std::fill(heights + i, heights + end, INVALID_HEIGHT);
+
+        i = end;
+    }
+}
+
 float Map::GetVMapFloor(float x, float y, float z, float maxSearchDist, float collisionHeight) const
 {
     return VMAP::VMapFactory::createOrGetVMapManager()->getHeight(GetId(), x, y, z + collisionHeight, maxSearchDist);
@@ -2271,13 +2326,73 @@ float Map::GetGameObjectCeil(uint32 phasemask, float x, float y, float z, float
 
 bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
 {
+    LineOfSightCache::Key key;
+    bool result;
+    if (_lineOfSightCache.IsEnabled())
+    {
+        key = _lineOfSightCache.MakeKey(x1, y1, z1, x2, y2, z2, phasemask, checks, ignoreFlags);
+        if (_lineOfSightCache.Find(key, result))
+            return result;
+    }
+
+    result = true;
     if ((checks & LINEOFSIGHT_CHECK_VMAP)
         && !VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2, ignoreFlags))
-        return false;
-    if (/*sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && */(checks & LINEOFSIGHT_CHECK_GOBJECT)
+        result = false;
+    else if (/*sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && */(checks & LINEOFSIGHT_CHECK_GOBJECT)
         && !_dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask))
-        return false;
-    return true;
+        result = false;
+
+    if (_lineOfSightCache.IsEnabled())
+        _lineOfSightCache.Insert(key, result);
+
+    return result;
+}
+
+void Map::isInLineOfSight(float x1, float y1, float z1, Position const* targets, uint32 count, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags, bool* results) const
+{
+    // rays not found in the cache, with their targets as x, y, z triplets
+    std::vector<uint32> rays;
+    std::vector<LineOfSightCache::Key> keys;
+    std::vector<float> rayTargets;
+    rays.reserve(count);
+    rayTargets.reserve(count * 3);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        Position const& target = targets[i];
+        if (_lineOfSightCache.IsEnabled())
+        {
+            LineOfSightCache::Key key = _lineOfSightCache.MakeKey(x1, y1, z1, target.GetPositionX(), target.GetPositionY(), target.GetPositionZ(), phasemask, checks, ignoreFlags);
+            if (_lineOfSightCache.Find(key, results[i]))
+                continue;
+            keys.push_back(key);
+        }
+
+        rays.push_back(i);
+        rayTargets.push_back(target.GetPositionX());
+        rayTargets.push_back(target.GetPositionY());
+        rayTargets.push_back(target.GetPositionZ());
+    }
+
+    if (rays.empty())
+        return;
+
+    std::unique_ptr<bool[]> rayResults(new bool[rays.size()]);
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+        VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, rayTargets.data(), rays.size(), ignoreFlags, rayResults.get());
+    else
+        std::fill(rayResults.get(), rayResults.get() + rays.size(), true);
+
+    for (uint32 i = 0; i < rays.size(); ++i)
+    {
+        bool& result = rayResults[i];
+        if (result && (checks & LINEOFSIGHT_CHECK_GOBJECT))
+            result = _dynamicTree.isInLineOfSight(x1, y1, z1, rayTargets[i * 3], rayTargets[i * 3 + 1], rayTargets[i * 3 + 2], phasemask);
+
+        results[rays[i]] = result;
+        if (_lineOfSightCache.IsEnabled())
+            _lineOfSightCache.Insert(keys[i], result);
+    }
 }
 
 bool Map::IsInWater(float x, float y, float pZ, LiquidData *data) const
@@ -2838,9 +2953,6 @@ InstanceMap::~InstanceMap()
         delete i_data;
         i_data = nullptr;
     }
-    
-    // unload instance specific navigation data
-    MMAP::MMapFactory::createOrGetMMapManager()->unloadMapInstance(GetId(), GetInstanceId());
 }
 
 float InstanceMap::GetDefaultVisibilityDistance() const
@@ -3213,46 +3325,89 @@ void TestMap::Update(const uint32& diff)
     if (!testThread)
         return;
 
-    //test thread may have been finish by itself or externally (by a cancel)
-    if (testThread->CanUnloadMap())
+    //decoupled tests maps are updated by TestMgr workers instead
+    if (testThread->IsDecoupled())
         return;
 
-    auto test = testThread->GetTest();
-    if (testThread->GetState() < TestThread::STATE_WAITING_FOR_JOIN)
-        return; //still setting up
+    _UpdateWithTest(*testThread, diff);
+#endif
+}
 
-    uint32 usedDiff = diff;
+void TestMap::DelayedUpdate(const uint32 diff)
+{
+#ifdef TESTS
+    auto testThread = _testThread.lock();
+    if (testThread && testThread->IsDecoupled())
+        return;
+#endif
+
+    InstanceMap::DelayedUpdate(diff);
+}
+
+void TestMap::UpdateDecoupled(uint32 diff)
+{
+#ifdef TESTS
+    auto testThread = _testThread.lock();
+    if (!testThread)
+        return;
+
+    //same clock as the map update, no delayed update while the test is paused
+    if (uint32 const usedDiff = _UpdateWithTest(*testThread, diff))
+        InstanceMap::DelayedUpdate(usedDiff);
+#endif
+}
+
+uint32 TestMap::_UpdateWithTest(TestThread& testThread, uint32 diff)
+{
+#ifdef TESTS
+    //test thread may have been finish by itself or externally (by a cancel)
+    if (testThread.IsFinished() || testThread.IsCanceling())
+        return 0;
+
+    auto test = testThread.GetTest();
+    if (testThread.GetState() < TestThread::STATE_WAITING_FOR_JOIN)
+        return 0; //still setting up
+
+    //simulated diff makes tests independant from the update rate
+    uint32 usedDiff = sWorld->getIntConfig(CONFIG_TESTING_SIMULATED_DIFF);
+    if (!usedDiff)
+        usedDiff = diff;
 
     //If a test is currently waiting, lets cheat a bit and make sure the wait end time coincide with the map diff if the diff is enough to finish the wait
-    if (uint32 const testWaitTimer = testThread->GetWaitTimer())
+    if (uint32 const testWaitTimer = testThread.GetWaitTimer())
         if (usedDiff > testWaitTimer)
             usedDiff = testWaitTimer;
 
     //if test asked for a pause, skip this map update
-    if (!testThread->IsPaused())
+    bool const updated = !testThread.IsPaused();
+    if (updated)
     {
         //only valid states at this points. test should never be currently updating at the same time as the map is updating
-        auto state = testThread->GetState();
+        auto state = testThread.GetState();
         ASSERT(state == TestThread::STATE_WAITING_FOR_JOIN || state == TestThread::STATE_READY 
             || state == TestThread::STATE_WAITING || state == TestThread::STATE_PAUSED);
         InstanceMap::Update(usedDiff);
 
         //When paused, time is frozen in test too
-        testThread->UpdateWaitTimer(usedDiff);
+        testThread.UpdateWaitTimer(usedDiff);
+        testThread.IncreaseTickCount();
     }
 
     ASSERT(test->IsSetup());
-    testThread->ResumeExecution();
+    testThread.ResumeExecution();
     uint32 startTimeMS = GetMSTime();
-    testThread->WaitUntilDoneOrWaiting(test);
+    testThread.WaitUntilDoneOrWaiting(test);
     //from this line we be sure that the test thread is not currently running
     if (uint32 warnThresholdMS = sWorld->getIntConfig(CONFIG_TESTING_WARN_UPDATE_TIME_THRESHOLD))
     {
         uint32 diff = GetMSTimeDiffToNow(startTimeMS);
         if(diff > warnThresholdMS)
-            TC_LOG_WARN("test.unit_test", "Test '%s' took %u ms to update", testThread->GetTest()->GetName().c_str(), diff);
+            TC_LOG_WARN("test.unit_test", "Test '%s' took %u ms to update", testThread.GetTest()->GetName().c_str(), diff);
     }
 
+    return updated ? usedDiff : 0;
+#else
+    return 0;
 #endif
 }
 
@@ -4474,6 +4629,7 @@ void Map::RemoveGameObjectModel(GameObjectModel const& model)
 { 
     TC_LOG_TRACE("maps", "Map %u - Removed model %s", GetId(), model.name.c_str());
     _dynamicTree.remove(model); 
+    _lineOfSightCache.Invalidate();
 }
 
 void Map::InsertGameObjectModel(GameObjectModel const& model) 
@@ -4481,6 +4637,7 @@ void Map::InsertGameObjectModel(GameObjectModel const& model)
     TC_LOG_TRACE("maps", "Map %u - Added model %s", GetId(), model.name.c_str());
     ASSERT(!_dynamicTree.contains(model));
     _dynamicTree.insert(model); 
+    _lineOfSightCache.Invalidate();
 }
 
 bool Map::ContainsGameObjectModel(GameObjectModel const& model) const 
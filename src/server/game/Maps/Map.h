@@ -16,6 +16,8 @@
 #include "Transaction.h"
 #include "SharedDefines.h"
 #include "Optional.h"
+#include "UpdateLOD.h"
+#include "LineOfSightCache.h"
 
 #include <bitset>
 #include <list>
@@ -264,6 +266,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         float GetHeight(float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH, float collisionHeight = 0.0f, bool walkableOnly = false) const;
         float GetMinHeight(float x, float y) const;
         float GetGridMapHeight(float x, float y) const;
+        // GetGridMapHeight for count points at once, consecutive points in the same grid are sampled together
+        void GetGridMapHeights(float const* x, float const* y, float* heights, uint32 count) const;
         float GetVMapFloor(float x, float y, float z, float maxSearchDist = DEFAULT_HEIGHT_SEARCH, float collisionHeight = 0.0f) const;
         /* Get map level (checking vmaps) or liquid level at given point */
         float GetWaterOrGroundLevel(uint32 phasemask, float x, float y, float z, float* ground = nullptr, bool swim = false, float collisionHeight = 2.03128f, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const; // 2.03128f = DEFAULT_COLLISION_HEIGHT in Object.h
@@ -287,6 +291,10 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         Transport* GetTransportForPos(uint32 phase, float x, float y, float z, WorldObject* worldobject = nullptr);
 
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+        // isInLineOfSight from one origin to count targets, the vmap rays of the fan are cast together. Sets results[i] for each target
+        void isInLineOfSight(float x1, float y1, float z1, Position const* targets, uint32 count, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags, bool* results) const;
+        // Forgets the line of sight results of this update, to call when the dynamic collision changes
+        void InvalidateLineOfSightCache() { _lineOfSightCache.Invalidate(); }
         void Balance() { _dynamicTree.balance(); }
         //get dynamic collision (gameobjects only ?)
         bool getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist);
@@ -780,6 +788,10 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         uint32 _respawnCheckTimer;
         std::unordered_map<uint32, uint32> _zonePlayerCountMap;
 
+        // Delays the updates of creatures far from players and active objects
+        UpdateLODScheduler _updateLOD;
+        mutable LineOfSightCache _lineOfSightCache;
+
         ZoneDynamicInfoMap _zoneDynamicInfo;
         uint32 _defaultLight;
 
@@ -862,6 +874,9 @@ public:
     TestMap(std::weak_ptr<TestThread>& testThread, uint32 id, uint32 InstanceId, uint8 spawnMode, Map* parent, bool enableMapObjects);
     ~TestMap();
     void Update(const uint32&) override;
+    void DelayedUpdate(const uint32 diff) override;
+    //Update and delayed update, called by TestMgr workers when test is decoupled from world updates
+    void UpdateDecoupled(uint32 diff);
     void RemoveAllPlayers() override;
     bool AddPlayerToMap(Player *) override;
     bool CanUnload(uint32 diff) override;
@@ -870,6 +885,9 @@ public:
     Player* GetFirstHumanPlayer();
 
 private:
+    //Returns the diff the map was updated with, 0 if it was not updated (test paused or not ready)
+    uint32 _UpdateWithTest(TestThread& testThread, uint32 diff);
+
     std::weak_ptr<TestThread> _testThread; //TestMap will use the TestThread for some time sync with the test waits
 };
 
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2008-2019 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "UpdateLOD.h"
+#include "Creature.h"
+#include "GridDefines.h"
+#include "World.h"
+#include <algorithm>
+#include <cmath>
+
+void CreatureUpdateLODStats::Add(CreatureUpdateLODStats const& other)
+{
+    for (uint8 i = 0; i < MAX_UPDATE_LOD; ++i)
+    {
+        updates[i] += other.updates[i];
+        skipped[i] += other.skipped[i];
+    }
+}
+
+UpdateLODScheduler::UpdateLODScheduler() : _enabled(false), _visitingPlayerCells(false), _distances(), _intervals(), _gridRadius(0)
+{
+}
+
+void UpdateLODScheduler::Reset(float visibilityRange)
+{
+    _sources.clear();
+    _stats = CreatureUpdateLODStats();
+    _visitingPlayerCells = false;
+
+    _enabled = sWorld->getBoolConfig(CONFIG_UPDATE_LOD_ENABLED);
+    if (!_enabled)
+        return;
+
+    float const farDistance = std::max(float(sWorld->getIntConfig(CONFIG_UPDATE_LOD_FAR_DISTANCE)), visibilityRange);
+    _distances[UPDATE_LOD_FULL] = 0.0f;
+    _distances[UPDATE_LOD_MID] = visibilityRange * visibilityRange;
+    _distances[UPDATE_LOD_FAR] = farDistance * farDistance;
+    _intervals[UPDATE_LOD_FULL] = 0;
+    _intervals[UPDATE_LOD_MID] = sWorld->getIntConfig(CONFIG_UPDATE_LOD_MID_INTERVAL);
+    _intervals[UPDATE_LOD_FAR] = sWorld->getIntConfig(CONFIG_UPDATE_LOD_FAR_INTERVAL);
+    // sources further than the far distance do not change the tier
+    _gridRadius = int32(std::ceil(farDistance / SIZE_OF_GRIDS));
+}
+
+void UpdateLODScheduler::AddSource(WorldObject const* source)
+{
+    if (!_enabled || !source->IsPositionValid())
+        return;
+
+    GridCoord const grid = Trinity::ComputeGridCoord(source->GetPositionX(), source->GetPositionY());
+    _sources[grid.GetId()].push_back({ source->GetPositionX(), source->GetPositionY(), source->GetPositionZ() });
+}
+
+uint32 UpdateLODScheduler::Schedule(Creature* creature, uint32 diff)
+{
+    if (!_enabled)
+        return diff;
+
+    CreatureUpdateLODState& state = creature->GetUpdateLODState();
+    state.pendingDiff += diff;
+
+    if (_visitingPlayerCells || creature->IsEngaged() || creature->isActiveObject() || creature->GetCharmerOrOwnerGUID().IsPlayer())
+    {
+        state.lod = UPDATE_LOD_FULL;
+        state.checkTimer = 0;
+    }
+    else if (state.checkTimer <= diff)
+    {
+        state.lod = ComputeLOD(creature);
+        state.checkTimer = UPDATE_LOD_CHECK_INTERVAL;
+    }
+    else
+        state.checkTimer -= diff;
+
+    if (state.pendingDiff < _intervals[state.lod])
+    {
+        ++_stats.skipped[state.lod];
+        return 0;
+    }
+
+    ++_stats.updates[state.lod];
+    uint32 const updateDiff = state.pendingDiff;
+    state.pendingDiff = 0;
+    return updateDiff;
+}
+
+UpdateLOD UpdateLODScheduler::ComputeLOD(Creature const* creature) const
+{
+    if (!creature->IsPositionValid())
+        return UPDATE_LOD_FULL;
+
+    float const x = creature->GetPositionX();
+    float const y = creature->GetPositionY();
+    float const z = creature->GetPositionZ();
+    GridCoord const grid = Trinity::ComputeGridCoord(x, y);
+
+    float minDistance = _distances[UPDATE_LOD_FAR];
+    for (int32 gridX = int32(grid.x_coord) - _gridRadius; gridX <= int32(grid.x_coord) + _gridRadius; ++gridX)
+    {
+        for (int32 gridY = int32(grid.y_coord) - _gridRadius; gridY <= int32(grid.y_coord) + _gridRadius; ++gridY)
+        {
+            if (gridX < 0 || gridY < 0 || gridX >= MAX_NUMBER_OF_GRIDS || gridY >= MAX_NUMBER_OF_GRIDS)
+                continue;
+
+            auto itr = _sources.find(GridCoord(gridX, gridY).GetId());
+            if (itr == _sources.end())
+                continue;
+
+            for (SourcePosition const& source : itr->second)
+            {
+                float const dx = source.x - x;
+                float const dy = source.y - y;
+                float const dz = source.z - z;
+                minDistance = std::min(minDistance, dx * dx + dy * dy + dz * dz);
+            }
+        }
+    }
+
+    if (minDistance < _distances[UPDATE_LOD_MID])
+        return UPDATE_LOD_FULL;
+    if (minDistance < _distances[UPDATE_LOD_FAR])
+        return UPDATE_LOD_MID;
+    return UPDATE_LOD_FAR;
+}
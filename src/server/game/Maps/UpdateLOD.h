@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2008-2019 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_UPDATE_LOD_H
+#define TRINITY_UPDATE_LOD_H
+
+#include "Define.h"
+#include <unordered_map>
+#include <vector>
+
+class Creature;
+class WorldObject;
+
+/*
+Creatures out of sight of every player are updated less often, with the diffs accumulated in
+between. Creatures in the cells a player (or its viewpoint) activates are always updated at full
+rate, the tiers only apply to the creatures the map updates further away: around active objects,
+or around creatures in combat with a player. Their tier is checked again every
+UPDATE_LOD_CHECK_INTERVAL from the distance to the nearest player or active object, creatures in
+combat or owned by a player are always updated at every map update.
+*/
+enum UpdateLOD : uint8
+{
+    UPDATE_LOD_FULL = 0,
+    UPDATE_LOD_MID  = 1,
+    UPDATE_LOD_FAR  = 2,
+
+    MAX_UPDATE_LOD
+};
+
+uint32 const UPDATE_LOD_CHECK_INTERVAL = 1000;
+
+// Per creature state, see UpdateLODScheduler::Schedule
+struct CreatureUpdateLODState
+{
+    UpdateLOD lod = UPDATE_LOD_FULL;
+    uint32 pendingDiff = 0;
+    uint32 checkTimer = 0;
+};
+
+struct CreatureUpdateLODStats
+{
+    uint64 updates[MAX_UPDATE_LOD] = { };
+    uint64 skipped[MAX_UPDATE_LOD] = { };
+
+    void Add(CreatureUpdateLODStats const& other);
+};
+
+class TC_GAME_API UpdateLODScheduler
+{
+public:
+    UpdateLODScheduler();
+
+    // Reads the config and clears the sources and stats, to call before each map update.
+    // Tiers start at the visibility range of the map.
+    void Reset(float visibilityRange);
+    // Creatures within visibility range of a source are updated at full rate
+    void AddSource(WorldObject const* source);
+    // While set, the visited creatures are in sight of a player and updated at full rate
+    void SetVisitingPlayerCells(bool visiting) { _visitingPlayerCells = visiting; }
+
+    bool IsEnabled() const { return _enabled; }
+
+    // Returns the diff to update the creature with, 0 if its update is delayed
+    uint32 Schedule(Creature* creature, uint32 diff);
+
+    CreatureUpdateLODStats const& GetStats() const { return _stats; }
+
+private:
+    struct SourcePosition
+    {
+        float x, y, z;
+    };
+
+    UpdateLOD ComputeLOD(Creature const* creature) const;
+
+    bool _enabled;
+    bool _visitingPlayerCells;
+    float _distances[MAX_UPDATE_LOD]; // squared distance from which a tier is used
+    uint32 _intervals[MAX_UPDATE_LOD];
+    int32 _gridRadius;
+
+    // sources by grid id
+    std::unordered_map<uint32, std::vector<SourcePosition>> _sources;
+    CreatureUpdateLODStats _stats;
+};
+
+#endif
@@ -220,9 +220,12 @@ void WorldSession::HandleWhoOpcode( WorldPacket & recvData )
     data << uint32(matchCount); //placeholder, will be overriden later
     data << uint32(displaycount);
 
-    WhoListInfoVector const& whoList = sWhoListStorageMgr->GetWhoList();
-    for (WhoListPlayerInfo const& target : whoList)
+    WhoListInfoVector whoList;
+    sWhoListStorageMgr->GetCandidates(levelMin, levelMax, zoneids, zonesCount, wplayer_name, whoList);
+    for (std::shared_ptr<WhoListPlayerInfo const> const& candidate : whoList)
     {
+        WhoListPlayerInfo const& target = *candidate;
+
         if (security == SEC_PLAYER)
         {
             // player can see member of other team only if CONFIG_ALLOW_TWO_SIDE_WHO_LIST
@@ -276,20 +279,14 @@ void WorldSession::HandleWhoOpcode( WorldPacket & recvData )
         if (!z_show)
             continue;
 
-        std::string pname = target.GetPlayerName();
-        std::wstring wpname;
-        if(!Utf8toWStr(pname,wpname))
-            continue;
-        wstrToLower(wpname);
+        std::string const& pname = target.GetPlayerName();
+        std::wstring const& wpname = target.GetWidePlayerName();
 
         if (!(wplayer_name.empty() || wpname.find(wplayer_name) != std::wstring::npos))
             continue;
 
-        std::string gname = target.GetGuildName();
-        std::wstring wgname;
-        if(!Utf8toWStr(gname,wgname))
-            continue;
-        wstrToLower(wgname);
+        std::string const& gname = target.GetGuildName();
+        std::wstring const& wgname = target.GetWideGuildName();
 
         if (!(wguild_name.empty() || wgname.find(wguild_name) != std::wstring::npos))
             continue;
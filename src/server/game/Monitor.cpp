@@ -5,6 +5,7 @@
 #include "Language.h"
 #include "Chat.h"
 #include "Player.h"
+#include "MMapFactory.h"
 
 Monitor::Monitor()
     : _worldTickCount(0),
@@ -283,6 +284,75 @@ uint32 Monitor::GetLastDiffForMap(Map const& map)
     return itr->second;
 }
 
+MMAP::NavMeshQueryPoolStats Monitor::GetNavMeshQueryPoolStats() const
+{
+    return MMAP::MMapFactory::createOrGetMMapManager()->GetNavMeshQueryPoolStats();
+}
+
+CreatureUpdateLODStats Monitor::GetCreatureUpdateLODStats() const
+{
+    std::lock_guard<std::mutex> lock(_creatureUpdateLODStatsLock);
+    return _creatureUpdateLODStats;
+}
+
+void Monitor::AddCreatureUpdateLODStats(CreatureUpdateLODStats const& stats)
+{
+    std::lock_guard<std::mutex> lock(_creatureUpdateLODStatsLock);
+    _creatureUpdateLODStats.Add(stats);
+}
+
+LineOfSightCacheStats Monitor::GetLineOfSightCacheStats() const
+{
+    std::lock_guard<std::mutex> lock(_lineOfSightCacheStatsLock);
+    return _lineOfSightCacheStats;
+}
+
+void Monitor::AddLineOfSightCacheStats(LineOfSightCacheStats const& stats)
+{
+    std::lock_guard<std::mutex> lock(_lineOfSightCacheStatsLock);
+    _lineOfSightCacheStats.Add(stats);
+}
+
+LoginBatchStats Monitor::GetLoginBatchStats() const
+{
+    std::lock_guard<std::mutex> lock(_loginBatchStatsLock);
+    return _loginBatchStats;
+}
+
+void Monitor::AddLoginBatchStats(LoginBatchStats const& stats)
+{
+    std::lock_guard<std::mutex> lock(_loginBatchStatsLock);
+    _loginBatchStats.Add(stats);
+}
+
+ObjectPoolStats Monitor::GetObjectPoolStats() const
+{
+    ObjectPoolStats stats;
+    for (ObjectPool const* pool : ObjectPool::GetPools())
+        stats.Add(pool->GetStats());
+    return stats;
+}
+
+QueryLatencyStats Monitor::GetQueryLatencyStats() const
+{
+    QueryLatencyStats stats;
+    for (auto const& itr : QueryCallbackProcessor::GetLatencyStats())
+        stats.Add(itr.second);
+    return stats;
+}
+
+PlayerSaveStats Monitor::GetPlayerSaveStats() const
+{
+    std::lock_guard<std::mutex> lock(_playerSaveStatsLock);
+    return _playerSaveStats;
+}
+
+void Monitor::AddPlayerSaveStats(PlayerSaveStats const& stats)
+{
+    std::lock_guard<std::mutex> lock(_playerSaveStatsLock);
+    _playerSaveStats.Add(stats);
+}
+
 void MonitorAutoReboot::Update(uint32 diff)
 {
     uint32 searchCount = sWorld->getConfig(CONFIG_MONITORING_LAG_AUTO_REBOOT_COUNT);
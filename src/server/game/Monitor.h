@@ -2,11 +2,22 @@
 #define __MONITOR_H
 
 #include "Common.h"
+#include "UpdateLOD.h"
+#include "LineOfSightCache.h"
+#include "LoginQueryBatcher.h"
+#include "ObjectPool.h"
+#include "QueryCallbackProcessor.h"
+#include "PlayerSaveState.h"
 #include <unordered_map>
 #include <mutex>
 
 class Map;
 
+namespace MMAP
+{
+    struct NavMeshQueryPoolStats;
+}
+
 /*
 Ideas:
 - Allow to trigger profiling at next udpate, by command or automatically every X according to config
@@ -116,6 +127,35 @@ public:
 
 	// Flattened timediff upated every minute. This is a cached value.
 	uint32 GetSmoothTimeDiff() const { return smoothTD.Get(); }
+
+	// Hits/misses/node exhaustion of the per thread navmesh query pools, since startup
+	MMAP::NavMeshQueryPoolStats GetNavMeshQueryPoolStats() const;
+
+	// Creature updates done and delayed for each update level of detail, since startup
+	CreatureUpdateLODStats GetCreatureUpdateLODStats() const;
+	// Called by maps after updating their creatures
+	void AddCreatureUpdateLODStats(CreatureUpdateLODStats const& stats);
+
+	// Hits/misses of the maps line of sight caches, since startup
+	LineOfSightCacheStats GetLineOfSightCacheStats() const;
+	// Called by maps after their update
+	void AddLineOfSightCacheStats(LineOfSightCacheStats const& stats);
+
+	// Logins, login batches and login latency, since startup
+	LoginBatchStats GetLoginBatchStats() const;
+	// Called by the login query batcher and by sessions once their character is loaded
+	void AddLoginBatchStats(LoginBatchStats const& stats);
+
+	// Allocations and reuses of the spell and aura object pools, since startup
+	ObjectPoolStats GetObjectPoolStats() const;
+
+	// Latency of the async queries of all databases and statements, since startup
+	QueryLatencyStats GetQueryLatencyStats() const;
+
+	// Character saves and the rows they wrote or skipped, since startup
+	PlayerSaveStats GetPlayerSaveStats() const;
+	// Called by players after each save
+	void AddPlayerSaveStats(PlayerSaveStats const& stats);
 private:
 	// -- MapUpdater & World functions
 	void MapUpdateStart(Map const& map);
@@ -155,6 +195,15 @@ private:
 	MonitorAlert      _monitAlert;
 
 	SmoothedTimeDiff smoothTD;
+
+	mutable std::mutex _creatureUpdateLODStatsLock;
+	CreatureUpdateLODStats _creatureUpdateLODStats;
+	mutable std::mutex _lineOfSightCacheStatsLock;
+	LineOfSightCacheStats _lineOfSightCacheStats;
+	mutable std::mutex _loginBatchStatsLock;
+	LoginBatchStats _loginBatchStats;
+	mutable std::mutex _playerSaveStatsLock;
+	PlayerSaveStats _playerSaveStats;
 };
 
 #define sMonitor Monitor::instance()
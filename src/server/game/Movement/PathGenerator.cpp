@@ -90,17 +90,14 @@ bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool fo
     if (_transport)
         _transport->CalculatePassengerOffset(destX, destY, destZ);
 
-    if (!_navMeshQuery || !_navMesh)
-    {
-        MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
-        if (_transport)
-            _navMeshQuery = mmap->GetModelNavMeshQuery(_transport->GetDisplayId());
-        else
-            _navMeshQuery = mmap->GetNavMeshQuery(_sourceMapId, _sourceInstanceId);
+    // queries are owned by the calling thread, always fetch it again since the map may have been moved to another update thread
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+    if (_transport)
+        _navMeshQuery = mmap->GetModelNavMeshQuery(_transport->GetDisplayId());
+    else
+        _navMeshQuery = mmap->GetNavMeshQuery(_sourceMapId, _sourceInstanceId);
 
-        if (_navMeshQuery)
-            _navMesh = _navMeshQuery->getAttachedNavMesh();
-    }
+    _navMesh = _navMeshQuery ? _navMeshQuery->getAttachedNavMesh() : nullptr;
 
     //reset last result if any
     _type = PATHFIND_BLANK;
@@ -445,6 +442,9 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
                             _pathPolyRefs + prefixPolyLength - 1,    // [out] path
                             (int*)&suffixPolyLength,
                             MAX_PATH_LENGTH - prefixPolyLength);   // max number of polygons in output path
+
+            if (dtStatusDetail(dtResult, DT_OUT_OF_NODES))
+                MMAP::MMapFactory::createOrGetMMapManager()->ReportNavMeshQueryExhausted();
         }
 
         if (!suffixPolyLength || dtStatusFailed(dtResult))
@@ -511,6 +511,9 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
                             _pathPolyRefs,     // [out] path
                             (int*)&_polyLength,
                             MAX_PATH_LENGTH);   // max number of polygons in output path
+
+            if (dtStatusDetail(dtResult, DT_OUT_OF_NODES))
+                MMAP::MMapFactory::createOrGetMMapManager()->ReportNavMeshQueryExhausted();
         }
 
         if (!_polyLength || dtStatusFailed(dtResult))
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2008-2019 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LoginQueryBatcher.h"
+#include "DatabaseEnv.h"
+#include "Monitor.h"
+#include "Player.h"
+#include "Timer.h"
+#include "World.h"
+
+// Login queries loaded for the whole batch. The others (aggregates, limits, optional queries) are executed for each character
+static std::pair<PlayerLoginQueryIndex, CharacterDatabaseStatements> const LoginBatchQueries[] =
+{
+    { PLAYER_LOGIN_QUERY_LOAD_FROM,                 CHAR_SEL_CHARACTER_BATCH                        },
+    { PLAYER_LOGIN_QUERY_LOAD_GROUP,                CHAR_SEL_GROUP_MEMBER_BATCH                     },
+    { PLAYER_LOGIN_QUERY_LOAD_BOUND_INSTANCES,      CHAR_SEL_CHARACTER_INSTANCE_BATCH               },
+    { PLAYER_LOGIN_QUERY_LOAD_AURAS,                CHAR_SEL_CHARACTER_AURAS_BATCH                  },
+    { PLAYER_LOGIN_QUERY_LOAD_SPELLS,               CHAR_SEL_CHARACTER_SPELL_BATCH                  },
+    { PLAYER_LOGIN_QUERY_LOAD_QUEST_STATUS,         CHAR_SEL_CHARACTER_QUESTSTATUS_BATCH            },
+    { PLAYER_LOGIN_QUERY_LOAD_DAILY_QUEST_STATUS,   CHAR_SEL_CHARACTER_QUESTSTATUS_DAILY_BATCH      },
+    { PLAYER_LOGIN_QUERY_LOAD_SEASONAL_QUEST_STATUS,CHAR_SEL_CHARACTER_QUESTSTATUS_SEASONAL_BATCH   },
+    { PLAYER_LOGIN_QUERY_LOAD_REPUTATION,           CHAR_SEL_CHARACTER_REPUTATION_BATCH             },
+    { PLAYER_LOGIN_QUERY_LOAD_INVENTORY,            CHAR_SEL_CHARACTER_INVENTORY_BATCH              },
+    { PLAYER_LOGIN_QUERY_LOAD_ACTIONS,              CHAR_SEL_CHARACTER_ACTIONS_BATCH                },
+    { PLAYER_LOGIN_QUERY_LOAD_HOME_BIND,            CHAR_SEL_CHARACTER_HOMEBIND_BATCH               },
+    { PLAYER_LOGIN_QUERY_LOAD_SPELL_COOLDOWNS,      CHAR_SEL_CHARACTER_SPELLCOOLDOWNS_BATCH         },
+    { PLAYER_LOGIN_QUERY_LOAD_GUILD,                CHAR_SEL_GUILD_MEMBER_BATCH                     },
+    { PLAYER_LOGIN_QUERY_LOAD_ARENA_INFO,           CHAR_SEL_CHARACTER_ARENAINFO_BATCH              },
+    { PLAYER_LOGIN_QUERY_LOAD_SKILLS,               CHAR_SEL_CHARACTER_SKILLS_BATCH                 },
+    { PLAYER_LOGIN_QUERY_LOAD_BG_DATA,              CHAR_SEL_CHARACTER_BGDATA_BATCH                 },
+    { PLAYER_LOGIN_QUERY_LOAD_CORPSE_LOCATION,      CHAR_SEL_CORPSE_LOCATION_BATCH                  },
+    { PLAYER_LOGIN_QUERY_LOAD_QUEST_STATUS_REW,     CHAR_SEL_CHARACTER_QUESTSTATUSREW_BATCH         },
+};
+
+void LoginBatchStats::Add(LoginBatchStats const& other)
+{
+    logins += other.logins;
+    batches += other.batches;
+    batchedLogins += other.batchedLogins;
+    latencySum += other.latencySum;
+    latencyMax = std::max(latencyMax, other.latencyMax);
+}
+
+LoginQueryBatcher::LoginQueryBatcher() : _pendingTime(0)
+{
+}
+
+LoginQueryBatcher* LoginQueryBatcher::instance()
+{
+    static LoginQueryBatcher instance;
+    return &instance;
+}
+
+QueryResultHolderFuture LoginQueryBatcher::Enqueue(LoginQueryHolder* holder)
+{
+    holder->SetQueueTime(GetMSTime());
+
+    uint32 const batchSize = sWorld->getIntConfig(CONFIG_LOGIN_BATCH_SIZE);
+    if (batchSize <= 1)
+        return CharacterDatabase.DelayQueryHolder(holder);
+
+    std::lock_guard<std::mutex> lock(_lock);
+    if (!_pending)
+    {
+        _pending = std::make_unique<SQLQueryHolderBatch>();
+        _pendingTime = 0;
+    }
+
+    QueryResultHolderFuture future = _pending->AddHolder(holder, holder->GetGuid().GetCounter());
+    if (_pending->GetSize() >= batchSize)
+        _Flush();
+
+    return future;
+}
+
+void LoginQueryBatcher::Update(uint32 diff)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (!_pending)
+        return;
+
+    _pendingTime += diff;
+    if (_pendingTime >= sWorld->getIntConfig(CONFIG_LOGIN_BATCH_WINDOW))
+        _Flush();
+}
+
+void LoginQueryBatcher::Flush()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _Flush();
+}
+
+void LoginQueryBatcher::_Flush()
+{
+    if (!_pending)
+        return;
+
+    SQLQueryHolderBatch* batch = _pending.release();
+    for (auto const& batchQuery : LoginBatchQueries)
+    {
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(batchQuery.second);
+        for (uint32 i = 0; i < LOGIN_QUERY_BATCH_SIZE; ++i)
+            stmt->setUInt32(i, i < batch->GetSize() ? batch->GetKey(i) : 0);
+        batch->AddBatchedQuery(batchQuery.first, stmt);
+    }
+
+    LoginBatchStats stats;
+    stats.batches = 1;
+    stats.batchedLogins = batch->GetSize();
+    sMonitor->AddLoginBatchStats(stats);
+
+    CharacterDatabase.DelayQueryHolderBatch(batch);
+}
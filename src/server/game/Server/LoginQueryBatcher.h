@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2008-2019 TrinityCore <https://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_LOGIN_QUERY_BATCHER_H
+#define TRINITY_LOGIN_QUERY_BATCHER_H
+
+#include "Define.h"
+#include "DatabaseEnvFwd.h"
+#include <memory>
+#include <mutex>
+
+class LoginQueryHolder;
+
+struct LoginBatchStats
+{
+    uint64 logins = 0;
+    uint64 batches = 0;
+    uint64 batchedLogins = 0;
+    // time (ms) between the login request and the session handling the loaded character
+    uint64 latencySum = 0;
+    uint32 latencyMax = 0;
+
+    void Add(LoginBatchStats const& other);
+};
+
+/* Gathers the character logins requested during a short window and loads them together: most login
+   queries (PlayerLoginQueryIndex) are executed once for the whole batch with the guids of all its
+   characters (CHAR_SEL_*_BATCH statements), then their rows are dispatched to the holder of each character.
+   A batch is sent when it holds Login.Batch.Size logins or when its first login waited Login.Batch.Window ms.
+*/
+class TC_GAME_API LoginQueryBatcher
+{
+public:
+    static LoginQueryBatcher* instance();
+
+    // Queue the login queries of a character, the future is set once its batch is loaded.
+    // The holder is sent alone if batching is disabled.
+    QueryResultHolderFuture Enqueue(LoginQueryHolder* holder);
+    // Send the pending batch if its window elapsed
+    void Update(uint32 diff);
+    // Send the pending batch now, for callers waiting for their logins
+    void Flush();
+
+private:
+    LoginQueryBatcher();
+
+    void _Flush();
+
+    std::mutex _lock;
+    std::unique_ptr<SQLQueryHolderBatch> _pending;
+    uint32 _pendingTime;                            // time since the first pending login
+};
+
+#define sLoginQueryBatcher LoginQueryBatcher::instance()
+
+#endif
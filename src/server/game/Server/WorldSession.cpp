@@ -39,6 +39,7 @@
 #include "ReplayPlayer.h"
 #include "PlayerAntiCheat.h"
 #include "GuildMgr.h"
+#include "WhoListStorage.h"
 
 #ifdef PLAYERBOT
 #include "playerbot.h"
@@ -121,6 +122,8 @@ m_playerLogout(false),
 m_playerRecentlyLogout(false),
 m_playerSave(false),
 m_latency(0),
+m_sentPacketCount(0),
+m_sentPacketBytes(0),
 m_TutorialsChanged(false),
 _warden(nullptr),
 forceExit(false),
@@ -194,6 +197,9 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 {
     ASSERT(packet->GetOpcode() != NULL_OPCODE);
 
+    m_sentPacketCount.fetch_add(1, std::memory_order_relaxed);
+    m_sentPacketBytes.fetch_add(packet->size(), std::memory_order_relaxed);
+
 #ifdef PLAYERBOT
     // Playerbot mod: send packet to bot AI
     if (GetPlayer())
@@ -915,6 +921,15 @@ std::string WorldSession::GetLocalizedItemName(uint32 itemId)
         return std::string();
 }
 
+void WorldSession::SetSecurity(AccountTypes security)
+{
+    _security = security;
+
+    // who list shows and filters players by security
+    if (_player)
+        sWhoListStorageMgr->MarkDirty(_player->GetGUID());
+}
+
 std::string WorldSession::GetPlayerInfo() const
 {
     std::ostringstream ss;
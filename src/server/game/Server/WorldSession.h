@@ -266,7 +266,7 @@ class TC_GAME_API WorldSession
         std::string GetPlayerInfo() const;
 
         ObjectGuid::LowType GetGUIDLow() const;
-        void SetSecurity(AccountTypes security) { _security = security; }
+        void SetSecurity(AccountTypes security);
         std::string const& GetRemoteAddress() const { return m_Address; }
         void SetPlayer(Player *plr) { _player = plr; }
         uint8 Expansion() const { return m_expansion; }
@@ -425,6 +425,9 @@ class TC_GAME_API WorldSession
 
         // Latency from ping-pong
         uint32 GetLatency() const { return m_latency; }
+        // Packets and bytes sent to this session since its creation, with or without a socket
+        uint64 GetSentPacketCount() const { return m_sentPacketCount.load(std::memory_order_relaxed); }
+        uint64 GetSentPacketBytes() const { return m_sentPacketBytes.load(std::memory_order_relaxed); }
         void SetLatency(uint32 latency) { m_latency = latency; }
 
         // Estimation of latency for this client, handled with CMSG_TIME_SYNC_RESP
@@ -1035,6 +1038,8 @@ class TC_GAME_API WorldSession
         LocaleConstant m_sessionDbcLocale;
         LocaleConstant m_sessionDbLocaleIndex;
         uint32 m_latency;
+        std::atomic<uint64> m_sentPacketCount;          // SendPacket runs in the world and map threads
+        std::atomic<uint64> m_sentPacketBytes;
         
         AccountData m_accountData[NUM_ACCOUNT_DATA_TYPES];
         uint32 m_Tutorials[MAX_ACCOUNT_TUTORIAL_VALUES];
@@ -24,6 +24,7 @@
 #include "ScriptMgr.h"
 #include "ReputationMgr.h"
 #include "GameTime.h"
+#include "ObjectPool.h"
 #include <numeric>
 
 //
@@ -305,6 +306,22 @@ pAuraEffectHandler AuraEffectHandler[TOTAL_AURAS] =
     &AuraEffect::HandleNULL                                       //261 SPELL_AURA_261 some phased state (44856 spell)
 };
 
+static ObjectPool& GetAuraEffectPool()
+{
+    static ObjectPool* pool = new ObjectPool("AuraEffect", sizeof(AuraEffect), 1024);
+    return *pool;
+}
+
+void* AuraEffect::operator new(std::size_t size)
+{
+    return GetAuraEffectPool().Allocate(size);
+}
+
+void AuraEffect::operator delete(void* ptr)
+{
+    ObjectPool::Free(ptr);
+}
+
 AuraEffect::AuraEffect(Aura* base, uint8 effIndex, int32 const* baseAmount, Unit* caster) :
     m_base(base), m_spellInfo(base->GetSpellInfo()),
     m_baseAmount(baseAmount ? *baseAmount : m_spellInfo->Effects[effIndex].BasePoints),
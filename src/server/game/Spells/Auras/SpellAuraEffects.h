@@ -19,6 +19,10 @@ class TC_GAME_API AuraEffect
         ~AuraEffect();
         explicit AuraEffect(Aura* base, uint8 effIndex, int32 const* baseAmount, Unit* caster);
     public:
+        // allocated from an ObjectPool
+        static void* operator new(std::size_t size);
+        static void operator delete(void* ptr);
+
         Unit* GetCaster() const { return GetBase()->GetCaster(); }
         ObjectGuid GetCasterGUID() const { return GetBase()->GetCasterGUID(); }
         Aura* GetBase() const { return m_base; }
@@ -33,6 +33,7 @@
 #include "SpellScript.h"
 #include "ScriptMgr.h"
 #include "SpellHistory.h"
+#include "ObjectPool.h"
 
 AuraCreateInfo::AuraCreateInfo(SpellInfo const* spellInfo, uint8 auraEffMask, WorldObject* owner) :
     _spellInfo(spellInfo), _auraEffectMask(auraEffMask), _owner(owner)
@@ -110,6 +111,22 @@ void AuraApplication::_UpdateSlot()
 #endif
 }
 
+static ObjectPool& GetAuraApplicationPool()
+{
+    static ObjectPool* pool = new ObjectPool("AuraApplication", sizeof(AuraApplication), 1024);
+    return *pool;
+}
+
+void* AuraApplication::operator new(std::size_t size)
+{
+    return GetAuraApplicationPool().Allocate(size);
+}
+
+void AuraApplication::operator delete(void* ptr)
+{
+    ObjectPool::Free(ptr);
+}
+
 AuraApplication::AuraApplication(Unit* target, Unit* caster, Aura* aura, uint8 effMask) :
     _target(target), _base(aura), _removeMode(AURA_REMOVE_NONE), _slot(MAX_AURAS), _positive(false), _effectMask(0), _selfCast(false),
     _flags(AFLAG_NONE), _effectsToApply(effMask), _needClientUpdate(false), _durationChanged(true)
@@ -493,6 +510,22 @@ void AuraApplication::ClientUpdate(bool remove)
 #endif
 }
 
+static ObjectPool& GetAuraPool()
+{
+    static ObjectPool* pool = new ObjectPool("Aura", std::max(sizeof(UnitAura), sizeof(DynObjAura)), 512);
+    return *pool;
+}
+
+void* Aura::operator new(std::size_t size)
+{
+    return GetAuraPool().Allocate(size);
+}
+
+void Aura::operator delete(void* ptr)
+{
+    ObjectPool::Free(ptr);
+}
+
 Aura::Aura(AuraCreateInfo const& createInfo) :
 m_procCharges(0), m_stackAmount(1), m_isRemoved(false), m_casterGuid(createInfo.CasterGUID),
 m_timeCla(0), m_castItemGuid(createInfo.CastItemGUID),
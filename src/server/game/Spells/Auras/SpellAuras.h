@@ -59,6 +59,10 @@ private:
     void _HandleEffect(uint8 effIndex, bool apply);
 
 public:
+    // allocated from an ObjectPool
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr);
+
     Unit * GetTarget() const { return _target; }
     Aura* GetBase() const { return _base; }
 
@@ -123,6 +127,9 @@ public:
     static Aura* TryCreate(AuraCreateInfo& createInfo);
     static Aura* Create(AuraCreateInfo& createInfo);
     explicit Aura(AuraCreateInfo const& createInfo);
+    // allocated from an ObjectPool, shared by UnitAura and DynObjAura
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr);
     void _InitEffects(uint8 effMask, Unit* caster, int32 const* baseAmount);
     void SaveCasterInfo(Unit* caster);
     virtual ~Aura();
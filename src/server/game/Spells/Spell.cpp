@@ -37,6 +37,7 @@
 #include "SpellHistory.h"
 #include "SpellPackets.h"
 #include "TradeData.h"
+#include "ObjectPool.h"
 
 extern SpellEffectHandlerFn SpellEffectHandlers[TOTAL_SPELL_EFFECTS];
 
@@ -690,6 +691,22 @@ void Spell::RecalculateDelayMomentForDst()
     m_caster->m_Events.ModifyEventTime(_spellEvent, GetDelayStart() + m_delayMoment);
 }
 
+static ObjectPool& GetSpellPool()
+{
+    static ObjectPool* pool = new ObjectPool("Spell", sizeof(Spell), 128);
+    return *pool;
+}
+
+void* Spell::operator new(std::size_t size)
+{
+    return GetSpellPool().Allocate(size);
+}
+
+void Spell::operator delete(void* ptr)
+{
+    ObjectPool::Free(ptr);
+}
+
 Spell::~Spell()
 {
     // unload scripts
@@ -1375,6 +1392,24 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
             Trinity::Containers::RandomResize(targets, maxTargets);
         }
 
+        // the line of sight of every unit to the center is checked by CheckEffectTarget, cast all the rays at once
+        if (!m_spellInfo->HasAttribute(SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS) && !IsTriggered())
+        {
+            std::vector<WorldObject const*> units;
+            units.reserve(targets.size());
+            for (WorldObject* target : targets)
+                if (target->ToUnit() && m_caster->IsInMap(target))
+                    units.push_back(target);
+
+            if (units.size() > 1)
+            {
+                std::unique_ptr<bool[]> inLOS(new bool[units.size()]);
+                WorldObject::AreWithinLOS(units.data(), units.size(), center->GetPositionX(), center->GetPositionY(), center->GetPositionZ(), LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::M2, inLOS.get());
+                for (uint32 i = 0; i < units.size(); ++i)
+                    m_areaTargetsInLOS[units[i]->GetGUID()] = inLOS[i];
+            }
+        }
+
         for (auto & target : targets)
         {
             if (Unit* newTarget = target->ToUnit())
@@ -1382,6 +1417,8 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
             else if (GameObject* gObjTarget = target->ToGameObject())
                 AddGOTarget(gObjTarget, effMask);
         }
+
+        m_areaTargetsInLOS.clear();
     }
 }
 
@@ -7717,7 +7754,13 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff, Position const* lo
     default:   // normal case
                                                        
         if (losPosition)
+        {
+            auto inLOS = m_areaTargetsInLOS.find(target->GetGUID());
+            if (inLOS != m_areaTargetsInLOS.end())
+                return inLOS->second;
+
             return target->IsWithinLOS(losPosition->GetPositionX(), losPosition->GetPositionY(), losPosition->GetPositionZ(), LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::M2);
+        }
         else
         {
             // Get GO cast coordinates if original caster -> GO
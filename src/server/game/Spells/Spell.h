@@ -296,6 +296,10 @@ class TC_GAME_API Spell
     friend class TestCase;
 
     public:
+        // allocated from an ObjectPool
+        static void* operator new(std::size_t size);
+        static void operator delete(void* ptr);
+
 
         void EffectNULL(uint32 );
         void EffectUnused(uint32 );
@@ -695,6 +699,7 @@ class TC_GAME_API Spell
         };
         std::vector<TargetInfo> m_UniqueTargetInfo;
         uint8 m_channelTargetEffectMask;                        // Mask req. alive targets
+        std::unordered_map<ObjectGuid, bool> m_areaTargetsInLOS;  // line of sight of the area targets being added to their center, see SelectImplicitAreaTargets
 
         struct GOTargetInfo : public TargetInfoBase
         {
@@ -351,16 +351,20 @@ struct TC_GAME_API ImmunityInfo
     boost::container::flat_set<SpellEffects> SpellEffectImmune;
 };
 
-class TC_GAME_API SpellInfo
+/**
+* Fields are ordered by how often they are read: the ones checked on every cast or proc come first,
+* in the first cache lines of the object, followed by the effects, then the data only used by some
+* casts (reagents, totems, items) and the data only used for display (visuals, icons, names).
+* Names and ranks are not copied, they point to the SpellEntry strings.
+* SpellMgr keeps all SpellInfo loaded at startup in one array ordered by spell id.
+*/
+class TC_GAME_API alignas(64) SpellInfo
 {
     friend class SpellMgr;
 
 public:
+    // hot: attributes, flags and masks tested by most checks
     uint32 Id;
-    //can be null
-    SpellCategoryEntry const* Category;
-    uint32 Dispel;
-    Mechanics Mechanic;
     uint32 Attributes;
     uint32 AttributesEx;
     uint32 AttributesEx2;
@@ -370,11 +374,51 @@ public:
     uint32 AttributesEx6;
     uint32 AttributesEx7; // LK field, not commented out so we can still use it if we want
     uint32 AttributesCu;
+    uint32 Targets;
+    uint32 ExplicitTargetMask;
+    uint32 SchoolMask;
+    uint32 DmgClass;
+    uint32 ProcFlags;
+    uint32 ProcChance;
+    uint32 ProcCharges;
+    uint32 InterruptFlags;
+    uint32 AuraInterruptFlags;
+    uint32 ChannelInterruptFlags;
+    uint32 PreventionType;
+    uint32 Dispel;
+    Mechanics Mechanic;
+    uint32 SpellFamilyName;
+#ifdef LICH_KING
+    flag96 SpellFamilyFlags;
+#else
+    uint64 SpellFamilyFlags;
+#endif
+    //can be null
+    SpellCastTimesEntry const* CastTimeEntry;
+    //can be null
+    SpellDurationEntry const* DurationEntry;
+    //can be null
+    SpellRangeEntry const* RangeEntry;
+    //can be null
+    SpellCategoryEntry const* Category;
+    SpellChainNode const* ChainEntry;
+    Powers PowerType;
+    uint32 ManaCost;
+    uint32 ManaCostPerlevel;
+    uint32 ManaPerSecond;
+    uint32 ManaPerSecondPerLevel;
+    uint32 ManaCostPercentage;
+    //uint32 RuneCostID; //LK
+    float  Speed;
+    uint32 StackAmount;
+    uint32 MaxAffectedTargets;
+    uint32 RecoveryTime;
+    uint32 CategoryRecoveryTime;
+    uint32 StartRecoveryCategory;
+    uint32 StartRecoveryTime;
     uint32 Stances;
     uint32 StancesNot;
-    uint32 Targets;
     uint32 TargetCreatureType;
-    uint32 RequiresSpellFocus;
     uint32 FacingCasterFlags;
     AuraStateType CasterAuraState;
     AuraStateType TargetAuraState;
@@ -386,42 +430,28 @@ public:
     uint32 ExcludeCasterAuraSpell;
     uint32 ExcludeTargetAuraSpell;
 #endif
-    //can be null
-    SpellCastTimesEntry const* CastTimeEntry;
-    uint32 RecoveryTime;
-    uint32 CategoryRecoveryTime;
-    uint32 StartRecoveryCategory;
-    uint32 StartRecoveryTime;
-    uint32 InterruptFlags;
-    uint32 AuraInterruptFlags;
-    uint32 ChannelInterruptFlags;
-    uint32 ProcFlags;
-    uint32 ProcChance;
-    uint32 ProcCharges;
     uint32 MaxLevel;
     uint32 BaseLevel; // = min level
     uint32 SpellLevel;
-    //can be null
-    SpellDurationEntry const* DurationEntry;
-    Powers PowerType;
-    uint32 ManaCost;
-    uint32 ManaCostPerlevel;
-    uint32 ManaPerSecond;
-    uint32 ManaPerSecondPerLevel;
-    uint32 ManaCostPercentage;
-    //uint32 RuneCostID; //LK
-    //can be null
-    SpellRangeEntry const* RangeEntry;
-    float  Speed;
-    uint32 StackAmount;
+    uint32 MaxTargetLevel;
+    SpellEffectInfo Effects[MAX_SPELL_EFFECTS];
+
+    // warm: requirements of some casts
+    uint32 RequiresSpellFocus;
+#ifdef LICH_KING
+    int32  AreaGroupId;
+#else
+    uint32 AreaId;
+#endif
     uint32 Totem[2];
     int32  Reagent[MAX_SPELL_REAGENTS];
     uint32 ReagentCount[MAX_SPELL_REAGENTS];
     int32  EquippedItemClass;
     int32  EquippedItemSubClassMask;
     int32  EquippedItemInventoryTypeMask;
-    //spell effects later
     uint32 TotemCategory[2];
+
+    // cold: display only
 #ifdef LICH_KING
     uint32 SpellVisual[2];
 #else
@@ -430,27 +460,8 @@ public:
     uint32 SpellIconID;
     uint32 ActiveIconID;
     uint32 Priority;
-    char* SpellName[16];
-    char* Rank[16];
-    uint32 MaxTargetLevel;
-    uint32 MaxAffectedTargets;
-    uint32 SpellFamilyName;
-#ifdef LICH_KING
-    flag96 SpellFamilyFlags;
-#else
-    uint64 SpellFamilyFlags;
-#endif
-    uint32 DmgClass;
-    uint32 PreventionType;
-#ifdef LICH_KING
-    int32  AreaGroupId;
-#else
-    uint32 AreaId;
-#endif
-    uint32 SchoolMask;
-    SpellEffectInfo Effects[MAX_SPELL_EFFECTS];
-    uint32 ExplicitTargetMask;
-    SpellChainNode const* ChainEntry;
+    char* const* SpellName;     // [16], strings of the SpellEntry
+    char* const* Rank;          // [16], strings of the SpellEntry
 
     SpellInfo(SpellEntry const* spellEntry);
     ~SpellInfo();
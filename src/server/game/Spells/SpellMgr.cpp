@@ -2847,11 +2847,17 @@ void SpellMgr::LoadSpellInfoStore(bool reload /* = false */)
     {
         UnloadSpellInfoStore();
 
-        auto lastSpell = sObjectMgr->GetSpellStore().rbegin();
+        SpellEntryStore const& spellStore = sObjectMgr->GetSpellStore();
+        auto lastSpell = spellStore.rbegin();
         mSpellInfoMap.resize(lastSpell->first + 1, nullptr); //fill with null pointers by default
 
-        for (auto i : sObjectMgr->GetSpellStore())
-            mSpellInfoMap[i.first] = new SpellInfo(i.second);
+        // reserved once, so that the SpellInfo never move
+        mSpellInfoStorage.reserve(spellStore.size());
+        for (auto const& i : spellStore)
+        {
+            mSpellInfoStorage.emplace_back(i.second);
+            mSpellInfoMap[i.first] = &mSpellInfoStorage.back();
+        }
     }
     else { //reload case
         // A lot of the core uses pointers to spellInfoMap so we can't just clear and refill it.
@@ -2893,10 +2899,15 @@ void SpellMgr::LoadSpellInfoStore(bool reload /* = false */)
 
 void SpellMgr::UnloadSpellInfoStore()
 {
+    // spells added by a reload were allocated one by one
+    SpellInfo const* storageBegin = mSpellInfoStorage.data();
+    SpellInfo const* storageEnd = storageBegin + mSpellInfoStorage.size();
     for (uint32 i = 0; i < GetSpellInfoStoreSize(); ++i)
-        delete mSpellInfoMap[i];
+        if (std::less<SpellInfo const*>()(mSpellInfoMap[i], storageBegin) || !std::less<SpellInfo const*>()(mSpellInfoMap[i], storageEnd))
+            delete mSpellInfoMap[i];
 
     mSpellInfoMap.clear();
+    mSpellInfoStorage.clear();
 }
 
 void SpellMgr::UnloadSpellInfoImplicitTargetConditionLists()
@@ -886,6 +886,8 @@ class TC_GAME_API SpellMgr
         SpellAreaForQuestAreaMap   mSpellAreaForQuestAreaMap;
 
         SpellInfoMap               mSpellInfoMap;
+        // SpellInfo loaded at startup, contiguous and ordered by id. mSpellInfoMap points into it, never grown after loading
+        std::vector<SpellInfo>     mSpellInfoStorage;
 };
 
 #define sSpellMgr SpellMgr::instance()
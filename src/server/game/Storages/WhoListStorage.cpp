@@ -5,6 +5,7 @@
 #include "Player.h"
 #include "WorldSession.h"
 #include "GuildMgr.h"
+#include <algorithm>
 
 WhoListStorageMgr* WhoListStorageMgr::instance()
 {
@@ -12,45 +13,196 @@ WhoListStorageMgr* WhoListStorageMgr::instance()
     return &instance;
 }
 
+void WhoListStorageMgr::MarkDirty(ObjectGuid guid)
+{
+    std::lock_guard<std::mutex> lock(_dirtyLock);
+    _dirty.insert(guid);
+}
+
 void WhoListStorageMgr::Update()
 {
-    // clear current list
-    _whoListStorage.clear();
-    _whoListStorage.reserve( (size_t) 1000 /*sWorld->GetPlayerCount()+1*/);
+    std::unordered_set<ObjectGuid> dirty;
+    {
+        std::lock_guard<std::mutex> lock(_dirtyLock);
+        dirty.swap(_dirty);
+    }
+
+    if (dirty.empty())
+        return;
+
+    std::vector<ObjectGuid> loading;
+    {
+        std::unique_lock<std::shared_mutex> lock(_indexLock);
+        for (ObjectGuid const& guid : dirty)
+        {
+            // players still loading are listed once loaded
+            if (!UpdatePlayer(guid) && ObjectAccessor::FindConnectedPlayer(guid))
+                loading.push_back(guid);
+        }
+    }
 
-    HashMapHolder<Player>::MapType const& m = ObjectAccessor::GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+    if (!loading.empty())
     {
-        if (!itr->second->FindMap() || itr->second->GetSession()->PlayerLoading())
-            continue;
+        std::lock_guard<std::mutex> lock(_dirtyLock);
+        _dirty.insert(loading.begin(), loading.end());
+    }
+}
+
+bool WhoListStorageMgr::UpdatePlayer(ObjectGuid guid)
+{
+    RemoveEntry(guid);
+
+    Player* player = ObjectAccessor::FindConnectedPlayer(guid);
+    if (!player || !player->FindMap() || player->GetSession()->PlayerLoading())
+        return false;
 
-        std::string playerName = itr->second->GetName();
-        std::wstring widePlayerName;
-        if (!Utf8toWStr(playerName, widePlayerName))
-            continue;
+    std::string playerName = player->GetName();
+    std::wstring widePlayerName;
+    if (!Utf8toWStr(playerName, widePlayerName))
+        return true;
 
-        wstrToLower(widePlayerName);
+    wstrToLower(widePlayerName);
 
-        std::string guildName = sGuildMgr->GetGuildNameById(itr->second->GetGuildId());
-        std::wstring wideGuildName;
-        if (!Utf8toWStr(guildName, wideGuildName))
-            continue;
+    std::string guildName = sGuildMgr->GetGuildNameById(player->GetGuildId());
+    std::wstring wideGuildName;
+    if (!Utf8toWStr(guildName, wideGuildName))
+        return true;
+
+    wstrToLower(wideGuildName);
+    //do not show players in arenas
+    uint32 playerZoneId = player->GetZoneId();
+    if (playerZoneId == (uint32) 3698 || playerZoneId == (uint32) 3968 || playerZoneId == (uint32) 3702)
+    {
+        WorldLocation const& loc = player->GetBattlegroundEntryPoint();
+        uint32 mapId = loc.GetMapId();
+        Map const* map = sMapMgr->FindBaseNonInstanceMap(mapId);
+        if (map)
+            playerZoneId = map->GetZoneId(loc.GetPositionX(), loc.GetPositionY(), loc.GetPositionZ());
+    }
+
+    // Conversion uint32 to uint8 here
+    AddEntry(std::make_shared<WhoListPlayerInfo const>(player->GetGUID(), player->GetTeam(), player->GetSession()->GetSecurity(), uint8(player->GetLevel()),
+        player->GetClass(), player->GetRace(), playerZoneId, player->GetByteValue(PLAYER_BYTES_3, PLAYER_BYTES_3_OFFSET_GENDER), player->IsVisible(),
+        widePlayerName, wideGuildName, playerName, guildName));
+    return true;
+}
+
+void WhoListStorageMgr::AddEntry(std::shared_ptr<WhoListPlayerInfo const> info)
+{
+    uint32 slot;
+    if (!_freeSlots.empty())
+    {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+    }
+    else
+    {
+        slot = uint32(_entries.size());
+        _entries.emplace_back();
+        _levelPositions.push_back(0);
+        _zonePositions.push_back(0);
+    }
+
+    _slotByGuid[info->GetGuid()] = slot;
+    AddToBucket(_byLevel[info->GetLevel()], slot, _levelPositions[slot]);
+    AddToBucket(_byZone[info->GetZoneId()], slot, _zonePositions[slot]);
+
+    std::wstring const& name = info->GetWidePlayerName();
+    for (size_t i = 0; i < name.size(); ++i)
+        _nameSuffixes.emplace(name.substr(i), slot);
+
+    _entries[slot] = std::move(info);
+}
 
-        wstrToLower(wideGuildName);
-        //do not show players in arenas
-        uint32 playerZoneId = itr->second->GetZoneId();
-        if (playerZoneId == (uint32) 3698 || playerZoneId == (uint32) 3968 || playerZoneId == (uint32) 3702)
+void WhoListStorageMgr::RemoveEntry(ObjectGuid guid)
+{
+    auto itr = _slotByGuid.find(guid);
+    if (itr == _slotByGuid.end())
+        return;
+
+    uint32 const slot = itr->second;
+    _slotByGuid.erase(itr);
+
+    WhoListPlayerInfo const& info = *_entries[slot];
+    RemoveFromBucket(_byLevel[info.GetLevel()], _levelPositions[slot], _levelPositions);
+
+    auto zoneItr = _byZone.find(info.GetZoneId());
+    RemoveFromBucket(zoneItr->second, _zonePositions[slot], _zonePositions);
+    if (zoneItr->second.empty())
+        _byZone.erase(zoneItr);
+
+    std::wstring const& name = info.GetWidePlayerName();
+    for (size_t i = 0; i < name.size(); ++i)
+        _nameSuffixes.erase(std::make_pair(name.substr(i), slot));
+
+    _entries[slot].reset();
+    _freeSlots.push_back(slot);
+}
+
+void WhoListStorageMgr::AddToBucket(SlotList& bucket, uint32 slot, uint32& position)
+{
+    position = uint32(bucket.size());
+    bucket.push_back(slot);
+}
+
+void WhoListStorageMgr::RemoveFromBucket(SlotList& bucket, uint32 position, std::vector<uint32>& positions)
+{
+    uint32 const moved = bucket.back();
+    bucket[position] = moved;
+    positions[moved] = position;
+    bucket.pop_back();
+}
+
+size_t WhoListStorageMgr::GetSize() const
+{
+    std::shared_lock<std::shared_mutex> lock(_indexLock);
+    return _slotByGuid.size();
+}
+
+void WhoListStorageMgr::GetCandidates(uint32 levelMin, uint32 levelMax, uint32 const* zoneIds, uint32 zonesCount, std::wstring const& widePlayerName, WhoListInfoVector& candidates) const
+{
+    candidates.clear();
+
+    std::shared_lock<std::shared_mutex> lock(_indexLock);
+
+    if (!widePlayerName.empty())
+    {
+        SlotList slots;
+        for (auto itr = _nameSuffixes.lower_bound(std::make_pair(widePlayerName, uint32(0))); itr != _nameSuffixes.end(); ++itr)
         {
-            WorldLocation const& loc = itr->second->GetBattlegroundEntryPoint();
-            uint32 mapId = loc.GetMapId();
-            Map const* map = sMapMgr->FindBaseNonInstanceMap(mapId);
-            if (map)
-                playerZoneId = map->GetZoneId(loc.GetPositionX(), loc.GetPositionY(), loc.GetPositionZ());
+            if (itr->first.compare(0, widePlayerName.size(), widePlayerName) != 0)
+                break;
+
+            slots.push_back(itr->second);
         }
 
-        // Conversion uint32 to uint8 here
-        _whoListStorage.emplace_back(itr->second->GetGUID(), itr->second->GetTeam(), itr->second->GetSession()->GetSecurity(), uint8(itr->second->GetLevel()), 
-            itr->second->GetClass(), itr->second->GetRace(), playerZoneId, itr->second->GetByteValue(PLAYER_BYTES_3, PLAYER_BYTES_3_OFFSET_GENDER), itr->second->IsVisible(),
-            widePlayerName, wideGuildName, playerName, guildName);
+        // names containing the string more than once
+        std::sort(slots.begin(), slots.end());
+        slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+        for (uint32 slot : slots)
+            candidates.push_back(_entries[slot]);
+        return;
     }
-}
\ No newline at end of file
+
+    if (zonesCount)
+    {
+        std::vector<uint32> zones(zoneIds, zoneIds + zonesCount);
+        std::sort(zones.begin(), zones.end());
+        zones.erase(std::unique(zones.begin(), zones.end()), zones.end());
+        for (uint32 zoneId : zones)
+        {
+            auto itr = _byZone.find(zoneId);
+            if (itr == _byZone.end())
+                continue;
+
+            for (uint32 slot : itr->second)
+                candidates.push_back(_entries[slot]);
+        }
+        return;
+    }
+
+    levelMax = std::min<uint32>(levelMax, uint32(_byLevel.size() - 1));
+    for (uint32 level = levelMin; level <= levelMax; ++level)
+        for (uint32 slot : _byLevel[level])
+            candidates.push_back(_entries[slot]);
+}
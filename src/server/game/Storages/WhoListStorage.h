@@ -4,6 +4,13 @@
 
 #include "Common.h"
 #include "ObjectGuid.h"
+#include <array>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 class WhoListPlayerInfo
 {
@@ -43,8 +50,15 @@ private:
     std::string _guildName;
 };
 
-typedef std::vector<WhoListPlayerInfo> WhoListInfoVector;
+// entries are shared so candidates stay valid after the storage replaced them
+typedef std::vector<std::shared_ptr<WhoListPlayerInfo const>> WhoListInfoVector;
 
+/*
+Who list entries of the players in world, indexed by level, zone and name. Player changes shown
+in the who list mark the player dirty, dirty players are added, updated or removed at next Update.
+Lookups come from the sessions updates, some of them outside the world thread (CMSG_WHO is thread safe),
+so they share the index lock with Update.
+*/
 class TC_GAME_API WhoListStorageMgr
 {
 private:
@@ -54,11 +68,47 @@ private:
 public:
     static WhoListStorageMgr* instance();
 
+    // Thread-safe, to call when the player logs in or out, or when its entry may have changed
+    void MarkDirty(ObjectGuid guid);
+    // Updates the entries of dirty players
     void Update();
-    WhoListInfoVector const& GetWhoList() const { return _whoListStorage; }
+
+    /* Fills candidates with the entries possibly matching the filters, using the smallest index for them.
+       The filters must still be checked on the candidates. */
+    void GetCandidates(uint32 levelMin, uint32 levelMax, uint32 const* zoneIds, uint32 zonesCount, std::wstring const& widePlayerName, WhoListInfoVector& candidates) const;
+
+    size_t GetSize() const;
 
 protected:
-    WhoListInfoVector _whoListStorage;
+    typedef std::vector<uint32> SlotList;
+
+    // returns false if the player is not listed
+    bool UpdatePlayer(ObjectGuid guid);
+    void AddEntry(std::shared_ptr<WhoListPlayerInfo const> info);
+    void RemoveEntry(ObjectGuid guid);
+
+    static void AddToBucket(SlotList& bucket, uint32 slot, uint32& position);
+    void RemoveFromBucket(SlotList& bucket, uint32 position, std::vector<uint32>& positions);
+
+    // entries by slot, slots of removed entries are reused
+    std::vector<std::shared_ptr<WhoListPlayerInfo const>> _entries;
+    std::vector<uint32> _freeSlots;
+    std::unordered_map<ObjectGuid, uint32> _slotByGuid;
+
+    // slots by level and by zone, with the position of each slot in its buckets
+    std::array<SlotList, 256> _byLevel;
+    std::unordered_map<uint32, SlotList> _byZone;
+    std::vector<uint32> _levelPositions;
+    std::vector<uint32> _zonePositions;
+
+    // every suffix of the lowercase player names, a name containing a string has a suffix starting with it
+    std::set<std::pair<std::wstring, uint32>> _nameSuffixes;
+
+    // guards every index above, exclusive for Update
+    mutable std::shared_mutex _indexLock;
+
+    std::mutex _dirtyLock;
+    std::unordered_set<ObjectGuid> _dirty;
 };
 
 #define sWhoListStorageMgr WhoListStorageMgr::instance()
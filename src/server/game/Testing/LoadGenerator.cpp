@@ -0,0 +1,179 @@
+#include "LoadGenerator.h"
+#include "Player.h"
+#include "WorldSession.h"
+#include "WorldPacket.h"
+#include "Map.h"
+#include "SpellInfo.h"
+#include "Log.h"
+#include <algorithm>
+#include <chrono>
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_UNIX
+#include <sys/resource.h>
+#endif
+
+// Each session runs in a circle of this radius around its spawn point
+static float const LOAD_MOVE_RADIUS = 10.0f;
+// Movement is stopped then restarted every this many ticks, a heartbeat is sent in between
+static uint32 const LOAD_MOVE_CYCLE = 10;
+static uint32 const LOAD_CHAT_INTERVAL = 20;
+static uint32 const LOAD_CAST_INTERVAL = 4;
+
+LoadGenerator::LoadGenerator(uint32 actions, uint32 castSpellId) :
+    _actions(actions), _castSpellId(castSpellId), _packetsReceived(0), _bytesReceived(0), _startPeakMemory(GetPeakMemory())
+{
+    if (!_castSpellId)
+        _actions &= ~ACTION_CAST;
+}
+
+void LoadGenerator::AddSession(Player* player)
+{
+    ASSERT(player->IsInWorld() && player->GetPlayerbotAI());
+
+    SyntheticSession session;
+    session.player = player;
+    session.center = player->GetPosition();
+    session.angle = 0.0f;
+    session.step = 0;
+    session.sentPacketsAtStart = player->GetSession()->GetSentPacketCount();
+    session.sentBytesAtStart = player->GetSession()->GetSentPacketBytes();
+    _sessions.push_back(session);
+
+    // a client takes control of its player when joining the map
+    WorldPacket* data = new WorldPacket(CMSG_SET_ACTIVE_MOVER, 8);
+    *data << player->GetGUID();
+    _packetsReceived++;
+    _bytesReceived += data->size();
+    player->GetSession()->QueuePacket(data);
+    player->GetSession()->HandleBotPackets();
+}
+
+void LoadGenerator::QueueMovement(SyntheticSession& session, uint32 diff)
+{
+    Player* player = session.player;
+    uint32 const cycleStep = session.step % LOAD_MOVE_CYCLE;
+
+    uint16 opcode = MSG_MOVE_HEARTBEAT;
+    if (cycleStep == 0)
+        opcode = MSG_MOVE_START_FORWARD;
+    else if (cycleStep == LOAD_MOVE_CYCLE - 1)
+        opcode = MSG_MOVE_STOP;
+    else
+        session.angle += player->GetSpeed(MOVE_RUN) * diff / IN_MILLISECONDS / LOAD_MOVE_RADIUS;
+
+    MovementInfo movementInfo;
+    movementInfo.SetMovementFlags(opcode == MSG_MOVE_STOP ? MOVEMENTFLAG_NONE : MOVEMENTFLAG_FORWARD);
+    movementInfo.time = player->GetMap()->GetGameTimeMS();
+    float x = session.center.GetPositionX() + LOAD_MOVE_RADIUS * std::cos(session.angle);
+    float y = session.center.GetPositionY() + LOAD_MOVE_RADIUS * std::sin(session.angle);
+    float z = session.center.GetPositionZ();
+    player->UpdateGroundPositionZ(x, y, z);
+    movementInfo.pos.Relocate(x, y, z, Position::NormalizeOrientation(session.angle + float(M_PI) / 2.0f));
+
+    WorldPacket* data = new WorldPacket(opcode, 4 + 1 + 4 + 4 * 4 + 4);
+    movementInfo.WriteContentIntoPacket(data);
+    _packetsReceived++;
+    _bytesReceived += data->size();
+    player->GetSession()->QueuePacket(data);
+}
+
+void LoadGenerator::QueueChat(SyntheticSession& session)
+{
+    WorldPacket* data = new WorldPacket(CMSG_MESSAGECHAT, 4 + 4 + 16);
+    *data << uint32(CHAT_MSG_SAY);
+    *data << uint32(LANG_UNIVERSAL);
+    *data << "load generator";
+    _packetsReceived++;
+    _bytesReceived += data->size();
+    session.player->GetSession()->QueuePacket(data);
+}
+
+void LoadGenerator::QueueCast(SyntheticSession& session)
+{
+    WorldPacket* data = new WorldPacket(CMSG_CAST_SPELL, 4 + 1 + 4);
+    *data << uint32(_castSpellId);
+    *data << uint8(0);                                      // cast count
+    *data << uint32(TARGET_FLAG_NONE);                      // self
+    _packetsReceived++;
+    _bytesReceived += data->size();
+    session.player->GetSession()->QueuePacket(data);
+}
+
+void LoadGenerator::Tick(uint32 diff)
+{
+    for (SyntheticSession& session : _sessions)
+    {
+        if (_actions & ACTION_MOVE)
+            QueueMovement(session, diff);
+        if ((_actions & ACTION_CHAT) && session.step % LOAD_CHAT_INTERVAL == 0)
+            QueueChat(session);
+        if ((_actions & ACTION_CAST) && session.step % LOAD_CAST_INTERVAL == 0)
+            QueueCast(session);
+        session.step++;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (SyntheticSession& session : _sessions)
+        session.player->GetSession()->HandleBotPackets();
+    _handlerTimes.push_back(uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()));
+}
+
+void LoadGenerator::AddMapTickTime(uint32 ms)
+{
+    if (ms)
+        _mapTickTimes.push_back(ms);
+}
+
+static void GetPercentiles(std::vector<uint32> values, uint32& p50, uint32& p90, uint32& p99, uint32& max)
+{
+    if (values.empty())
+        return;
+
+    std::sort(values.begin(), values.end());
+    auto at = [&values](uint32 percent) { return values[(values.size() - 1) * percent / 100]; };
+    p50 = at(50);
+    p90 = at(90);
+    p99 = at(99);
+    max = values.back();
+}
+
+LoadGenerator::Report LoadGenerator::GetReport() const
+{
+    Report report;
+    report.sessions = _sessions.size();
+    report.ticks = _handlerTimes.size();
+    GetPercentiles(_mapTickTimes, report.mapTickP50, report.mapTickP90, report.mapTickP99, report.mapTickMax);
+    GetPercentiles(_handlerTimes, report.handlersP50, report.handlersP90, report.handlersP99, report.handlersMax);
+    report.packetsReceived = _packetsReceived;
+    report.bytesReceived = _bytesReceived;
+    for (SyntheticSession const& session : _sessions)
+    {
+        report.packetsSent += session.player->GetSession()->GetSentPacketCount() - session.sentPacketsAtStart;
+        report.bytesSent += session.player->GetSession()->GetSentPacketBytes() - session.sentBytesAtStart;
+    }
+    uint64 const peakMemory = GetPeakMemory();
+    if (peakMemory > _startPeakMemory)
+        report.peakMemoryGrowth = peakMemory - _startPeakMemory;
+
+    return report;
+}
+
+void LoadGenerator::LogReport(char const* name) const
+{
+    Report report = GetReport();
+    TC_LOG_INFO("test.unit_test", "Load generator %s: %u sessions, %u ticks", name, report.sessions, report.ticks);
+    TC_LOG_INFO("test.unit_test", "  Map tick (ms): p50 %u, p90 %u, p99 %u, max %u", report.mapTickP50, report.mapTickP90, report.mapTickP99, report.mapTickMax);
+    TC_LOG_INFO("test.unit_test", "  Handlers (us): p50 %u, p90 %u, p99 %u, max %u", report.handlersP50, report.handlersP90, report.handlersP99, report.handlersMax);
+    TC_LOG_INFO("test.unit_test", "  Packets: received " UI64FMTD " (" UI64FMTD " bytes), sent " UI64FMTD " (" UI64FMTD " bytes)",
+        report.packetsReceived, report.bytesReceived, report.packetsSent, report.bytesSent);
+    TC_LOG_INFO("test.unit_test", "  Peak memory growth: " UI64FMTD " KB", report.peakMemoryGrowth);
+}
+
+uint64 LoadGenerator::GetPeakMemory()
+{
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_UNIX
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        return uint64(usage.ru_maxrss);
+#endif
+    return 0;
+}
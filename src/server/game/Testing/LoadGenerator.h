@@ -0,0 +1,87 @@
+#ifndef LOAD_GENERATOR_H
+#define LOAD_GENERATOR_H
+
+#include "Define.h"
+#include "Position.h"
+#include <vector>
+
+class Player;
+
+/* Headless load generator: feeds scripted client packets to the sessions of test players
+   (no socket) and lets the real opcode handlers process them, as WorldSession::Update does
+   for connected clients. Used by benchmark tests to compare scaling changes on a test map.
+*/
+class TC_GAME_API LoadGenerator
+{
+public:
+    enum Actions
+    {
+        ACTION_MOVE = 0x1, // start, heartbeat and stop packets, running in circles around the spawn point
+        ACTION_CHAT = 0x2, // say messages
+        ACTION_CAST = 0x4, // casts of the given spell on self
+
+        ACTION_ALL  = ACTION_MOVE | ACTION_CHAT | ACTION_CAST,
+    };
+
+    struct Report
+    {
+        uint32 sessions = 0;
+        uint32 ticks = 0;
+        // map update duration (ms) after each tick, only filled when monitoring is enabled
+        uint32 mapTickP50 = 0;
+        uint32 mapTickP90 = 0;
+        uint32 mapTickP99 = 0;
+        uint32 mapTickMax = 0;
+        // time spent in the opcode handlers (us) at each tick
+        uint32 handlersP50 = 0;
+        uint32 handlersP90 = 0;
+        uint32 handlersP99 = 0;
+        uint32 handlersMax = 0;
+        uint64 packetsReceived = 0;
+        uint64 bytesReceived = 0;
+        uint64 packetsSent = 0;
+        uint64 bytesSent = 0;
+        // growth of the process peak resident memory (KB) since the generator creation, 0 if unknown
+        uint64 peakMemoryGrowth = 0;
+    };
+
+    LoadGenerator(uint32 actions = ACTION_ALL, uint32 castSpellId = 0);
+
+    // Player must be a test player (bot session, no socket) in world
+    void AddSession(Player* player);
+    // Queue one tick of client packets for every session and handle them
+    void Tick(uint32 diff);
+    // Record the duration of the map update following the last tick
+    void AddMapTickTime(uint32 ms);
+
+    Report GetReport() const;
+    void LogReport(char const* name) const;
+
+private:
+    struct SyntheticSession
+    {
+        Player* player;
+        Position center;
+        float angle;
+        uint32 step;
+        uint64 sentPacketsAtStart;
+        uint64 sentBytesAtStart;
+    };
+
+    void QueueMovement(SyntheticSession& session, uint32 diff);
+    void QueueChat(SyntheticSession& session);
+    void QueueCast(SyntheticSession& session);
+
+    static uint64 GetPeakMemory();
+
+    uint32 _actions;
+    uint32 _castSpellId;
+    std::vector<SyntheticSession> _sessions;
+    std::vector<uint32> _mapTickTimes;
+    std::vector<uint32> _handlerTimes;
+    uint64 _packetsReceived;
+    uint64 _bytesReceived;
+    uint64 _startPeakMemory;
+};
+
+#endif //LOAD_GENERATOR_H
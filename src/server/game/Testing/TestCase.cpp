@@ -201,6 +201,31 @@ void TestCase::_Cleanup()
     }
 }
 
+bool TestCase::RunNestedTest(std::string const& testName)
+{
+    std::unique_ptr<TestCase> test;
+    for (auto const& itr : sScriptMgr->GetAllTests())
+    {
+        if (itr.second->GetName() == testName)
+        {
+            test = itr.second->GetTest();
+            break;
+        }
+    }
+
+    if (!test || test->_location.GetMapId() != _location.GetMapId() || test->_diff != _diff || (test->_enableMapObjects && !_enableMapObjects))
+        return false;
+
+    test->_SetName(testName);
+    test->_testThread = _testThread;
+    test->_map = _map;
+    test->_setup = true;
+    //no map instance id, the map belongs to this test and is not unloaded by the nested one
+    test->_Test();
+    test->_Cleanup();
+    return true;
+}
+
 bool TestCase::_InternalSetup()
 {
     ASSERT(!_map);
@@ -1162,19 +1187,18 @@ void TestCase::HandleSpellsCleanup(Unit* caster)
 {
     //Spell deletions are done in SpellEvent
     EventList& eventList = caster->m_Events.m_events;
-    for (auto itr = eventList.begin(); itr != eventList.end();)
+    eventList.RemoveIf([](BasicEvent* event)
     {
-        if (SpellEvent* spellEvent = dynamic_cast<SpellEvent*>(itr->second))
+        if (SpellEvent* spellEvent = dynamic_cast<SpellEvent*>(event))
             if (spellEvent->m_Spell->getState() == SPELL_STATE_FINISHED && spellEvent->m_Spell->IsDeletable())
             {
                 //what we're doing here is mimicing the EventProcessor::Update + SpellEvent::Execute behavior in this case, that is -> just delete the event.
-                itr = eventList.erase(itr);
                 delete spellEvent; //SpellEvent deletion handle spell deletion
-                continue;
+                return true;
             }
 
-        itr++;
-    }
+        return false;
+    });
 }
 
 void TestCase::_MaxHealth(Unit* unit, bool lowHealth /*= false*/)
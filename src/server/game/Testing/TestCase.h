@@ -11,6 +11,7 @@
 #include "PlayerbotAI.h"
 #include "TestDefines.h"
 #include "TestSectionResult.h"
+#include <chrono>
 #include <functional>
 
 class TestMap;
@@ -147,6 +148,14 @@ public:
     #define TEST_AURA_CHARGE(target, spellID, stacks) { _SetCaller(__FILE__, __LINE__); _TestAuraStack(target, spellID, stacks, false); _ResetCaller(); }
 
     float CalcChance(uint32 iterations, const std::function<bool()>& f);
+    //Time taken by f, in microseconds
+    template<class F>
+    static uint64 Measure(F&& f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
     ///!\ This is VERY slow, do not abuse of this function. Randomize talents, spells, stuff for this player
     void RandomizePlayer(TestPlayer* player);
 
@@ -358,6 +367,9 @@ protected:
     void HandleThreadPause();
     //Free finished spells from memory. This is usually done at next map update but we may go a long time without it in tests.
     void HandleSpellsCleanup(Unit* caster);
+    /* Run the test with this name inside this one, on this test map. For benchmarks using existing tests as workload.
+       Failures of the nested test are not reported, returns false if it does not exist or needs another map. */
+    bool RunNestedTest(std::string const& testName);
     //Main check function, used by TEST_ASSERT macro. Will stop execution on failure
     void Assert(std::string file, int32 line, std::string function, bool condition, std::string failedCondition);
 
@@ -3,6 +3,7 @@
 #include "TestCase.h"
 #include "TestThread.h"
 
+#include "Config.h"
 #include "Log.h"
 #include "ScriptMgr.h"
 #include <regex>
@@ -11,7 +12,11 @@
 TestMgr::TestMgr() :
     _running(false),
     _loading(false),
-    _canceling(false)
+    _canceling(false),
+    _stopWorkers(false),
+    _mapUpdatesOpen(false),
+    _mapUpdatesPending(0),
+    _activeWorkers(0)
 { }
 
 void TestMgr::_Load(std::string name_or_pattern, Player* joiner /*= nullptr*/)
@@ -74,7 +79,7 @@ bool TestMgr::_TestMatchPattern(TestCase* test, std::string const& pattern) cons
     return std::regex_match(test->GetName(), regex_pattern);
 }
 
-bool TestMgr::Run(std::string args, Player* joiner /*= nullptr*/)
+bool TestMgr::Run(std::string args, Player* joiner /*= nullptr*/, uint32 workerThreads /*= 0*/)
 {
     if (_running || _loading)
         return false;
@@ -84,13 +89,103 @@ bool TestMgr::Run(std::string args, Player* joiner /*= nullptr*/)
     _running = true;
     _loading = true;
     _canceling = false;
+    _runStartTime = std::chrono::steady_clock::now();
     ASSERT(_remainingTests.empty());
     _Load(args, joiner);
+    if (workerThreads && !joiner)
+    {
+        for (auto const& itr : _remainingTests)
+            itr.second->SetDecoupled();
+
+        _StartWorkers(workerThreads);
+    }
     _loading = false;
 
     return true;
 }
 
+void TestMgr::_StartWorkers(uint32 count)
+{
+    ASSERT(_workers.empty());
+    _stopWorkers = false;
+    for (uint32 i = 0; i < count; i++)
+        _workers.emplace_back(&TestMgr::_WorkerThread, this);
+}
+
+void TestMgr::_StopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(_workerQueueLock);
+        _stopWorkers = true;
+        _workerQueue.clear();
+    }
+    _workerQueueCondition.notify_all();
+
+    for (std::thread& worker : _workers)
+        worker.join();
+    _workers.clear();
+}
+
+void TestMgr::_WorkerThread()
+{
+    while (true)
+    {
+        std::shared_ptr<TestThread> testThread;
+        {
+            std::unique_lock<std::mutex> lock(_workerQueueLock);
+            _workerQueueCondition.wait(lock, [this] { return _stopWorkers || (_mapUpdatesOpen && !_workerQueue.empty()); });
+            if (_stopWorkers)
+                return;
+
+            testThread = _workerQueue.front();
+            _workerQueue.pop_front();
+            if (_mapUpdatesPending)
+                --_mapUpdatesPending;
+            ++_activeWorkers;
+        }
+
+        //finished tests are dropped from the queue, TestMgr::Update collects their results
+        bool const finished = testThread->CanUnloadMap();
+
+        //test is still setting up, don't spin on it
+        if (!finished && !testThread->UpdateMap())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        {
+            std::lock_guard<std::mutex> lock(_workerQueueLock);
+            if (!finished)
+                _workerQueue.push_back(std::move(testThread));
+            --_activeWorkers;
+        }
+        //wakes both the other workers and EndMapUpdates
+        _workerQueueCondition.notify_all();
+    }
+}
+
+void TestMgr::BeginMapUpdates()
+{
+    if (_workers.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_workerQueueLock);
+        _mapUpdatesOpen = true;
+        _mapUpdatesPending = _workerQueue.size();
+    }
+    _workerQueueCondition.notify_all();
+}
+
+void TestMgr::EndMapUpdates()
+{
+    if (_workers.empty())
+        return;
+
+    std::unique_lock<std::mutex> lock(_workerQueueLock);
+    _workerQueueCondition.wait(lock, [this] { return _mapUpdatesPending == 0; });
+    _mapUpdatesOpen = false;
+    _workerQueueCondition.wait(lock, [this] { return _activeWorkers == 0; });
+}
+
 void TestMgr::Update()
 {
     if (!_running || _loading)
@@ -109,12 +204,22 @@ void TestMgr::Update()
             if(_canceling)
                 itr = _remainingTests.erase(itr);
             else
+            {
                 testThread->Start();
+                if (testThread->IsDecoupled())
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_workerQueueLock);
+                        _workerQueue.push_back(testThread);
+                    }
+                    _workerQueueCondition.notify_one();
+                }
+            }
         }
         else if (testThread->IsFinished())
         {
             auto test = testThread->GetTest();
-            _results.TestFinished(*test);
+            _results.TestFinished(*test, testThread->GetWallTime(), testThread->GetTickCount());
             itr = _remainingTests.erase(itr);
             continue;
         }
@@ -124,12 +229,22 @@ void TestMgr::Update()
 
     if (_remainingTests.empty()) //then we're done!
     {
+        if (!_workers.empty())
+            _StopWorkers();
+
+        _results.SetRunTime(uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _runStartTime).count()));
+
         std::string results;
         if (_canceling)
             results = "\nTests were canceled";
         else
             results = _results.ToString();
 
+        //canceled runs still report the tests which were run
+        std::string junitFile = sConfigMgr->GetStringDefault("Testing.JUnitReport", "");
+        if (!junitFile.empty() && !_results.WriteJUnit(junitFile))
+            TC_LOG_ERROR("test.unit_test", "Failed to write tests results to %s", junitFile.c_str());
+
         //print it line by line, messages too long may not be displayed
         std::istringstream iss(results);
         for (std::string line; std::getline(iss, line); )
@@ -5,6 +5,10 @@ class TestCase;
 class TestThread;
 #include "TestResults.h"
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <thread>
 
 class TC_GAME_API TestMgr
 {
@@ -22,7 +26,12 @@ public:
     bool IsRunning() const { return _running; }
     //true on success start
     //if joiner: start an unique test and teleport player to it immediately
-    bool Run(std::string args, Player* joiner = nullptr);
+    //if workerThreads: test maps are updated by this many dedicated threads, back to back while the other maps update instead of once per world update. Only for headless runs, no player should join.
+    bool Run(std::string args, Player* joiner = nullptr, uint32 workerThreads = 0);
+    //decoupled test maps are only updated between these two calls, made by World around the maps updates. The rest of the world update assumes no map updates concurrently.
+    void BeginMapUpdates();
+    //wait for every decoupled test map to be updated at least once since BeginMapUpdates, then for the workers to be done
+    void EndMapUpdates();
     std::string ListAvailable(std::string filter) const;
     std::string ListRunning(std::string filter) const;
     bool GoToTest(Player*, uint32 testId) const;
@@ -37,12 +46,27 @@ private:
     //defined in TestLoader.cpp, all tests are listed there
     void _Load(std::string name_or_pattern, Player* joiner = nullptr);
     bool _TestMatchPattern(TestCase* test, std::string const& pattern) const;
+    void _StartWorkers(uint32 count);
+    void _StopWorkers();
+    void _WorkerThread();
 
     std::map<uint32 /*testId*/, std::shared_ptr<TestThread>> _remainingTests; //all remaining tests, tests finished are removed from it
     TestResults _results;
     std::atomic<bool> _running;
     std::atomic<bool> _loading;
     std::atomic<bool> _canceling;
+    std::chrono::steady_clock::time_point _runStartTime;
+
+    // -- decoupled test maps updates
+    std::vector<std::thread> _workers;
+    std::deque<std::shared_ptr<TestThread>> _workerQueue; //started tests, each worker takes the first one, updates its map once then puts it back at the end
+    std::mutex _workerQueueLock;
+    std::condition_variable _workerQueueCondition;
+    bool _stopWorkers;
+    bool _mapUpdatesOpen;     //workers may take tests from the queue
+    size_t _mapUpdatesPending; //tests to take before EndMapUpdates may close the window
+    uint32 _activeWorkers;     //workers currently updating a test map
+    // --
 }; 
 
 //extra ifdef to make sure we don't include this by error
@@ -11,6 +11,12 @@ public:
     virtual ~TestPlayer() {}
 
     virtual void SaveToDB(bool create = false) override {}
+    // Saves with the Player save path, differential saves or not whatever the config. Returns the rows written and skipped by the save
+    PlayerSaveStats SaveToDBForTest(bool differential) { return _SaveToDB(false, differential); }
+    PlayerSaveState const& GetSaveState() const { return m_saveState; }
+    // As if the last save transaction failed, or not
+    void SetSaveFailed(bool failed) { m_saveFailed->store(failed); }
+    bool IsSaveFailed() const { return m_saveFailed->load(); }
     virtual void SaveInventoryAndGoldToDB(SQLTransaction trans) override {}
     virtual void SaveGoldToDB(SQLTransaction trans) override {}
     virtual void SaveDataFieldToDB() override {}
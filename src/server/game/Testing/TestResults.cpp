@@ -2,17 +2,29 @@
 #include "TestCase.h"
 #include "TestThread.h"
 #include <sstream>
+#include <fstream>
+#include <algorithm>
 
 TestResults::TestResults() :
     _totalTestsRan(0),
-    _ignored(0)
+    _ignored(0),
+    _runTime(0)
 { }
 
-void TestResults::TestFinished(TestCase const& test)
+void TestResults::TestFinished(TestCase const& test, uint32 wallTime, uint32 ticks)
 {
     _totalTestsRan++;
     std::list<TestSectionResult> resultList = test.GetResults();
 
+    TestRun run;
+    run.name = test.GetName();
+    run.wallTime = wallTime;
+    run.ticks = ticks;
+    for (auto const& result : resultList)
+        if (!result.IsSuccess())
+            run.failures.push_back(result);
+    _runs.push_back(std::move(run));
+
     //for tests with no section, create one fake section. If test has failed out of section, another fake section has already been created in TestCase::_FailNoException
     if (resultList.empty())
         _successes.emplace_back(test.GetName(), "<no section>", true, STATUS_PASSING, "(no error)");
@@ -68,6 +80,21 @@ std::string TestResults::ToString()
         ss << " " << successes << " | Section successes";
         ss << std::endl;
         ss << " " << failures  << " | Section failures (regressions: " << regressions.size() << ", known: " << knownBugs.size() << ")" << std::endl;
+        if (_runTime)
+            ss << " " << _runTime << " | Run time (ms)" << std::endl;
+        ss << " " << std::endl;
+
+        //show slowest tests, to spot performance regressions
+        uint32 const SLOWEST_COUNT = 5;
+        std::vector<TestRun const*> slowest;
+        for (TestRun const& run : _runs)
+            slowest.push_back(&run);
+        std::sort(slowest.begin(), slowest.end(), [](TestRun const* a, TestRun const* b) { return a->wallTime > b->wallTime; });
+        if (slowest.size() > SLOWEST_COUNT)
+            slowest.resize(SLOWEST_COUNT);
+        ss << " Slowest tests:" << std::endl;
+        for (TestRun const* run : slowest)
+            ss << "  " << run->wallTime << " ms, " << run->ticks << " ticks | " << run->name << std::endl;
         ss << " " << std::endl;
         if(!failures)
             ss << R"( All tests passed \o/)" << std::endl;
@@ -89,3 +116,66 @@ std::string TestResults::ToString()
     ss << "===============================================================================" << std::endl;
     return ss.str();
 }
+
+
+static std::string XmlEscape(std::string const& str)
+{
+    std::string escaped;
+    escaped.reserve(str.size());
+    for (char c : str)
+    {
+        switch (c)
+        {
+            case '&': escaped += "&amp;"; break;
+            case '<': escaped += "&lt;"; break;
+            case '>': escaped += "&gt;"; break;
+            case '"': escaped += "&quot;"; break;
+            default: escaped += c; break;
+        }
+    }
+    return escaped;
+}
+
+bool TestResults::WriteJUnit(std::string const& fileName) const
+{
+    std::ofstream file(fileName, std::ios::trunc);
+    if (!file.is_open())
+        return false;
+
+    //only regressions are failures, known bugs and incomplete tests are reported as skipped
+    uint32 failedTests = 0;
+    uint32 skippedTests = 0;
+    for (TestRun const& run : _runs)
+    {
+        if (std::any_of(run.failures.begin(), run.failures.end(), [](TestSectionResult const& r) { return r.GetStatus() == STATUS_PASSING; }))
+            failedTests++;
+        else if (!run.failures.empty())
+            skippedTests++;
+    }
+
+    file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
+    file << "<testsuites>" << std::endl;
+    file << "  <testsuite name=\"" << XmlEscape(_usedPattern) << "\" tests=\"" << _runs.size() << "\" failures=\"" << failedTests
+        << "\" skipped=\"" << skippedTests << "\" time=\"" << _runTime / 1000.0 << "\">" << std::endl;
+    for (TestRun const& run : _runs)
+    {
+        //first word of test name is its category (spells, talents, movement...)
+        std::string const category = run.name.substr(0, run.name.find(' '));
+        file << "    <testcase classname=\"" << XmlEscape(category) << "\" name=\"" << XmlEscape(run.name) << "\" time=\"" << run.wallTime / 1000.0 << "\">" << std::endl;
+        file << "      <properties><property name=\"ticks\" value=\"" << run.ticks << "\"/></properties>" << std::endl;
+        bool regression = false;
+        for (TestSectionResult const& result : run.failures)
+        {
+            if (result.GetStatus() != STATUS_PASSING)
+                continue;
+            file << "      <failure message=\"" << XmlEscape(result.GetSectionName()) << "\">" << XmlEscape(result.GetErrorMessage()) << "</failure>" << std::endl;
+            regression = true;
+        }
+        if (!regression && !run.failures.empty())
+            file << "      <skipped message=\"" << XmlEscape(run.failures.front().GetSectionName()) << " (known bug or incomplete)\"/>" << std::endl;
+        file << "    </testcase>" << std::endl;
+    }
+    file << "  </testsuite>" << std::endl;
+    file << "</testsuites>" << std::endl;
+    return true;
+}
@@ -15,15 +15,28 @@ public:
     TestResults();
 
     std::string ToString();
+    //Write results in JUnit XML format, with wall time and tick count for each test
+    bool WriteJUnit(std::string const& fileName) const;
 
-    void TestFinished(TestCase const& test);
+    void TestFinished(TestCase const& test, uint32 wallTime, uint32 ticks);
     void IncreasedIgnored() { _ignored++; }
     void SetUsedPattern(std::string const& pattern) { _usedPattern = pattern; }
+    void SetRunTime(uint32 ms) { _runTime = ms; }
 
 private:
+    struct TestRun
+    {
+        std::string name;
+        uint32 wallTime; //ms
+        uint32 ticks;
+        TestResultList failures;
+    };
+
     uint32 _totalTestsRan;
     uint32 _ignored;
+    uint32 _runTime;
     std::string _usedPattern;
+    std::vector<TestRun> _runs;
 
     TestResultList GetFilteredResult(bool success, std::initializer_list<TestStatus> const& statuses) const;
     static void HandlePrintResults(std::stringstream& ss, std::string desc, TestResultList container);
@@ -11,6 +11,8 @@ public:
     std::string ToString() const;
     TestStatus GetStatus() const;
     bool IsSuccess() const { return _success; }
+    std::string const& GetSectionName() const { return _sectionName; }
+    std::string const& GetErrorMessage() const { return _errorMsg; }
     void AppendToError(std::string message);
 
 private:
@@ -6,7 +6,12 @@ TestThread::TestThread(std::unique_ptr<TestCase> test)
     : _testCase(std::move(test)), 
     _state(STATE_NOT_STARTED),
     _waitTimer(0),
-    _thisUpdateStartTimeMS(0)
+    _thisUpdateStartTimeMS(0),
+    _decoupled(false),
+    _updatingMap(false),
+    _lastMapUpdateMS(0),
+    _ticks(0),
+    _wallTime(0)
 {
 }
 
@@ -20,6 +25,8 @@ TestThread::~TestThread() = default;
 void TestThread::Start()
 {
     _state = STATE_STARTED;
+    _startTime = std::chrono::steady_clock::now();
+    _lastMapUpdateMS = GetMSTime();
     _future = std::move(std::async(std::launch::async, [this]() { this->Run(); }));
 }
 
@@ -40,7 +47,7 @@ bool TestThread::IsCanceling() const
 
 bool TestThread::CanUnloadMap() const
 {
-    return IsFinished() || IsCanceling();
+    return (IsFinished() || IsCanceling()) && !_updatingMap;
 }
 
 bool TestThread::IsPaused() const
@@ -82,6 +89,7 @@ void TestThread::Run()
     }
 
     _testCase->_Cleanup();
+    _wallTime = uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _startTime).count());
     _state = STATE_FINISHED;
 
     //unlock sleeping TestMgr if needed (we finished test)
@@ -126,6 +134,25 @@ void TestThread::UpdateWaitTimer(uint32 const mapDiff)
         _SetWait(_waitTimer - mapDiff);
 }
 
+bool TestThread::UpdateMap()
+{
+    ASSERT(_decoupled);
+
+    //parent map destroys the test map as soon as CanUnloadMap is true, so mark the update before checking the state
+    _updatingMap = true;
+    bool updated = false;
+    if (_state >= STATE_WAITING_FOR_JOIN && !IsFinished() && !IsCanceling())
+    {
+        uint32 const now = GetMSTime();
+        uint32 const diff = std::max(GetMSTimeDiff(_lastMapUpdateMS, now), 1u);
+        _lastMapUpdateMS = now;
+        _testCase->GetMap()->UpdateDecoupled(diff);
+        updated = true;
+    }
+    _updatingMap = false;
+    return updated;
+}
+
 //This function will be executed while the test is running... be careful for racing conditions
 void TestThread::WaitUntilDoneOrWaiting(TestCase* test)
 {
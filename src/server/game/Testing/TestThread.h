@@ -4,6 +4,7 @@
 class TestCase;
 #include "TestResults.h"
 #include <atomic>
+#include <chrono>
 
 //Custom exception. This is to have a different type than exception and be able to differenciate test and regular exceptions
 class TestException : public std::exception
@@ -49,6 +50,9 @@ public:
     void Run();
     //update test Wait Timer but do not notify anything
     void UpdateWaitTimer(uint32 const mapDiff);
+    void IncreaseTickCount() { _ticks++; }
+    //Update test map from a TestMgr worker instead of the map updater. Return false if map was not updated (test not yet setup or done)
+    bool UpdateMap();
     TestCase* GetTest() const { return _testCase.get(); };
 
     // Sleep caller execution until ... (this does not sleep the test thread)
@@ -59,6 +63,13 @@ public:
     bool IsCanceling() const;
     bool CanUnloadMap() const;
     ThreadState GetState() const { return _state; }
+    //Test map is updated by TestMgr workers, decoupled from world updates. Must be set before start.
+    void SetDecoupled() { _decoupled = true; }
+    bool IsDecoupled() const { return _decoupled; }
+    //Time from start to finish, in ms
+    uint32 GetWallTime() const { return _wallTime; }
+    //Number of map updates the test ran in
+    uint32 GetTickCount() const { return _ticks; }
 
     //stop and fail tests as soon as possible
     void Cancel();
@@ -80,6 +91,14 @@ private:
     // --
     uint32 _thisUpdateStartTimeMS;
 
+    // -- var for decoupled updates and timing
+    bool _decoupled;
+    std::atomic<bool> _updatingMap; //map can't be unloaded while a worker updates it
+    uint32 _lastMapUpdateMS;
+    std::atomic<uint32> _ticks;
+    std::chrono::steady_clock::time_point _startTime;
+    uint32 _wallTime;
+    // --
 
     // Sleep caller execution for given ms (MUST BE called from the TestCase only)
     void Wait(uint32 ms);
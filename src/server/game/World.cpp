@@ -14,6 +14,7 @@
 #include "CreatureAIRegistry.h"
 #include "CreatureGroups.h"
 #include "CreatureTextMgr.h"
+#include "DBCFileLoader.h"
 #include "DBCStores.h"
 #include "GameEventMgr.h"
 #include "GameObjectModel.h"
@@ -31,6 +32,7 @@
 #include "LogsDatabaseAccessor.h"
 #include "LootMgr.h"
 #include "LootItemStorage.h"
+#include "LoginQueryBatcher.h"
 #include "M2Stores.h"
 #include "MMapFactory.h"
 #include "MMapManager.h"
@@ -39,6 +41,7 @@
 #include "MapManager.h"
 #include "Memory.h"
 #include "ObjectMgr.h"
+#include "ObjectPool.h"
 #include "Opcodes.h"
 #include "OutdoorPvPMgr.h"
 #include "PetitionMgr.h"
@@ -90,6 +93,7 @@ TC_GAME_API float World::m_MaxVisibleDistanceInBGArenas   = DEFAULT_VISIBILITY_B
 TC_GAME_API float World::m_MaxVisibleDistanceForObject    = DEFAULT_VISIBILITY_DISTANCE;
 
 TC_GAME_API float World::m_MaxVisibleDistanceInFlight     = DEFAULT_VISIBILITY_DISTANCE;
+TC_GAME_API float World::m_visibilityHysteresis           = 5.0f;
 
 TC_GAME_API int32 World::m_visibility_notify_periodOnContinents = DEFAULT_VISIBILITY_NOTIFY_PERIOD;
 TC_GAME_API int32 World::m_visibility_notify_periodInInstances = DEFAULT_VISIBILITY_NOTIFY_PERIOD;
@@ -154,10 +158,11 @@ World::~World()
     //TODO free addSessQueue
 }
 
-void World::SetCITesting()
+void World::SetCITesting(std::string const& pattern)
 {
 #ifdef TESTS
     _CITesting = true;
+    _CITestingPattern = pattern;
 #else
     std::cout << "Core was not build with tests" << std::endl;
 #endif
@@ -615,6 +620,18 @@ void World::LoadConfigSettings(bool reload)
     m_configs[CONFIG_GRID_UNLOAD] = sConfigMgr->GetBoolDefault("GridUnload", true);
     m_configs[CONFIG_INTERVAL_SAVE] = sConfigMgr->GetIntDefault("PlayerSaveInterval", 60000);
     m_configs[CONFIG_INTERVAL_DISCONNECT_TOLERANCE] = sConfigMgr->GetIntDefault("DisconnectToleranceInterval", 0);
+    m_configs[CONFIG_LOGIN_BATCH_SIZE] = sConfigMgr->GetIntDefault("Login.Batch.Size", 1);
+    if (m_configs[CONFIG_LOGIN_BATCH_SIZE] > LOGIN_QUERY_BATCH_SIZE)
+    {
+        TC_LOG_ERROR("server.loading", "Login.Batch.Size (%i) must be in range 0..%i. Set to %i.", m_configs[CONFIG_LOGIN_BATCH_SIZE], LOGIN_QUERY_BATCH_SIZE, LOGIN_QUERY_BATCH_SIZE);
+        m_configs[CONFIG_LOGIN_BATCH_SIZE] = LOGIN_QUERY_BATCH_SIZE;
+    }
+    m_configs[CONFIG_LOGIN_BATCH_WINDOW] = sConfigMgr->GetIntDefault("Login.Batch.Window", 50);
+    m_configs[CONFIG_OBJECT_POOLS] = sConfigMgr->GetBoolDefault("ObjectPools.Enabled", true);
+    ObjectPool::SetEnabled(m_configs[CONFIG_OBJECT_POOLS]);
+    m_configs[CONFIG_DBC_MEMORY_MAPPED] = sConfigMgr->GetBoolDefault("DBC.MemoryMapped", true);
+    DBCFileLoader::SetMemoryMapped(m_configs[CONFIG_DBC_MEMORY_MAPPED]);
+    m_configs[CONFIG_PLAYER_SAVE_DIFFERENTIAL] = sConfigMgr->GetBoolDefault("PlayerSave.Differential", true);
 
     m_configs[CONFIG_INTERVAL_MAPUPDATE] = sConfigMgr->GetIntDefault("MapUpdateInterval", 100);
     if(m_configs[CONFIG_INTERVAL_MAPUPDATE] < MIN_MAP_UPDATE_DELAY)
@@ -1077,6 +1094,12 @@ void World::LoadConfigSettings(bool reload)
 
     m_configs[CONFIG_DETECT_POS_COLLISION] = sConfigMgr->GetBoolDefault("DetectPosCollision", true);
 
+    m_configs[CONFIG_UPDATE_LOD_ENABLED] = sConfigMgr->GetBoolDefault("MapUpdate.LOD.Enabled", false);
+    m_configs[CONFIG_UPDATE_LOD_MID_INTERVAL] = sConfigMgr->GetIntDefault("MapUpdate.LOD.MidInterval", 400);
+    m_configs[CONFIG_UPDATE_LOD_FAR_DISTANCE] = sConfigMgr->GetIntDefault("MapUpdate.LOD.FarDistance", 250);
+    m_configs[CONFIG_UPDATE_LOD_FAR_INTERVAL] = sConfigMgr->GetIntDefault("MapUpdate.LOD.FarInterval", 1000);
+    m_configs[CONFIG_LOS_CACHE_ENABLED] = sConfigMgr->GetBoolDefault("LineOfSight.Cache.Enabled", true);
+
     m_configs[CONFIG_DEATH_SICKNESS_LEVEL] = sConfigMgr->GetIntDefault("Death.SicknessLevel", 11);
     m_configs[CONFIG_DEATH_CORPSE_RECLAIM_DELAY_PVP] = sConfigMgr->GetBoolDefault("Death.CorpseReclaimDelay.PvP", true);
     m_configs[CONFIG_DEATH_CORPSE_RECLAIM_DELAY_PVE] = sConfigMgr->GetBoolDefault("Death.CorpseReclaimDelay.PvE", true);
@@ -1171,6 +1194,18 @@ void World::LoadConfigSettings(bool reload)
         m_MaxVisibleDistanceInFlight = MAX_VISIBILITY_DISTANCE;
     }
 
+    m_visibilityHysteresis = sConfigMgr->GetFloatDefault("Visibility.Hysteresis", 5.0f);
+    if (m_visibilityHysteresis < 0.0f)
+    {
+        TC_LOG_ERROR("server.loading", "Visibility.Hysteresis can't be negative, set to 0");
+        m_visibilityHysteresis = 0.0f;
+    }
+    else if (m_visibilityHysteresis > VISIBILITY_COMPENSATION)
+    {
+        TC_LOG_ERROR("server.loading", "Visibility.Hysteresis can't be greater %f", VISIBILITY_COMPENSATION);
+        m_visibilityHysteresis = VISIBILITY_COMPENSATION;
+    }
+
     m_visibility_notify_periodOnContinents = sConfigMgr->GetIntDefault("Visibility.Notify.Period.OnContinents", DEFAULT_VISIBILITY_NOTIFY_PERIOD);
     m_visibility_notify_periodInInstances = sConfigMgr->GetIntDefault("Visibility.Notify.Period.InInstances", DEFAULT_VISIBILITY_NOTIFY_PERIOD);
     m_visibility_notify_periodInBGArenas = sConfigMgr->GetIntDefault("Visibility.Notify.Period.InBGArenas", DEFAULT_VISIBILITY_NOTIFY_PERIOD);
@@ -1339,6 +1374,8 @@ void World::LoadConfigSettings(bool reload)
         m_configs[CONFIG_TESTING_WARN_UPDATE_TIME_THRESHOLD] = m_configs[CONFIG_TESTING_MAX_UPDATE_TIME] + 50;
         TC_LOG_ERROR("server.loading", "Testing.WarnUpdateTimeThreshold can't be lower than Testing.MaxTestUpdateTime, setting it to %i", m_configs[CONFIG_TESTING_WARN_UPDATE_TIME_THRESHOLD]);
     }
+    m_configs[CONFIG_TESTING_SIMULATED_DIFF] = sConfigMgr->GetIntDefault("Testing.SimulatedDiff", 0);
+    m_configs[CONFIG_TESTING_WORKER_THREADS] = sConfigMgr->GetIntDefault("Testing.WorkerThreads", 0);
 
     m_configs[CONFIG_DEBUG_DISABLE_MAINHAND] = sConfigMgr->GetBoolDefault("Debug.DisableMainHand", 0);
     m_configs[CONFIG_DEBUG_DISABLE_ARMOR] = sConfigMgr->GetBoolDefault("Debug.DisableArmor", 0);
@@ -1913,7 +1950,7 @@ void World::SetInitialWorldSettings()
 
     m_timers[WUPDATE_CHECK_FILECHANGES].SetInterval(500);
 
-    m_timers[WUPDATE_WHO_LIST].SetInterval(5 * IN_MILLISECONDS); // update who list cache every 5 seconds
+    m_timers[WUPDATE_WHO_LIST].SetInterval(1 * IN_MILLISECONDS); // update who list entries of changed players every second
 
     //to set mailtimer to return mails every day between 4 and 5 am
     //mailtimer is increased when updating auctions
@@ -2168,9 +2205,17 @@ void World::Update(time_t diff)
 
     ///- Update objects (maps, transport, creatures,...)
     sWorldUpdateTime.RecordUpdateTimeReset();
+#ifdef TESTS
+    sTestMgr->BeginMapUpdates();
+#endif
     sMapMgr->Update(diff);
+#ifdef TESTS
+    sTestMgr->EndMapUpdates();
+#endif
     sWorldUpdateTime.RecordUpdateTimeDuration("UpdateMapMgr");
 
+    ObjectAccessor::ReclaimPlayerLookups();
+
 #ifdef TESTS
     //MUST be after map updates, testing code assumes so
     sWorldUpdateTime.RecordUpdateTimeReset();
@@ -2202,6 +2247,9 @@ void World::Update(time_t diff)
         UpdateArenaSeasonLogs();
     }
 
+    // send the character logins gathered since the last batch
+    sLoginQueryBatcher->Update(diff);
+
     // execute callbacks from sql queries that were queued recently
     sWorldUpdateTime.RecordUpdateTimeReset();
     ProcessQueryCallbacks();
@@ -2273,7 +2321,7 @@ void World::Update(time_t diff)
         if (!started)
         {
             ASSERT(!sTestMgr->IsRunning());
-            sTestMgr->Run(".*");
+            sTestMgr->Run(_CITestingPattern, nullptr, getIntConfig(CONFIG_TESTING_WORKER_THREADS));
             started = true;
         }
         else 
@@ -88,6 +88,11 @@ enum WorldConfigs
     CONFIG_INTERVAL_MAPUPDATE,
     CONFIG_INTERVAL_CHANGEWEATHER,
     CONFIG_INTERVAL_DISCONNECT_TOLERANCE,
+    CONFIG_LOGIN_BATCH_SIZE,
+    CONFIG_LOGIN_BATCH_WINDOW,
+    CONFIG_OBJECT_POOLS,
+    CONFIG_DBC_MEMORY_MAPPED,
+    CONFIG_PLAYER_SAVE_DIFFERENTIAL,
     CONFIG_PORT_WORLD,
     CONFIG_SOCKET_TIMEOUTTIME,
     CONFIG_SOCKET_TIMEOUTTIME_ACTIVE,
@@ -196,6 +201,11 @@ enum WorldConfigs
     CONFIG_RESPAWN_DYNAMICRATE_GAMEOBJECT,
 
     CONFIG_DETECT_POS_COLLISION,
+    CONFIG_UPDATE_LOD_ENABLED,
+    CONFIG_UPDATE_LOD_MID_INTERVAL,
+    CONFIG_UPDATE_LOD_FAR_DISTANCE,
+    CONFIG_UPDATE_LOD_FAR_INTERVAL,
+    CONFIG_LOS_CACHE_ENABLED,
     CONFIG_CHAT_FAKE_MESSAGE_PREVENTING,
     CONFIG_CHAT_STRICT_LINK_CHECKING_SEVERITY,
     CONFIG_CHAT_STRICT_LINK_CHECKING_KICK,
@@ -344,6 +354,8 @@ enum WorldConfigs
     CONFIG_TESTING_MAX_PARALLEL_TESTS,
     CONFIG_TESTING_MAX_UPDATE_TIME,
     CONFIG_TESTING_WARN_UPDATE_TIME_THRESHOLD,
+    CONFIG_TESTING_SIMULATED_DIFF,
+    CONFIG_TESTING_WORKER_THREADS,
 
     CONFIG_DEBUG_DISABLE_MAINHAND,
     CONFIG_DEBUG_DISABLE_ARMOR,
@@ -606,8 +618,8 @@ class TC_GAME_API World
         World();
         ~World();
 
-        // Continuous integration testing. If set, all tests are started, then when they're done the world will shutdown.
-        void SetCITesting();
+        // Continuous integration testing. If set, all tests matching pattern are started, then when they're done the world will shutdown.
+        void SetCITesting(std::string const& pattern);
 
         WorldSession* FindSession(uint32 id) const;
         void AddSession(WorldSession *s);
@@ -763,6 +775,8 @@ class TC_GAME_API World
         static float GetMaxVisibleDistanceInBGArenas()      { return m_MaxVisibleDistanceInBGArenas;   }
         static float GetMaxVisibleDistanceForObject()   { return m_MaxVisibleDistanceForObject;   }
         static float GetMaxVisibleDistanceInFlight()    { return m_MaxVisibleDistanceInFlight;    }
+        // objects become visible inside the sight range but stay visible up to sight range + hysteresis
+        static float GetVisibilityHysteresis()          { return m_visibilityHysteresis;          }
 
 		static int32 GetVisibilityNotifyPeriodOnContinents() { return m_visibility_notify_periodOnContinents; }
 		static int32 GetVisibilityNotifyPeriodInInstances() { return m_visibility_notify_periodInInstances; }
@@ -874,6 +888,7 @@ class TC_GAME_API World
         static float m_MaxVisibleDistanceInBGArenas;
         static float m_MaxVisibleDistanceForObject;
         static float m_MaxVisibleDistanceInFlight;
+        static float m_visibilityHysteresis;
 
 		static int32 m_visibility_notify_periodOnContinents;
 		static int32 m_visibility_notify_periodInInstances;
@@ -919,6 +934,7 @@ class TC_GAME_API World
         time_t _warnShutdownTime;
 
         bool _CITesting; //continuous integration testing
+        std::string _CITestingPattern;
 };
 
 TC_GAME_API extern Realm realm;
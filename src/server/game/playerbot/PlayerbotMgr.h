@@ -10,6 +10,7 @@ class Player;
 class Unit;
 class Object;
 class Item;
+class PlayerbotLoginQueryHolder;
 
 typedef map<uint64, Player*> PlayerBotMap;
 
@@ -21,6 +22,8 @@ public:
 
     //Connect bot to server
     Player* AddPlayerBot(ObjectGuid guid, uint32 masterAccountId, bool testingBot = false);
+    //Connect several bots, their characters are loaded together. Returns the bot of each guid, null if it failed
+    std::vector<Player*> AddPlayerBots(std::vector<ObjectGuid> const& guids, uint32 masterAccountId);
     void LogoutPlayerBot(ObjectGuid guid);
     Player* GetPlayerBot (ObjectGuid guid) const;
     PlayerBotMap::const_iterator GetPlayerBotsBegin() const { return playerBots.begin(); }
@@ -39,6 +42,10 @@ public:
 protected:
     virtual void OnBotLoginInternal(Player * const bot) = 0;
 
+private:
+    PlayerbotLoginQueryHolder* CreateLoginQueryHolder(ObjectGuid guid, uint32 masterAccountId);
+    Player* LoginPlayerBot(PlayerbotLoginQueryHolder* holder, bool testingBot);
+
 protected:
     PlayerBotMap playerBots;
 };
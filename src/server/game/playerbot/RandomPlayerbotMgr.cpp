@@ -58,16 +58,27 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed)
     }
 
     int botProcessed = 0;
+    vector<ObjectGuid> logins;
     for (list<uint32>::iterator i = bots.begin(); i != bots.end(); ++i)
     {
         uint32 bot = *i;
-        if (ProcessBot(bot))
+        if (ProcessBot(bot, logins))
             botProcessed++;
 
         if (botProcessed >= randomBotsPerInterval)
             break;
     }
 
+    // bots logging in are loaded together
+    vector<Player*> loggedIn = AddPlayerBots(logins, 0);
+    for (size_t i = 0; i < logins.size(); ++i)
+    {
+        if (loggedIn[i])
+            sLog->outMessage("playerbot", LOG_LEVEL_INFO, "Bot %d logged in", logins[i].GetCounter());
+        else
+            sLog->outMessage("playerbot", LOG_LEVEL_INFO, "Bot %d tried to log in but failed", logins[i].GetCounter());
+    }
+
     sLog->outMessage("playerbot", LOG_LEVEL_INFO, "%d bots processed. Next check in %d seconds",
         botProcessed, sPlayerbotAIConfig.randomBotUpdateInterval);
 
@@ -104,7 +115,7 @@ void RandomPlayerbotMgr::ScheduleTeleport(uint32 bot)
     SetEventValue(bot, "teleport", 1, 60 + urand(sPlayerbotAIConfig.randomBotUpdateInterval, sPlayerbotAIConfig.randomBotUpdateInterval * 3));
 }
 
-bool RandomPlayerbotMgr::ProcessBot(uint32 bot)
+bool RandomPlayerbotMgr::ProcessBot(uint32 bot, vector<ObjectGuid>& logins)
 {
     uint32 isValid = GetEventValue(bot, "add");
     ObjectGuid guid = ObjectGuid(HighGuid::Player, bot);
@@ -121,10 +132,7 @@ bool RandomPlayerbotMgr::ProcessBot(uint32 bot)
 
     if (!GetPlayerBot(guid))
     {
-        if(AddPlayerBot(guid, 0) != nullptr)
-            sLog->outMessage("playerbot", LOG_LEVEL_INFO, "Bot %d logged in", bot);
-        else
-            sLog->outMessage("playerbot", LOG_LEVEL_INFO, "Bot %d tried to log in but failed", bot);
+        logins.push_back(guid);
 
         if (!GetEventValue(bot, "online"))
         {
@@ -57,7 +57,7 @@ class TC_GAME_API RandomPlayerbotMgr : public PlayerbotHolder
         uint32 SetEventValue(uint32 bot, std::string event, uint32 value, uint32 validIn);
         list<uint32> GetBots();
         vector<uint32> GetFreeBots(bool alliance);
-        bool ProcessBot(uint32 bot);
+        bool ProcessBot(uint32 bot, vector<ObjectGuid>& logins);
         void ScheduleRandomize(uint32 bot, uint32 time);
         void RandomTeleport(Player* bot, uint16 mapId, float teleX, float teleY, float teleZ);
         void RandomTeleport(Player* bot, vector<WorldLocation> &locs);
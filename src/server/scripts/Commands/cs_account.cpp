@@ -5,6 +5,8 @@
 #include "WorldSession.h"
 #include "Player.h"
 #include "AccountMgr.h"
+#include "World.h"
+#include "WhoListStorage.h"
 
 class account_commandscript : public CommandScript
 {
@@ -405,6 +407,11 @@ public:
         //rbac = isAccountNameGiven ? NULL : handler->GetSelectedPlayer()->GetSession()->GetRBACData(); //TODO RBAC
         sAccountMgr->UpdateAccountAccess(rbac, targetAccountId, uint8(gm), gmRealmID);
 
+        // the who list shows and filters players by security
+        if (WorldSession* targetSession = sWorld->FindSession(targetAccountId))
+            if (Player* targetPlayer = targetSession->GetPlayer())
+                sWhoListStorageMgr->MarkDirty(targetPlayer->GetGUID());
+
         handler->PSendSysMessage(LANG_YOU_CHANGE_SECURITY, targetAccountName.c_str(), gm);
         return true;
     }
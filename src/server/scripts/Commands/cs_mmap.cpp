@@ -16,6 +16,7 @@
 #include "TemporarySummon.h"
 #include "Player.h"
 #include "WorldSession.h"
+#include "Monitor.h"
 #include <fstream>
 
 class mmaps_commandscript : public CommandScript
@@ -227,6 +228,9 @@ public:
         MMAP::MMapManager *manager = MMAP::MMapFactory::createOrGetMMapManager();
         handler->PSendSysMessage(" %u maps loaded with %u tiles overall", manager->getLoadedMapsCount(), manager->getLoadedTilesCount());
 
+        MMAP::NavMeshQueryPoolStats queryStats = sMonitor->GetNavMeshQueryPoolStats();
+        handler->PSendSysMessage(" query pool: " UI64FMTD " hits, " UI64FMTD " misses, " UI64FMTD " searches out of nodes", queryStats.hits, queryStats.misses, queryStats.exhausted);
+
         const dtNavMesh* navmesh = manager->GetNavMesh(handler->GetSession()->GetPlayer()->GetMapId());
         if (!navmesh)
         {
@@ -9,6 +9,7 @@
 #include "VMapFactory.h"
 #include "Realm.h"
 #include "MySQLThreading.h"
+#include "DatabaseEnv.h"
 #include "DatabaseLoader.h"
 #include "Config.h"
 #include "UpdateTime.h"
@@ -218,6 +219,31 @@ public:
         return true;
     }
 
+    static void SendDatabaseStats(ChatHandler* handler, char const* name, DatabaseWorkerStats const& stats)
+    {
+        if (!stats.operations)
+            return;
+
+        DatabaseStatementStats total;
+        uint32 slowestIndex = 0;
+        DatabaseStatementStats slowest;
+        for (auto const& itr : stats.statements)
+        {
+            total.Add(itr.second);
+            if (itr.first != SQLOperation::NO_STATEMENT && itr.second.latencySum > slowest.latencySum)
+            {
+                slowestIndex = itr.first;
+                slowest = itr.second;
+            }
+        }
+
+        handler->PSendSysMessage("%s database: " UI64FMTD " queued, " UI64FMTD " operations, " UI64FMTD " batches (" UI64FMTD " statements, " UI64FMTD " retried), latency avg/max: " UI64FMTD "/" UI64FMTD " us",
+            name, stats.queued, stats.operations, stats.batches, stats.batchedStatements, stats.batchRetries, total.latencySum / total.count, total.latencyMax);
+        if (slowest.count)
+            handler->PSendSysMessage("%s database: most time spent on statement %u, " UI64FMTD " executed, latency avg/max: " UI64FMTD "/" UI64FMTD " us",
+                name, slowestIndex, slowest.count, slowest.latencySum / slowest.count, slowest.latencyMax);
+    }
+
     static bool HandleServerInfoCommand(ChatHandler* handler, char const* /*args*/)
     {
         uint32 activeClientsNum = sWorld->GetActiveSessionCount();
@@ -237,6 +263,37 @@ public:
         handler->PSendSysMessage("Instant update time diff: %u.", sWorldUpdateTime.GetLastUpdateTime());
         if(currentMapTimeDiff != 0)
             handler->PSendSysMessage("Current map update time diff: %u.", currentMapTimeDiff);
+        if (sWorld->getBoolConfig(CONFIG_UPDATE_LOD_ENABLED))
+        {
+            CreatureUpdateLODStats lodStats = sMonitor->GetCreatureUpdateLODStats();
+            handler->PSendSysMessage("Creature updates (full/mid/far): " UI64FMTD "/" UI64FMTD "/" UI64FMTD ", delayed: " UI64FMTD "/" UI64FMTD,
+                lodStats.updates[UPDATE_LOD_FULL], lodStats.updates[UPDATE_LOD_MID], lodStats.updates[UPDATE_LOD_FAR],
+                lodStats.skipped[UPDATE_LOD_MID], lodStats.skipped[UPDATE_LOD_FAR]);
+        }
+        if (sWorld->getBoolConfig(CONFIG_LOS_CACHE_ENABLED))
+        {
+            LineOfSightCacheStats losStats = sMonitor->GetLineOfSightCacheStats();
+            handler->PSendSysMessage("Line of sight cache hits/misses: " UI64FMTD "/" UI64FMTD, losStats.hits, losStats.misses);
+        }
+        LoginBatchStats loginStats = sMonitor->GetLoginBatchStats();
+        if (loginStats.logins)
+            handler->PSendSysMessage("Logins: " UI64FMTD ", batches: " UI64FMTD " (" UI64FMTD " logins), latency avg/max: " UI64FMTD "/%u ms",
+                loginStats.logins, loginStats.batches, loginStats.batchedLogins, loginStats.latencySum / loginStats.logins, loginStats.latencyMax);
+        ObjectPoolStats poolStats = sMonitor->GetObjectPoolStats();
+        if (poolStats.allocated)
+            handler->PSendSysMessage("Object pools: " UI64FMTD " allocated, " UI64FMTD " reused, " UI64FMTD " freed from other threads, " UI64FMTD " released, " UI64FMTD " cached",
+                poolStats.allocated, poolStats.reused, poolStats.remoteFreed, poolStats.released, poolStats.cached);
+        QueryLatencyStats queryStats = sMonitor->GetQueryLatencyStats();
+        if (queryStats.count)
+            handler->PSendSysMessage("Async queries: " UI64FMTD ", latency avg/max: " UI64FMTD "/" UI64FMTD " us, waited after completion avg: " UI64FMTD " us",
+                queryStats.count, queryStats.latencySum / queryStats.count, queryStats.latencyMax, queryStats.readyWaitSum / queryStats.count);
+        PlayerSaveStats saveStats = sMonitor->GetPlayerSaveStats();
+        if (saveStats.saves)
+            handler->PSendSysMessage("Character saves: " UI64FMTD " (" UI64FMTD " full), rows written/skipped: " UI64FMTD "/" UI64FMTD ", partial characters rows: " UI64FMTD,
+                saveStats.saves, saveStats.fullSaves, saveStats.rowsWritten, saveStats.rowsSkipped, saveStats.partialCharacterRows);
+        SendDatabaseStats(handler, "Character", CharacterDatabase.GetStats());
+        SendDatabaseStats(handler, "World", WorldDatabase.GetStats());
+        SendDatabaseStats(handler, "Login", LoginDatabase.GetStats());
         if (sWorld->IsShuttingDown())
             handler->PSendSysMessage("Server restart in %s", secsToTimeString(sWorld->GetShutDownTimeLeft()).c_str());
 
@@ -25,6 +25,20 @@ void AddSC_test_talents_warlock();
 void AddSC_test_talents_warrior();
 void AddSC_test_creature();
 void AddSC_test_pools();
+void AddSC_test_timing_wheel();
+void AddSC_test_terrain_sampling();
+void AddSC_test_line_of_sight();
+void AddSC_test_load_generator();
+void AddSC_test_srp6();
+void AddSC_test_query_result();
+void AddSC_test_object_pools();
+void AddSC_test_loot_tables();
+void AddSC_test_conditions();
+void AddSC_test_dbc_files();
+void AddSC_test_spell_info_store();
+void AddSC_test_query_callbacks();
+void AddSC_test_database_batches();
+void AddSC_test_player_saves();
 
 void AddTestsScripts()
 {
@@ -35,6 +49,20 @@ void AddTestsScripts()
     AddSC_test_creature();
 	AddSC_test_pools();
     AddSC_test_movement_point();
+    AddSC_test_timing_wheel();
+    AddSC_test_terrain_sampling();
+    AddSC_test_line_of_sight();
+    AddSC_test_load_generator();
+    AddSC_test_srp6();
+    AddSC_test_query_result();
+    AddSC_test_object_pools();
+    AddSC_test_loot_tables();
+    AddSC_test_conditions();
+    AddSC_test_dbc_files();
+    AddSC_test_spell_info_store();
+    AddSC_test_query_callbacks();
+    AddSC_test_database_batches();
+    AddSC_test_player_saves();
 
 	AddSC_test_spells_druid();
 	AddSC_test_spells_hunter();
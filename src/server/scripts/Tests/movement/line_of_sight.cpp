@@ -0,0 +1,74 @@
+#include "TestCase.h"
+#include "Map.h"
+#include "Random.h"
+#include "Log.h"
+
+// "movement line of sight fan"
+// Compares the rays of a fan cast together with the same rays cast one by one, around the Crossroads buildings
+class LineOfSightFanTest : public TestCase
+{
+public:
+    LineOfSightFanTest() : TestCase(WorldLocation(1, -450.0f, -2650.0f, 96.0f)) { }
+
+    static uint32 const FANS = 200;
+    static uint32 const RAYS = 32;
+
+    void Test() override
+    {
+        Map* map = GetMap();
+        std::vector<Position> origins;
+        std::vector<Position> targets;
+        for (uint32 i = 0; i < FANS; i++)
+        {
+            Position origin(GetLocation().GetPositionX() + frand(-60.0f, 60.0f), GetLocation().GetPositionY() + frand(-60.0f, 60.0f), GetLocation().GetPositionZ() + frand(0.0f, 10.0f));
+            origins.push_back(origin);
+            for (uint32 j = 0; j < RAYS; j++)
+                targets.emplace_back(origin.GetPositionX() + frand(-40.0f, 40.0f), origin.GetPositionY() + frand(-40.0f, 40.0f), origin.GetPositionZ() + frand(-5.0f, 5.0f));
+        }
+
+        std::vector<bool> single(targets.size());
+        std::unique_ptr<bool[]> fan(new bool[targets.size()]);
+        uint64 singleTime = Measure([&]()
+        {
+            for (uint32 i = 0; i < FANS; i++)
+            {
+                map->InvalidateLineOfSightCache();
+                Position const& origin = origins[i];
+                for (uint32 j = 0; j < RAYS; j++)
+                {
+                    Position const& target = targets[i * RAYS + j];
+                    single[i * RAYS + j] = map->isInLineOfSight(origin.GetPositionX(), origin.GetPositionY(), origin.GetPositionZ(),
+                        target.GetPositionX(), target.GetPositionY(), target.GetPositionZ(), PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::Nothing);
+                }
+            }
+        });
+
+        uint64 fanTime = Measure([&]()
+        {
+            for (uint32 i = 0; i < FANS; i++)
+            {
+                map->InvalidateLineOfSightCache();
+                Position const& origin = origins[i];
+                map->isInLineOfSight(origin.GetPositionX(), origin.GetPositionY(), origin.GetPositionZ(), &targets[i * RAYS], RAYS,
+                    PHASEMASK_NORMAL, LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::Nothing, &fan[i * RAYS]);
+            }
+        });
+
+        uint32 blocked = 0;
+        for (uint32 i = 0; i < targets.size(); i++)
+        {
+            ASSERT_INFO("Ray %u: %u one by one, %u in fan", i, uint32(single[i]), uint32(fan[i]));
+            TEST_ASSERT(single[i] == fan[i]);
+            if (!single[i])
+                blocked++;
+        }
+
+        TC_LOG_INFO("test.unit_test", "Line of sight benchmark: %u fans of %u rays (%u blocked), one by one %u us, as fans %u us",
+            FANS, RAYS, blocked, uint32(singleTime), uint32(fanTime));
+    }
+};
+
+void AddSC_test_line_of_sight()
+{
+    RegisterTestCase("movement line of sight fan", LineOfSightFanTest);
+}
@@ -0,0 +1,66 @@
+#include "TestCase.h"
+#include "Map.h"
+#include "Random.h"
+#include "Log.h"
+
+// "movement terrain heights"
+// Compares batched grid heights with the one point version, around the Crossroads and over several grids
+class TerrainHeightsTest : public TestCase
+{
+public:
+    TerrainHeightsTest() : TestCase(WorldLocation(1, -450.0f, -2650.0f, 96.0f)) { }
+
+    static uint32 const PATHS = 2000;
+    static uint32 const PATH_POINTS = 16;
+    static uint32 const ITERATIONS = 50;
+
+    void Test() override
+    {
+        // points are grouped in short straight paths like the ones movement generators sample
+        std::vector<float> x, y;
+        for (uint32 i = 0; i < PATHS; i++)
+        {
+            float const startX = GetLocation().GetPositionX() + frand(-1000.0f, 1000.0f);
+            float const startY = GetLocation().GetPositionY() + frand(-1000.0f, 1000.0f);
+            float const angle = frand(0.0f, 2 * float(M_PI));
+            float const step = frand(0.1f, 3.0f);
+            for (uint32 j = 0; j < PATH_POINTS; j++)
+            {
+                x.push_back(startX + j * step * std::cos(angle));
+                y.push_back(startY + j * step * std::sin(angle));
+            }
+        }
+
+        uint32 const count = x.size();
+        std::vector<float> single(count), batched(count);
+        GetMap()->GetGridMapHeights(x.data(), y.data(), batched.data(), count);
+        for (uint32 i = 0; i < count; i++)
+        {
+            single[i] = GetMap()->GetGridMapHeight(x[i], y[i]);
+            ASSERT_INFO("Point %f %f: height %f, batched height %f", x[i], y[i], single[i], batched[i]);
+            TEST_ASSERT(std::fabs(single[i] - batched[i]) < 0.01f);
+        }
+
+        uint64 singleTime = Measure([&]()
+        {
+            for (uint32 n = 0; n < ITERATIONS; n++)
+                for (uint32 i = 0; i < count; i++)
+                    single[i] = GetMap()->GetGridMapHeight(x[i], y[i]);
+        });
+
+        uint64 batchedTime = Measure([&]()
+        {
+            for (uint32 n = 0; n < ITERATIONS; n++)
+                for (uint32 i = 0; i < count; i += PATH_POINTS)
+                    GetMap()->GetGridMapHeights(&x[i], &y[i], &batched[i], PATH_POINTS);
+        });
+
+        TC_LOG_INFO("test.unit_test", "Terrain heights benchmark: %u points x %u, one by one %u us, batched by %u %u us",
+            count, ITERATIONS, uint32(singleTime), PATH_POINTS, uint32(batchedTime));
+    }
+};
+
+void AddSC_test_terrain_sampling()
+{
+    RegisterTestCase("movement terrain heights", TerrainHeightsTest);
+}
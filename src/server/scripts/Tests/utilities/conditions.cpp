@@ -0,0 +1,60 @@
+#include "TestCase.h"
+#include "TestPlayer.h"
+#include "TemporarySummon.h"
+#include "ConditionMgr.h"
+#include "Log.h"
+
+// "utilities conditions"
+// Evaluates every condition list of the `conditions` table interpreted and compiled, checks both give the
+// same result and benchmarks them
+class ConditionsTest : public TestCase
+{
+public:
+    static uint32 const ITERATIONS = 20;
+
+    void Test() override
+    {
+        TestPlayer* player = SpawnPlayer(CLASS_PRIEST, RACE_HUMAN);
+        Creature* creature = SpawnCreature();
+        auto const& lists = sConditionMgr->GetCompiledLists();
+
+        for (auto const& compiled : lists)
+        {
+            ConditionContainer const& conditions = compiled->GetSource();
+            // both start from the same targets, the failed condition they report may differ
+            ConditionSourceInfo interpretedInfo(player, creature, player);
+            ConditionSourceInfo compiledInfo(player, creature, player);
+            bool const interpreted = sConditionMgr->IsObjectMeetToConditionsInterpreted(interpretedInfo, conditions);
+            ASSERT_INFO("%s", conditions.front()->ToString(true).c_str());
+            TEST_ASSERT(sConditionMgr->IsObjectMeetToConditions(compiledInfo, conditions) == interpreted);
+        }
+
+        uint32 met = 0;
+        uint64 const interpretedTime = Measure([&]()
+        {
+            for (uint32 i = 0; i < ITERATIONS; i++)
+                for (auto const& compiled : lists)
+                {
+                    ConditionSourceInfo info(player, creature, player);
+                    met += uint32(sConditionMgr->IsObjectMeetToConditionsInterpreted(info, compiled->GetSource()));
+                }
+        });
+        uint64 const compiledTime = Measure([&]()
+        {
+            for (uint32 i = 0; i < ITERATIONS; i++)
+                for (auto const& compiled : lists)
+                {
+                    ConditionSourceInfo info(player, creature, player);
+                    met += uint32(sConditionMgr->IsObjectMeetToConditions(info, compiled->GetSource()));
+                }
+        });
+
+        TC_LOG_INFO("test.unit_test", "Conditions benchmark: %u lists x %u, interpreted %u us, compiled %u us (%u met)",
+            uint32(lists.size()), ITERATIONS, uint32(interpretedTime), uint32(compiledTime), met);
+    }
+};
+
+void AddSC_test_conditions()
+{
+    RegisterTestCase("utilities conditions", ConditionsTest);
+}
@@ -0,0 +1,78 @@
+#include "TestCase.h"
+#include "DatabaseEnv.h"
+#include "Config.h"
+#include "Log.h"
+#include <chrono>
+#include <thread>
+
+// "utilities database batches"
+// Enqueues many one-way statements on the character database, waits for the async workers to execute them
+// and checks the batches they were executed in, then reports the throughput and the batch sizes
+class DatabaseBatchesTest : public TestCase
+{
+public:
+    static uint32 const STATEMENTS = 2000;
+    static uint32 const NO_CHARACTER = 0; // no character has this guid, the statements do not change anything
+
+    static DatabaseStatementStats GetStatementStats(DatabaseWorkerStats const& stats, uint32 index)
+    {
+        auto itr = stats.statements.find(index);
+        return itr != stats.statements.end() ? itr->second : DatabaseStatementStats();
+    }
+
+    void Test() override
+    {
+        uint32 const batchMaxSize = std::max(sConfigMgr->GetIntDefault("CharacterDatabase.BatchSize", 32), 1);
+        DatabaseWorkerStats const before = CharacterDatabase.GetStats();
+
+        auto const start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < STATEMENTS; i++)
+        {
+            PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
+            stmt->setUInt32(0, NO_CHARACTER);
+            CharacterDatabase.Execute(stmt);
+        }
+
+        DatabaseWorkerStats after;
+        for (uint32 i = 0; i < 1000; i++)
+        {
+            after = CharacterDatabase.GetStats();
+            if (GetStatementStats(after, CHAR_DEL_CHAR_AURA).count - GetStatementStats(before, CHAR_DEL_CHAR_AURA).count >= STATEMENTS)
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        uint64 const time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        DatabaseStatementStats const statement = GetStatementStats(after, CHAR_DEL_CHAR_AURA);
+        DatabaseStatementStats const statementBefore = GetStatementStats(before, CHAR_DEL_CHAR_AURA);
+        ASSERT_INFO("%u statements executed out of %u", uint32(statement.count - statementBefore.count), STATEMENTS);
+        TEST_ASSERT(statement.count - statementBefore.count >= STATEMENTS);
+        TEST_ASSERT(after.operations - before.operations >= STATEMENTS);
+
+        uint64 const batches = after.batches - before.batches;
+        uint64 const batchedStatements = after.batchedStatements - before.batchedStatements;
+        if (batchMaxSize == 1)
+        {
+            TEST_ASSERT(batches == 0);
+        }
+        else
+        {
+            // statements were queued much faster than executed
+            TEST_ASSERT(batches > 0);
+            TEST_ASSERT(batchedStatements >= 2 * batches);
+            TEST_ASSERT(batchedStatements <= batchMaxSize * batches);
+        }
+
+        std::string sizes;
+        for (uint32 i = 0; i < DatabaseWorkerStats::BATCH_SIZE_BUCKETS; i++)
+            sizes += std::to_string(after.batchSizes[i] - before.batchSizes[i]) + (i + 1 < DatabaseWorkerStats::BATCH_SIZE_BUCKETS ? "/" : "");
+
+        TC_LOG_INFO("test.unit_test", "Database batches: %u statements in %u us, " UI64FMTD " batches of " UI64FMTD " statements (sizes from 2: %s), " UI64FMTD " retried",
+            STATEMENTS, uint32(time), batches, batchedStatements, sizes.c_str(), after.batchRetries - before.batchRetries);
+    }
+};
+
+void AddSC_test_database_batches()
+{
+    RegisterTestCase("utilities database batches", DatabaseBatchesTest);
+}
@@ -0,0 +1,169 @@
+#include "TestCase.h"
+#include "DBCFileLoader.h"
+#include "DBCStores.h"
+#include "DBCfmt.h"
+#include "World.h"
+#include "Log.h"
+#include <fstream>
+
+// "utilities dbc files"
+// Loads the same dbc files read in heap buffers and memory mapped, compares every entry, then reports
+// the load times and the memory used by each loader
+class DBCFilesTest : public TestCase
+{
+public:
+    // KB, private memory and file backed memory (shared with the page cache)
+    struct Memory
+    {
+        int64 anon = 0;
+        int64 file = 0;
+    };
+
+    static Memory GetMemory()
+    {
+        Memory memory;
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_UNIX
+        std::ifstream status("/proc/self/status");
+        std::string key;
+        while (status >> key)
+        {
+            if (key == "RssAnon:")
+                status >> memory.anon;
+            else if (key == "RssFile:")
+                status >> memory.file;
+        }
+#endif
+        return memory;
+    }
+
+    struct Stores
+    {
+        Stores() : spell(SpellEntryfmt), faction(FactionEntryfmt), areaTable(AreaTableEntryfmt), map(MapEntryfmt),
+            lock(LockEntryfmt), spellDuration(SpellDurationfmt) { }
+
+        bool Load(std::string const& path)
+        {
+            return spell.Load((path + "Spell.dbc").c_str())
+                && faction.Load((path + "Faction.dbc").c_str())
+                && areaTable.Load((path + "AreaTable.dbc").c_str())
+                && map.Load((path + "Map.dbc").c_str())
+                && lock.Load((path + "Lock.dbc").c_str())
+                && spellDuration.Load((path + "SpellDuration.dbc").c_str());
+        }
+
+        DBCStorage<SpellEntry> spell;
+        DBCStorage<FactionEntry> faction;
+        DBCStorage<AreaTableEntry> areaTable;
+        DBCStorage<MapEntry> map;
+        DBCStorage<LockEntry> lock;
+        DBCStorage<SpellDurationEntry> spellDuration;
+    };
+
+    template<class T>
+    void TestSame(DBCStorage<T>& read, DBCStorage<T>& mapped, char const* name)
+    {
+        ASSERT_INFO("%s: %u rows read, %u rows mapped", name, read.GetNumRows(), mapped.GetNumRows());
+        TEST_ASSERT(read.GetNumRows() == mapped.GetNumRows());
+
+        char const* format = read.GetFormat();
+        for (uint32 id = 0; id < read.GetNumRows(); id++)
+        {
+            char const* readEntry = reinterpret_cast<char const*>(read.LookupEntry(id));
+            char const* mappedEntry = reinterpret_cast<char const*>(mapped.LookupEntry(id));
+            if (!readEntry || !mappedEntry)
+            {
+                ASSERT_INFO("%s: entry %u only exists in one of the stores", name, id);
+                TEST_ASSERT(readEntry == mappedEntry);
+                continue;
+            }
+
+            // same layout as DBCFileLoader::AutoProduceData
+            uint32 offset = 0;
+            for (uint32 x = 0; format[x]; x++)
+            {
+                uint32 size;
+                switch (format[x])
+                {
+                    case FT_STRING:
+                    {
+                        char const* readString = *reinterpret_cast<char* const*>(readEntry + offset);
+                        char const* mappedString = *reinterpret_cast<char* const*>(mappedEntry + offset);
+                        if (strcmp(readString ? readString : "", mappedString ? mappedString : "") != 0)
+                        {
+                            ASSERT_INFO("%s: entry %u field %u, \"%s\" read, \"%s\" mapped", name, id, x, readString, mappedString);
+                            TEST_ASSERT(false);
+                        }
+                        offset += sizeof(char*);
+                        continue;
+                    }
+                    case FT_FLOAT:
+                    case FT_INT:
+                    case FT_IND:
+                        size = sizeof(uint32);
+                        break;
+                    case FT_BYTE:
+                        size = sizeof(uint8);
+                        break;
+                    default:
+                        continue;
+                }
+
+                if (memcmp(readEntry + offset, mappedEntry + offset, size) != 0)
+                {
+                    ASSERT_INFO("%s: entry %u field %u differs", name, id, x);
+                    TEST_ASSERT(false);
+                }
+                offset += size;
+            }
+        }
+    }
+
+    void Test() override
+    {
+        TEST_ASSERT(DBCFileLoader::IsInPlaceFormat(LockEntryfmt));
+        TEST_ASSERT(DBCFileLoader::IsInPlaceFormat(SpellDurationfmt));
+        TEST_ASSERT(!DBCFileLoader::IsInPlaceFormat(SpellEntryfmt));
+        TEST_ASSERT(!DBCFileLoader::IsInPlaceFormat(SpellRadiusfmt));
+
+        std::string const path = sWorld->GetDataPath() + "dbc/";
+        bool const wasMapped = DBCFileLoader::IsMemoryMapped();
+
+        // first load to have the files in the page cache for both loaders
+        DBCFileLoader::SetMemoryMapped(false);
+        bool loaded = Stores().Load(path);
+
+        std::unique_ptr<Stores> read = Trinity::make_unique<Stores>();
+        Memory const beforeRead = GetMemory();
+        uint64 const readTime = Measure([&]() { loaded = read->Load(path) && loaded; });
+        Memory const afterRead = GetMemory();
+
+        DBCFileLoader::SetMemoryMapped(true);
+        std::unique_ptr<Stores> mapped = Trinity::make_unique<Stores>();
+        uint64 const mappedTime = Measure([&]() { loaded = mapped->Load(path) && loaded; });
+        Memory const afterMapped = GetMemory();
+
+        DBCFileLoader::SetMemoryMapped(wasMapped);
+        TEST_ASSERT(loaded);
+
+        TC_LOG_INFO("test.unit_test", "DBC files benchmark: read %u us (private " SI64FMTD " KB, file " SI64FMTD " KB), mapped %u us (private " SI64FMTD " KB, file " SI64FMTD " KB)",
+            uint32(readTime), afterRead.anon - beforeRead.anon, afterRead.file - beforeRead.file,
+            uint32(mappedTime), afterMapped.anon - afterRead.anon, afterMapped.file - afterRead.file);
+
+        TestSame(read->spell, mapped->spell, "Spell.dbc");
+        TestSame(read->faction, mapped->faction, "Faction.dbc");
+        TestSame(read->areaTable, mapped->areaTable, "AreaTable.dbc");
+        TestSame(read->map, mapped->map, "Map.dbc");
+        TestSame(read->lock, mapped->lock, "Lock.dbc");
+        TestSame(read->spellDuration, mapped->spellDuration, "SpellDuration.dbc");
+
+        // comparing touched the strings of the mapped files, only what was used is in memory
+        Memory const afterCompare = GetMemory();
+        TC_LOG_INFO("test.unit_test", "DBC files benchmark: mapped files in memory after reading every entry: " SI64FMTD " KB",
+            afterCompare.file - afterRead.file);
+    }
+};
+
+void AddSC_test_dbc_files()
+{
+    RegisterTestCase("utilities dbc files", DBCFilesTest);
+}
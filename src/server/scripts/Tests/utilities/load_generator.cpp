@@ -0,0 +1,63 @@
+#include "TestCase.h"
+#include "TestPlayer.h"
+#include "LoadGenerator.h"
+#include "Monitor.h"
+#include "Map.h"
+
+// "utilities load generator"
+// Drives synthetic client sessions through the real opcode handlers and reports tick times and packet volume
+class LoadGeneratorTest : public TestCase
+{
+public:
+    static uint32 const SESSIONS = 25;
+    static uint32 const TICKS = 200;
+    static uint32 const SPELL_POWER_WORD_FORTITUDE_RNK_1 = 1243;
+
+    void Test() override
+    {
+        LoadGenerator generator(LoadGenerator::ACTION_ALL, SPELL_POWER_WORD_FORTITUDE_RNK_1);
+        std::vector<TestPlayer*> players;
+        for (uint32 i = 0; i < SESSIONS; i++)
+        {
+            // spread the sessions so that they all see each other
+            Position spawnPosition(_location);
+            spawnPosition.m_positionX += float(i % 5) * 5.0f;
+            spawnPosition.m_positionY += float(i / 5) * 5.0f;
+            TestPlayer* priest = SpawnPlayer(CLASS_PRIEST, RACE_HUMAN, 70, spawnPosition);
+            priest->LearnSpell(SPELL_POWER_WORD_FORTITUDE_RNK_1, false);
+            generator.AddSession(priest);
+            players.push_back(priest);
+        }
+
+        std::vector<Position> startPositions;
+        for (TestPlayer* player : players)
+            startPositions.push_back(player->GetPosition());
+
+        uint32 lastTime = GetMap()->GetGameTimeMS();
+        for (uint32 i = 0; i < TICKS; i++)
+        {
+            uint32 const now = GetMap()->GetGameTimeMS();
+            generator.Tick(now - lastTime);
+            lastTime = now;
+            WaitNextUpdate();
+            generator.AddMapTickTime(sMonitor->GetLastDiffForMap(*GetMap()));
+        }
+
+        // movement packets went through the handlers
+        for (uint32 i = 0; i < players.size(); i++)
+        {
+            ASSERT_INFO("Player %u did not move", i);
+            TEST_ASSERT(players[i]->GetExactDist2d(startPositions[i].GetPositionX(), startPositions[i].GetPositionY()) > 1.0f);
+        }
+
+        LoadGenerator::Report report = generator.GetReport();
+        TEST_ASSERT(report.ticks == TICKS);
+        TEST_ASSERT(report.packetsSent > 0);
+        generator.LogReport("priests moving, chatting and casting");
+    }
+};
+
+void AddSC_test_load_generator()
+{
+    RegisterTestCase("utilities load generator", LoadGeneratorTest);
+}
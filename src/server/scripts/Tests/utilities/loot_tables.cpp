@@ -0,0 +1,177 @@
+#include "TestCase.h"
+#include "LootMgr.h"
+#include "Loot.h"
+#include "World.h"
+#include "Log.h"
+
+// "utilities loot tables"
+// Rolls in memory loot templates with the compiled tables (alias method) and with the entry lists, checks
+// with chi-square tests that both give the expected drop distributions, then benchmarks them
+class LootTablesTest : public TestCase
+{
+public:
+    static uint32 const ROLLS = 20000;
+    // common quality items
+    static uint32 const ITEM_A = 2589;  // Linen Cloth
+    static uint32 const ITEM_B = 2592;  // Wool Cloth
+    static uint32 const ITEM_C = 4306;  // Silk Cloth
+    static uint32 const ITEM_D = 4338;  // Mageweave Cloth
+    static uint32 const ITEM_E = 14047; // Runecloth
+
+    typedef std::vector<std::pair<uint32, double>> Distribution; // item, expected drop chance (0..1) per roll
+
+    static void AddEntry(LootTemplate& lootTemplate, uint32 itemId, float chance, uint8 groupId, uint16 lootMode = LOOT_MODE_DEFAULT)
+    {
+        lootTemplate.AddEntry(new LootStoreItem(itemId, 0, chance, false, lootMode, groupId, 1, 1));
+    }
+
+    // Chi-square critical values at p = 0.001, by degrees of freedom
+    static double CriticalValue(uint32 degrees)
+    {
+        static double const values[] = { 0.0, 10.83, 13.82, 16.27, 18.47, 20.52, 22.46 };
+        ASSERT(degrees < std::size(values));
+        return values[degrees];
+    }
+
+    // Number of rolls which dropped each item of the distribution, the last count is for rolls which dropped none of them
+    static std::vector<uint32> Roll(LootTemplate const& lootTemplate, Distribution const& distribution, uint16 lootMode, bool linear)
+    {
+        std::vector<uint32> counts(distribution.size() + 1, 0);
+        Loot loot;
+        for (uint32 i = 0; i < ROLLS; i++)
+        {
+            loot.clear();
+            lootTemplate.Process(loot, true, lootMode, 0, linear);
+            bool dropped = false;
+            for (LootItem const& item : loot.items)
+                for (uint32 j = 0; j < distribution.size(); j++)
+                    if (item.itemid == distribution[j].first)
+                    {
+                        counts[j]++;
+                        dropped = true;
+                    }
+            if (!dropped)
+                counts.back()++;
+        }
+        return counts;
+    }
+
+    void TestFit(std::vector<uint32> const& counts, Distribution const& distribution, char const* name)
+    {
+        double missChance = 1.0;
+        for (auto const& itr : distribution)
+            missChance -= itr.second;
+
+        double chiSquare = 0.0;
+        uint32 categories = 0;
+        for (uint32 i = 0; i < counts.size(); i++)
+        {
+            double const expected = (i < distribution.size() ? distribution[i].second : missChance) * ROLLS;
+            if (expected < 1.0)
+            {
+                ASSERT_INFO("%s: category %u expected to never drop, dropped %u times", name, i, counts[i]);
+                TEST_ASSERT(counts[i] == 0);
+                continue;
+            }
+            chiSquare += (counts[i] - expected) * (counts[i] - expected) / expected;
+            categories++;
+        }
+
+        ASSERT_INFO("%s: chi-square %f for %u categories", name, chiSquare, categories);
+        TEST_ASSERT(categories < 2 || chiSquare < CriticalValue(categories - 1));
+    }
+
+    // Two samples of the same size come from the same distribution
+    void TestSame(std::vector<uint32> const& compiled, std::vector<uint32> const& linear, char const* name)
+    {
+        double chiSquare = 0.0;
+        uint32 categories = 0;
+        for (uint32 i = 0; i < compiled.size(); i++)
+        {
+            if (!compiled[i] && !linear[i])
+                continue;
+            double const diff = double(compiled[i]) - double(linear[i]);
+            chiSquare += diff * diff / (compiled[i] + linear[i]);
+            categories++;
+        }
+
+        ASSERT_INFO("%s: compiled and linear rolls differ, chi-square %f for %u categories", name, chiSquare, categories);
+        TEST_ASSERT(categories < 2 || chiSquare < CriticalValue(categories - 1));
+    }
+
+    void TestDistribution(LootTemplate const& lootTemplate, Distribution const& distribution, uint16 lootMode, char const* name)
+    {
+        std::vector<uint32> const compiled = Roll(lootTemplate, distribution, lootMode, false);
+        std::vector<uint32> const linear = Roll(lootTemplate, distribution, lootMode, true);
+        TestFit(compiled, distribution, name);
+        TestFit(linear, distribution, name);
+        TestSame(compiled, linear, name);
+    }
+
+    void Test() override
+    {
+        // Explicitly chanced entries then equal chanced entries sharing what is left
+        LootTemplate group;
+        AddEntry(group, ITEM_A, 30.0f, 1);
+        AddEntry(group, ITEM_B, 20.0f, 1);
+        AddEntry(group, ITEM_C, 10.0f, 1, LOOT_MODE_HARD_MODE_1);
+        AddEntry(group, ITEM_D, 0.0f, 1);
+        AddEntry(group, ITEM_E, 0.0f, 1);
+        group.Compile();
+        TestDistribution(group, { { ITEM_A, 0.3 }, { ITEM_B, 0.2 }, { ITEM_C, 0.1 }, { ITEM_D, 0.2 }, { ITEM_E, 0.2 } }, LOOT_MODE_DEFAULT | LOOT_MODE_HARD_MODE_1, "group");
+        // an entry filtered out by the loot mode leaves its chance to the equal chanced entries
+        TestDistribution(group, { { ITEM_A, 0.3 }, { ITEM_B, 0.2 }, { ITEM_C, 0.0 }, { ITEM_D, 0.25 }, { ITEM_E, 0.25 } }, LOOT_MODE_DEFAULT, "loot mode");
+
+        // Chances over 100%, the last entry is cut (linear roll kept)
+        LootTemplate overflow;
+        AddEntry(overflow, ITEM_A, 70.0f, 1);
+        AddEntry(overflow, ITEM_B, 50.0f, 1);
+        overflow.Compile();
+        TestDistribution(overflow, { { ITEM_A, 0.7 }, { ITEM_B, 0.3 } }, LOOT_MODE_DEFAULT, "overflow");
+
+        // A non-grouped entry always dropping the same item filters it out of the group (one duplicate allowed)
+        LootTemplate duplicate;
+        AddEntry(duplicate, ITEM_A, 100.0f, 0);
+        AddEntry(duplicate, ITEM_A, 50.0f, 1);
+        AddEntry(duplicate, ITEM_B, 25.0f, 1);
+        duplicate.Compile();
+        TestDistribution(duplicate, { { ITEM_B, 0.25 } }, LOOT_MODE_DEFAULT, "duplicate");
+
+        // Non-grouped entries use the quality rates
+        LootTemplate single;
+        AddEntry(single, ITEM_C, 40.0f, 0);
+        single.Compile();
+        double const singleChance = std::min(1.0, 0.4 * sWorld->GetRate(RATE_DROP_ITEM_NORMAL));
+        TestDistribution(single, { { ITEM_C, singleChance } }, LOOT_MODE_DEFAULT, "non-grouped");
+
+        // Benchmark on a bigger group
+        LootTemplate big;
+        uint32 const bigItems[] = { ITEM_A, ITEM_B, ITEM_C, ITEM_D, ITEM_E };
+        for (uint32 i = 0; i < 20; i++)
+            AddEntry(big, bigItems[i % 5], i < 15 ? 5.0f : 0.0f, 1 + i / 5 % 2);
+        big.Compile();
+        Loot loot;
+        uint64 const linearTime = Measure([&]()
+        {
+            for (uint32 i = 0; i < ROLLS; i++)
+            {
+                loot.clear();
+                big.Process(loot, true, LOOT_MODE_DEFAULT, 0, true);
+            }
+        });
+        uint64 const compiledTime = Measure([&]()
+        {
+            for (uint32 i = 0; i < ROLLS; i++)
+            {
+                loot.clear();
+                big.Process(loot, true, LOOT_MODE_DEFAULT);
+            }
+        });
+        TC_LOG_INFO("test.unit_test", "Loot tables benchmark: %u rolls, linear %u us, compiled %u us", ROLLS, uint32(linearTime), uint32(compiledTime));
+    }
+};
+
+void AddSC_test_loot_tables()
+{
+    RegisterTestCase("utilities loot tables", LootTablesTest);
+}
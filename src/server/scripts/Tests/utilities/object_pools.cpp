@@ -0,0 +1,67 @@
+#include "TestCase.h"
+#include "ObjectPool.h"
+#include "Monitor.h"
+#include "World.h"
+#include "Log.h"
+
+// "utilities object pools"
+// Runs the same existing spell tests (priest direct damage, damage over time and heals) with the spell and aura
+// object pools disabled then enabled, checks the pools serve the allocations and benchmarks both
+class ObjectPoolsTest : public TestCase
+{
+public:
+    uint64 MeasureWorkload()
+    {
+        static char const* const workload[] =
+        {
+            "spells priest smite",
+            "spells priest mind_blast",
+            "spells priest shadow_word_pain",
+            "spells priest flash_heal",
+            "spells priest renew",
+        };
+
+        return Measure([&]()
+        {
+            for (char const* testName : workload)
+            {
+                ASSERT_INFO("Test %s could not be run", testName);
+                TEST_ASSERT(RunNestedTest(testName));
+            }
+        });
+    }
+
+    void Test() override
+    {
+        ObjectPool::SetEnabled(false);
+        ObjectPoolStats const before = sMonitor->GetObjectPoolStats();
+        uint64 const heapTime = MeasureWorkload();
+        ObjectPoolStats const afterHeap = sMonitor->GetObjectPoolStats();
+        ObjectPool::SetEnabled(true);
+        uint64 const poolTime = MeasureWorkload();
+        ObjectPoolStats const afterPool = sMonitor->GetObjectPoolStats();
+        ObjectPool::SetEnabled(sWorld->getConfig(CONFIG_OBJECT_POOLS));
+
+        // nothing taken from the pools while disabled
+        TEST_ASSERT(afterHeap.allocated == before.allocated);
+        TEST_ASSERT(afterHeap.reused == before.reused);
+        // spells and auras are created over and over, blocks must be reused
+        uint64 const allocated = afterPool.allocated - afterHeap.allocated;
+        uint64 const reused = afterPool.reused - afterHeap.reused;
+        TEST_ASSERT(reused > 0);
+        TEST_ASSERT(reused > allocated);
+
+        TC_LOG_INFO("test.unit_test", "Object pools benchmark: heap %u us, pools %u us (" UI64FMTD " blocks allocated, " UI64FMTD " reused)",
+            uint32(heapTime), uint32(poolTime), allocated, reused);
+    }
+
+    void Cleanup() override
+    {
+        ObjectPool::SetEnabled(sWorld->getConfig(CONFIG_OBJECT_POOLS));
+    }
+};
+
+void AddSC_test_object_pools()
+{
+    RegisterTestCase("utilities object pools", ObjectPoolsTest);
+}
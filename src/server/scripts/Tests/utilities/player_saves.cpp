@@ -0,0 +1,159 @@
+#include "TestCase.h"
+#include "TestPlayer.h"
+#include "PlayerSaveState.h"
+#include "SpellAuras.h"
+#include "Monitor.h"
+#include "Log.h"
+
+// "utilities player saves"
+// Checks that the snapshots kept by the differential character saves only compare equal when every saved
+// value is the same, saves a player several times checking which rows are written and which are skipped,
+// then reports the rows written and skipped by the saves since startup
+class PlayerSavesTest : public TestCase
+{
+public:
+    static uint32 const SPELL_POWER_WORD_FORTITUDE_RNK_1 = 1243;
+
+    void TestCharacterColumns()
+    {
+        PlayerSavedCharacterColumns saved;
+        saved.name = "Test";
+        saved.exploredZones = "1 2 3 ";
+        saved.honorPoints = 100;
+
+        PlayerSavedCharacterColumns columns = saved;
+        TEST_ASSERT(columns == saved);
+
+        columns.honorPoints++;
+        TEST_ASSERT(columns != saved);
+        columns = saved;
+        columns.exploredZones += "4 ";
+        TEST_ASSERT(columns != saved);
+        columns = saved;
+        columns.xpBlocked = 1;
+        TEST_ASSERT(columns != saved);
+        columns = saved;
+        columns.name = "Tset";
+        TEST_ASSERT(columns != saved);
+    }
+
+    void TestAuras()
+    {
+        PlayerSavedAura saved;
+        saved.amount[1] = 50;
+        saved.duration = 10000;
+        saved.critChance = 5.0f;
+
+        PlayerSavedAura aura = saved;
+        TEST_ASSERT(aura == saved);
+
+        aura.duration -= 1000;
+        TEST_ASSERT(aura != saved);
+        aura = saved;
+        aura.baseAmount[2] = 1;
+        TEST_ASSERT(aura != saved);
+        // written values are compared, not float values
+        aura = saved;
+        saved.critChance = 0.0f;
+        aura.critChance = -0.0f;
+        TEST_ASSERT(aura != saved);
+
+        PlayerSaveState state;
+        state.valid = true;
+        state.auras[PlayerSaveState::AuraKey(1, 1459, 0x7)] = saved;
+        state.auras[PlayerSaveState::AuraKey(1, 1459, 0x1)] = saved;
+        TEST_ASSERT(state.auras.size() == 2);
+        state.Invalidate();
+        TEST_ASSERT(!state.valid);
+        TEST_ASSERT(state.auras.empty());
+    }
+
+    // TestPlayer does not save, use the Player saves, differential whatever the config. The character is not in the database, every row written is deleted afterwards
+    PlayerSaveStats Save(TestPlayer* player)
+    {
+        return player->SaveToDBForTest(true);
+    }
+
+    void TestSaves()
+    {
+        TestPlayer* player = SpawnRandomPlayer(CLASS_PRIEST);
+        player->RemoveAllAuras();
+        Aura* aura = player->AddAura(SPELL_POWER_WORD_FORTITUDE_RNK_1, player);
+        TEST_ASSERT(aura != nullptr);
+        // no duration, the aura row stays the same between the saves
+        aura->SetMaxDuration(-1);
+        aura->SetDuration(-1);
+
+        // first save of the session: every row is written
+        PlayerSaveStats save = Save(player);
+        TEST_ASSERT(save.saves == 1);
+        TEST_ASSERT(save.fullSaves == 1);
+        TEST_ASSERT(save.partialCharacterRows == 0);
+        TEST_ASSERT(player->GetSaveState().valid);
+        TEST_ASSERT(player->GetSaveState().auras.size() == 1);
+        uint64 const firstRows = save.rowsWritten;
+
+        // nothing changed: only the characters row is updated, without its rarely changing columns. The aura and bg data rows are skipped
+        save = Save(player);
+        TEST_ASSERT(save.fullSaves == 0);
+        TEST_ASSERT(save.partialCharacterRows == 1);
+        ASSERT_INFO("%u rows written, " UI64FMTD " by the first save", uint32(save.rowsWritten), firstRows);
+        TEST_ASSERT(save.rowsWritten == 1);
+        TEST_ASSERT(save.rowsSkipped >= 2);
+
+        // the aura is gone: its row is deleted
+        player->RemoveAurasDueToSpell(SPELL_POWER_WORD_FORTITUDE_RNK_1);
+        save = Save(player);
+        TEST_ASSERT(save.fullSaves == 0);
+        TEST_ASSERT(save.partialCharacterRows == 1);
+        TEST_ASSERT(save.rowsWritten == 2);
+        TEST_ASSERT(player->GetSaveState().auras.empty());
+
+        // a rarely changing column changed: the full characters row is updated
+        player->SetHonorPoints(player->GetHonorPoints() + 1);
+        save = Save(player);
+        TEST_ASSERT(save.fullSaves == 0);
+        TEST_ASSERT(save.partialCharacterRows == 0);
+        TEST_ASSERT(save.rowsWritten == 1);
+
+        // a save transaction failed: the next save writes every row again
+        player->SetSaveFailed(true);
+        save = Save(player);
+        TEST_ASSERT(save.fullSaves == 1);
+        TEST_ASSERT(save.partialCharacterRows == 0);
+        TEST_ASSERT(!player->IsSaveFailed());
+        TEST_ASSERT(player->GetSaveState().valid);
+
+        Player::DeleteFromDB(player->GetGUID(), player->GetSession()->GetAccountId(), false, true);
+    }
+
+    void Test() override
+    {
+        TestCharacterColumns();
+        TestAuras();
+        TestSaves();
+
+        PlayerSaveStats stats;
+        PlayerSaveStats save;
+        save.saves = 1;
+        save.rowsWritten = 3;
+        save.rowsSkipped = 40;
+        save.partialCharacterRows = 1;
+        stats.Add(save);
+        stats.Add(save);
+        TEST_ASSERT(stats.saves == 2);
+        TEST_ASSERT(stats.fullSaves == 0);
+        TEST_ASSERT(stats.rowsWritten == 6);
+        TEST_ASSERT(stats.rowsSkipped == 80);
+        TEST_ASSERT(stats.partialCharacterRows == 2);
+
+        PlayerSaveStats const total = sMonitor->GetPlayerSaveStats();
+        TC_LOG_INFO("test.unit_test", "Player saves: " UI64FMTD " saves (" UI64FMTD " full), " UI64FMTD " rows written, " UI64FMTD " skipped, " UI64FMTD " partial characters rows",
+            total.saves, total.fullSaves, total.rowsWritten, total.rowsSkipped, total.partialCharacterRows);
+    }
+};
+
+void AddSC_test_player_saves()
+{
+    RegisterTestCase("utilities player saves", PlayerSavesTest);
+}
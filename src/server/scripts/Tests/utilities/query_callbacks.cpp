@@ -0,0 +1,184 @@
+#include "TestCase.h"
+#include "DatabaseEnv.h"
+#include "QueryCallback.h"
+#include "QueryCallbackProcessor.h"
+#include "QueryCompletion.h"
+#include "Containers.h"
+#include "Log.h"
+#include <chrono>
+#include <thread>
+
+// "utilities query callbacks"
+// Completes query results by hand in random order and checks that every callback is invoked once, through
+// the completion queue and through polling, then benchmarks the updates of processors with many pending queries
+class QueryCallbacksTest : public TestCase
+{
+public:
+    static uint32 const QUERIES = 10000;
+    static uint32 const UPDATES = 100;
+    static uint32 const TEST_STATEMENT = 0;
+
+    struct PendingQuery
+    {
+        PreparedQueryResultPromise promise;
+        std::shared_ptr<QueryCompletion> completion;
+
+        void Complete()
+        {
+            promise.set_value(PreparedQueryResult(nullptr));
+            if (completion)
+                completion->Complete();
+        }
+    };
+
+    // Adds QUERIES callbacks to processor, each one increments its counter
+    static void AddQueries(QueryCallbackProcessor& processor, std::vector<PendingQuery>& queries, std::vector<uint32>& invoked, bool signaled)
+    {
+        queries.resize(QUERIES);
+        invoked.assign(QUERIES, 0);
+        for (uint32 i = 0; i < QUERIES; i++)
+        {
+            if (signaled)
+                queries[i].completion = std::make_shared<QueryCompletion>("test", TEST_STATEMENT);
+            processor.AddQuery(QueryCallback(queries[i].promise.get_future(), queries[i].completion).WithPreparedCallback([&invoked, i](PreparedQueryResult)
+            {
+                invoked[i]++;
+            }));
+        }
+    }
+
+    void TestInvokedOnce(bool signaled)
+    {
+        QueryCallbackProcessor processor;
+        std::vector<PendingQuery> queries;
+        std::vector<uint32> invoked;
+        AddQueries(processor, queries, invoked, signaled);
+
+        processor.ProcessReadyQueries();
+        for (uint32 i = 0; i < QUERIES; i++)
+            TEST_ASSERT(invoked[i] == 0);
+
+        // every other query completes first
+        std::vector<uint32> order;
+        for (uint32 i = 0; i < QUERIES; i += 2)
+            order.push_back(i);
+        Trinity::Containers::RandomShuffle(order);
+        for (uint32 i : order)
+            queries[i].Complete();
+
+        processor.ProcessReadyQueries();
+        for (uint32 i = 0; i < QUERIES; i++)
+        {
+            ASSERT_INFO("Query %u invoked %u times (signaled: %u)", i, invoked[i], uint32(signaled));
+            TEST_ASSERT(invoked[i] == (i % 2 ? 0 : 1));
+        }
+
+        for (uint32 i = 1; i < QUERIES; i += 2)
+            queries[i].Complete();
+        processor.ProcessReadyQueries();
+        processor.ProcessReadyQueries();
+        for (uint32 i = 0; i < QUERIES; i++)
+        {
+            ASSERT_INFO("Query %u invoked %u times (signaled: %u)", i, invoked[i], uint32(signaled));
+            TEST_ASSERT(invoked[i] == 1);
+        }
+    }
+
+    void TestChaining()
+    {
+        QueryCallbackProcessor processor;
+        PendingQuery first, signaledNext, polledNext;
+        first.completion = std::make_shared<QueryCompletion>("test", TEST_STATEMENT);
+        signaledNext.completion = std::make_shared<QueryCompletion>("test", TEST_STATEMENT);
+
+        uint32 steps = 0;
+        processor.AddQuery(QueryCallback(first.promise.get_future(), first.completion)
+            .WithChainingPreparedCallback([&](QueryCallback& callback, PreparedQueryResult)
+            {
+                steps++;
+                callback.SetNextQuery(QueryCallback(signaledNext.promise.get_future(), signaledNext.completion));
+            })
+            .WithChainingPreparedCallback([&](QueryCallback& callback, PreparedQueryResult)
+            {
+                steps++;
+                // chained to a query without completion, polled from now on
+                callback.SetNextQuery(QueryCallback(polledNext.promise.get_future()));
+            })
+            .WithPreparedCallback([&](PreparedQueryResult)
+            {
+                steps++;
+            }));
+
+        first.Complete();
+        processor.ProcessReadyQueries();
+        TEST_ASSERT(steps == 1);
+        processor.ProcessReadyQueries();
+        TEST_ASSERT(steps == 1);
+
+        signaledNext.Complete();
+        processor.ProcessReadyQueries();
+        TEST_ASSERT(steps == 2);
+
+        polledNext.Complete();
+        processor.ProcessReadyQueries();
+        TEST_ASSERT(steps == 3);
+        processor.ProcessReadyQueries();
+        TEST_ASSERT(steps == 3);
+    }
+
+    uint64 MeasurePendingUpdates(bool signaled)
+    {
+        QueryCallbackProcessor processor;
+        std::vector<PendingQuery> queries;
+        std::vector<uint32> invoked;
+        AddQueries(processor, queries, invoked, signaled);
+
+        uint64 const time = Measure([&]()
+        {
+            for (uint32 i = 0; i < UPDATES; i++)
+                processor.ProcessReadyQueries();
+        });
+
+        // callbacks reference invoked, run them before leaving
+        for (PendingQuery& query : queries)
+            query.Complete();
+        processor.ProcessReadyQueries();
+        return time;
+    }
+
+    void Test() override
+    {
+        TestInvokedOnce(true);
+        TestInvokedOnce(false);
+        TestChaining();
+
+        QueryLatencyStatsMap const stats = QueryCallbackProcessor::GetLatencyStats();
+        auto itr = stats.find(std::make_pair(std::string("test"), TEST_STATEMENT));
+        TEST_ASSERT(itr != stats.end());
+        TEST_ASSERT(itr->second.count >= QUERIES + 2);
+
+        uint64 const polledTime = MeasurePendingUpdates(false);
+        uint64 const signaledTime = MeasurePendingUpdates(true);
+        TC_LOG_INFO("test.unit_test", "Query callbacks benchmark: %u updates with %u pending queries, polled %u us, signaled %u us",
+            UPDATES, QUERIES, uint32(polledTime), uint32(signaledTime));
+
+        // Real round trip, the callback only runs from the completion queue
+        QueryCallbackProcessor processor;
+        bool done = false;
+        processor.AddQuery(CharacterDatabase.AsyncQuery("SELECT 1").WithCallback([&done](QueryResult result)
+        {
+            done = result != nullptr;
+        }));
+        for (uint32 i = 0; i < 500 && !done; i++)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            processor.ProcessReadyQueries();
+        }
+        TEST_ASSERT(done);
+    }
+};
+
+void AddSC_test_query_callbacks()
+{
+    RegisterTestCase("utilities query callbacks", QueryCallbacksTest);
+}
@@ -0,0 +1,168 @@
+#include "TestCase.h"
+#include "DatabaseEnv.h"
+#include "Log.h"
+
+// "utilities query result"
+// Loads world tables with the statements of their loaders, into results with the previous row layout (a copy of
+// the row buffer per row) and with the arena. Checks both read the same values as the ad hoc query and benchmarks them.
+// Then loads the biggest world tables as ad hoc queries, with a copy of every value (the previous layout) and with the
+// fields pointing into the MySQL rows, checks both read the same values and benchmarks them.
+class QueryResultTest : public TestCase
+{
+public:
+    struct TableLoad
+    {
+        char const* name;
+        char const* sql;                            // same query as the statement, run ad hoc
+        WorldDatabaseStatements statement;
+        uint64(*read)(Field* fields);               // read a row as the loader does, return a checksum of the integers and strings
+    };
+
+    struct AdHocTableLoad
+    {
+        char const* name;
+        char const* sql;
+        uint64(*read)(Field* fields);
+    };
+
+    static uint64 ReadString(Field const& field)
+    {
+        uint64 checksum = 0;
+        for (char const* c = field.GetCString(); c && *c; ++c)
+            checksum = checksum * 31 + uint8(*c);
+        return checksum + field.GetString().size();
+    }
+
+    static uint64 ReadCreatureText(Field* fields)
+    {
+        float const probability = fields[6].GetFloat();
+        return fields[0].GetUInt32() + fields[1].GetUInt8() + fields[2].GetUInt8() + ReadString(fields[3]) + fields[4].GetUInt8() + fields[5].GetUInt8()
+            + fields[7].GetUInt32() + fields[8].GetUInt32() + fields[9].GetUInt32() + fields[10].GetUInt32() + fields[11].GetUInt8() + (probability != probability);
+    }
+
+    static uint64 ReadWaypoint(Field* fields)
+    {
+        float const position = fields[2].GetFloat() + fields[3].GetFloat() + fields[4].GetFloat();
+        return fields[0].GetUInt32() + fields[1].GetUInt32() + (position != position);
+    }
+
+    static uint64 ReadCreature(Field* fields)
+    {
+        float const position = fields[3].GetFloat() + fields[4].GetFloat() + fields[5].GetFloat() + fields[6].GetFloat();
+        return fields[0].GetUInt32() + fields[1].GetUInt32() + fields[2].GetUInt16() + fields[7].GetUInt32() + ReadString(fields[8]) + (position != position);
+    }
+
+    static uint64 ReadGameObject(Field* fields)
+    {
+        float position = 0.0f;
+        for (uint32 i = 3; i < 11; i++)
+            position += fields[i].GetFloat();
+        return fields[0].GetUInt32() + fields[1].GetUInt32() + fields[2].GetUInt16() + ReadString(fields[11]) + (position != position);
+    }
+
+    static uint64 ReadLoot(Field* fields)
+    {
+        float const chance = fields[3].GetFloat();
+        return fields[0].GetUInt32() + fields[1].GetUInt32() + fields[2].GetUInt32() + fields[4].GetBool() + fields[5].GetUInt16()
+            + fields[6].GetUInt8() + fields[7].GetUInt8() + fields[8].GetUInt8() + (chance != chance);
+    }
+
+    template<class Result, class Table>
+    static uint64 ReadAll(Result const& result, Table const& table, uint64& rows)
+    {
+        uint64 checksum = 0;
+        rows = 0;
+        if (!result)
+            return checksum;
+
+        do
+        {
+            checksum += table.read(result->Fetch());
+            rows++;
+        } while (result->NextRow());
+        return checksum;
+    }
+
+    static uint64 LoadPrepared(TableLoad const& table, bool arena, uint64& rows, uint64& checksum)
+    {
+        PreparedResultSet::SetArenaEnabled(arena);
+        uint64 const time = Measure([&]()
+        {
+            checksum = ReadAll(WorldDatabase.Query(WorldDatabase.GetPreparedStatement(table.statement)), table, rows);
+        });
+        PreparedResultSet::SetArenaEnabled(true);
+        return time;
+    }
+
+    static uint64 LoadAdHoc(AdHocTableLoad const& table, bool copies, uint64& rows, uint64& checksum)
+    {
+        ResultSet::SetValueCopiesEnabled(copies);
+        uint64 const time = Measure([&]()
+        {
+            checksum = ReadAll(WorldDatabase.Query(table.sql), table, rows);
+        });
+        ResultSet::SetValueCopiesEnabled(false);
+        return time;
+    }
+
+    void TestAdHoc()
+    {
+        AdHocTableLoad const tables[] =
+        {
+            { "creature", "SELECT guid, id, map, position_x, position_y, position_z, orientation, spawntimesecs, ScriptName FROM creature", &ReadCreature },
+            { "gameobject", "SELECT guid, id, map, position_x, position_y, position_z, orientation, rotation0, rotation1, rotation2, rotation3, ScriptName FROM gameobject", &ReadGameObject },
+            { "creature_loot_template", "SELECT Entry, Item, Reference, Chance, QuestRequired, LootMode, GroupId, MinCount, MaxCount FROM creature_loot_template", &ReadLoot },
+        };
+
+        for (AdHocTableLoad const& table : tables)
+        {
+            uint64 copiesRows = 0, copiesChecksum = 0;
+            uint64 const copiesTime = LoadAdHoc(table, true, copiesRows, copiesChecksum);
+
+            uint64 rowRows = 0, rowChecksum = 0;
+            uint64 const rowTime = LoadAdHoc(table, false, rowRows, rowChecksum);
+
+            ASSERT_INFO("Table %s: %u rows with value copies, %u rows pointing into the MySQL rows", table.name, uint32(copiesRows), uint32(rowRows));
+            TEST_ASSERT(copiesRows == rowRows);
+            ASSERT_INFO("Table %s: values differ between value copies and MySQL rows", table.name);
+            TEST_ASSERT(copiesChecksum == rowChecksum);
+
+            TC_LOG_INFO("test.unit_test", "Query result benchmark: %s (ad hoc), %u rows, value copies " UI64FMTD " us, MySQL rows " UI64FMTD " us", table.name, uint32(rowRows), copiesTime, rowTime);
+        }
+    }
+
+    void Test() override
+    {
+        TestAdHoc();
+
+        TableLoad const tables[] =
+        {
+            { "creature_text", "SELECT CreatureID, groupid, id, text, type, language, probability, emote, duration, sound, BroadcastTextID, TextRange FROM creature_text", WORLD_SEL_CREATURE_TEXT, &ReadCreatureText },
+            { "waypoints", "SELECT entry, pointid, position_x, position_y, position_z FROM waypoints ORDER BY entry, pointid", WORLD_SEL_SMARTAI_WP, &ReadWaypoint },
+        };
+
+        for (TableLoad const& table : tables)
+        {
+            uint64 adHocRows = 0;
+            uint64 const adHocChecksum = ReadAll(WorldDatabase.Query(table.sql), table, adHocRows);
+
+            uint64 rowLayoutRows = 0, rowLayoutChecksum = 0;
+            uint64 const rowLayoutTime = LoadPrepared(table, false, rowLayoutRows, rowLayoutChecksum);
+
+            uint64 arenaRows = 0, arenaChecksum = 0;
+            uint64 const arenaTime = LoadPrepared(table, true, arenaRows, arenaChecksum);
+
+            ASSERT_INFO("Table %s: %u ad hoc rows, %u rows with the row layout, %u rows with the arena", table.name, uint32(adHocRows), uint32(rowLayoutRows), uint32(arenaRows));
+            TEST_ASSERT(adHocRows == rowLayoutRows && adHocRows == arenaRows);
+            ASSERT_INFO("Table %s: values differ between ad hoc and prepared results", table.name);
+            TEST_ASSERT(adHocChecksum == rowLayoutChecksum && adHocChecksum == arenaChecksum);
+
+            TC_LOG_INFO("test.unit_test", "Query result benchmark: %s, %u rows, row layout " UI64FMTD " us, arena " UI64FMTD " us", table.name, uint32(arenaRows), rowLayoutTime, arenaTime);
+        }
+    }
+};
+
+void AddSC_test_query_result()
+{
+    RegisterTestCase("utilities query result", QueryResultTest);
+}
@@ -0,0 +1,75 @@
+#include "TestCase.h"
+#include "SpellMgr.h"
+#include "SpellInfo.h"
+#include "ObjectMgr.h"
+#include "Log.h"
+
+// "utilities spell info store"
+// Checks that the SpellInfo loaded at startup are stored contiguously by id with their hot fields at the
+// front, then benchmarks the checks done on every cast on random spells
+class SpellInfoStoreTest : public TestCase
+{
+public:
+    static uint32 const CACHE_LINE = 64;
+    static uint32 const CHECKS = 1000000;
+
+    static uint32 OffsetOf(SpellInfo const* spellInfo, void const* field)
+    {
+        return uint32(reinterpret_cast<char const*>(field) - reinterpret_cast<char const*>(spellInfo));
+    }
+
+    void Test() override
+    {
+        SpellEntryStore& spellStore = sObjectMgr->GetSpellStore();
+        std::vector<SpellInfo const*> spells;
+        SpellInfo const* previous = nullptr;
+        for (auto const& itr : spellStore)
+        {
+            SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(itr.first);
+            TEST_ASSERT(spellInfo != nullptr);
+            TEST_ASSERT(spellInfo->Id == itr.first);
+            // names are not copied
+            TEST_ASSERT(spellInfo->SpellName == itr.second->SpellName);
+            TEST_ASSERT(spellInfo->Rank == itr.second->Rank);
+            TEST_ASSERT(reinterpret_cast<uintptr_t>(spellInfo) % CACHE_LINE == 0);
+            if (previous)
+            {
+                ASSERT_INFO("Spell %u is not stored right after spell %u", spellInfo->Id, previous->Id);
+                TEST_ASSERT(spellInfo == previous + 1);
+            }
+            previous = spellInfo;
+            spells.push_back(spellInfo);
+        }
+        TEST_ASSERT(!spells.empty());
+
+        // fields read by most casts fit in the first cache lines
+        SpellInfo const* spellInfo = spells.front();
+        uint32 const hotEnd = OffsetOf(spellInfo, &spellInfo->Effects[0]);
+        TEST_ASSERT(OffsetOf(spellInfo, &spellInfo->AttributesCu) < CACHE_LINE);
+        TEST_ASSERT(OffsetOf(spellInfo, &spellInfo->ProcFlags) < CACHE_LINE);
+        TEST_ASSERT(OffsetOf(spellInfo, &spellInfo->RangeEntry) < 2 * CACHE_LINE);
+        TEST_ASSERT(hotEnd <= 4 * CACHE_LINE);
+        TEST_ASSERT(OffsetOf(spellInfo, &spellInfo->SpellIconID) > OffsetOf(spellInfo, &spellInfo->Effects[MAX_SPELL_EFFECTS - 1]));
+
+        std::vector<SpellInfo const*> randomSpells(CHECKS);
+        for (SpellInfo const*& randomSpell : randomSpells)
+            randomSpell = spells[urand(0, spells.size() - 1)];
+
+        uint32 passing = 0;
+        uint64 const checksTime = Measure([&]()
+        {
+            for (SpellInfo const* randomSpell : randomSpells)
+                if (!randomSpell->HasAttribute(SPELL_ATTR0_PASSIVE) && randomSpell->IsPositive() && randomSpell->GetMaxRange() > 0.0f
+                    && !randomSpell->HasAttribute(SPELL_ATTR0_CU_NEGATIVE) && randomSpell->CalcCastTime() < 10 * IN_MILLISECONDS)
+                    passing++;
+        });
+
+        TC_LOG_INFO("test.unit_test", "SpellInfo store: %u spells of %u bytes, hot fields in %u bytes, %u checks in %u us (%u passing)",
+            uint32(spells.size()), uint32(sizeof(SpellInfo)), hotEnd, CHECKS, uint32(checksTime), passing);
+    }
+};
+
+void AddSC_test_spell_info_store()
+{
+    RegisterTestCase("utilities spell info store", SpellInfoStoreTest);
+}
@@ -0,0 +1,85 @@
+#include "TestCase.h"
+#include "BigNumber.h"
+#include "SRP6.h"
+#include "Log.h"
+
+// "utilities srp6"
+// Compares the fixed width SRP6 kernels with the BigNumber computations authserver used to do, then benchmarks both
+class SRP6Test : public TestCase
+{
+public:
+    static uint32 const CHECKS = 500;
+    static uint32 const LOGONS = 2000;
+
+    static SRP6::Number ToNumber(BigNumber& bn)
+    {
+        return SRP6::ToNumber(bn.AsByteArray(SRP6::NUMBER_BYTES).get(), SRP6::NUMBER_BYTES);
+    }
+
+    void Test() override
+    {
+        SRP6 const& srp = SRP6::Instance();
+        BigNumber N, g;
+        N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
+        g.SetDword(SRP6::GetG());
+        TEST_ASSERT(ToNumber(N) == srp.GetN());
+
+        for (uint32 i = 0; i < CHECKS; i++)
+        {
+            BigNumber x, b, u, A;
+            x.SetRand(SRP6::DIGEST_BYTES * 8);
+            b.SetRand(SRP6::EPHEMERAL_BYTES * 8);
+            u.SetRand(SRP6::DIGEST_BYTES * 8);
+            A.SetRand(SRP6::NUMBER_BYTES * 8);
+
+            BigNumber v = g.ModExp(x, N);
+            TEST_ASSERT(srp.ComputeVerifier(ToNumber(x)) == ToNumber(v));
+
+            BigNumber B = ((v * 3) + g.ModExp(b, N)) % N;
+            TEST_ASSERT(srp.ComputeServerEphemeral(ToNumber(v), ToNumber(b)) == ToNumber(B));
+
+            BigNumber S = (A * (v.ModExp(u, N))).ModExp(b, N);
+            SRP6::Number fastS;
+            TEST_ASSERT(srp.ComputeSessionSecret(ToNumber(A), ToNumber(v), ToNumber(u), ToNumber(b), fastS));
+            TEST_ASSERT(fastS == ToNumber(S));
+        }
+
+        // SRP safeguard
+        SRP6::Number S;
+        TEST_ASSERT(!srp.ComputeSessionSecret(srp.GetN(), srp.GetN(), srp.GetN(), srp.GetN(), S));
+
+        // server side of a logon: B then S
+        BigNumber x, b, u, A;
+        x.SetRand(SRP6::DIGEST_BYTES * 8);
+        b.SetRand(SRP6::EPHEMERAL_BYTES * 8);
+        u.SetRand(SRP6::DIGEST_BYTES * 8);
+        A.SetRand(SRP6::NUMBER_BYTES * 8);
+        BigNumber v = g.ModExp(x, N);
+
+        uint64 bigNumberTime = Measure([&]()
+        {
+            for (uint32 i = 0; i < LOGONS; i++)
+            {
+                BigNumber B = ((v * 3) + g.ModExp(b, N)) % N;
+                BigNumber S = (A * (v.ModExp(u, N))).ModExp(b, N);
+            }
+        });
+
+        SRP6::Number const fastV = ToNumber(v), fastB = ToNumber(b), fastU = ToNumber(u), fastA = ToNumber(A);
+        uint64 fastTime = Measure([&]()
+        {
+            for (uint32 i = 0; i < LOGONS; i++)
+            {
+                srp.ComputeServerEphemeral(fastV, fastB);
+                srp.ComputeSessionSecret(fastA, fastV, fastU, fastB, S);
+            }
+        });
+
+        TC_LOG_INFO("test.unit_test", "SRP6 benchmark: %u logons, BigNumber %u us, fixed width %u us", LOGONS, uint32(bigNumberTime), uint32(fastTime));
+    }
+};
+
+void AddSC_test_srp6()
+{
+    RegisterTestCase("utilities srp6", SRP6Test);
+}
@@ -0,0 +1,171 @@
+#include "TestCase.h"
+#include "TimingWheel.h"
+#include "EventMap.h"
+#include "Random.h"
+#include "Log.h"
+#include <functional>
+#include <map>
+#include <set>
+
+// "utilities timingwheel order"
+// Compares the expiration order of the wheel with a multimap keyed by time, with cancels and reschedules
+class TimingWheelOrderTest : public TestCase
+{
+public:
+    void Test() override
+    {
+        typedef std::multimap<uint64, uint32> Reference;
+        Reference reference;
+        TimingWheel<uint32> wheel;
+        std::vector<TimingWheel<uint32>::Handle> handles;
+
+        uint32 const COUNT = 20000;
+        uint64 now = 0;
+        for (uint32 i = 0; i < COUNT; i++)
+        {
+            // spread over every level and the overflow list
+            uint64 delay = urand(0, 3) == 0 ? urand(0, 100) : (uint64(urand(0, 1 << 24)) << urand(0, 6));
+            handles.push_back(wheel.Schedule(now + delay, i));
+            reference.insert({ now + delay, i });
+        }
+        TEST_ASSERT(wheel.Size() == COUNT);
+
+        // cancel and reschedule some values, a rescheduled value goes after the others of the same time
+        for (uint32 i = 0; i < COUNT; i += 7)
+        {
+            Reference::iterator itr = std::find_if(reference.begin(), reference.end(), [i](Reference::value_type const& pair) { return pair.second == i; });
+            reference.erase(itr);
+            if (i % 2)
+                wheel.Cancel(handles[i]);
+            else
+            {
+                uint64 time = urand(0, 1 << 20);
+                wheel.Reschedule(handles[i], time);
+                reference.insert({ time, i });
+            }
+        }
+        TEST_ASSERT(wheel.Size() == reference.size());
+
+        while (!reference.empty())
+        {
+            now += urand(1, 1 << 16);
+            wheel.Advance(now);
+            while (!reference.empty() && reference.begin()->first <= now)
+            {
+                TEST_ASSERT(wheel.HasDue());
+                TEST_ASSERT(wheel.GetScheduledTime(wheel.FrontDue()) == reference.begin()->first);
+                TEST_ASSERT(wheel.PopDue() == reference.begin()->second);
+                reference.erase(reference.begin());
+            }
+            TEST_ASSERT(!wheel.HasDue());
+        }
+        TEST_ASSERT(wheel.Empty());
+
+        // EventMap can only delay all events by its elapsed time, and keeps their order
+        EventMap events;
+        events.ScheduleEvent(1, 100);
+        events.ScheduleEvent(2, 200);
+        events.Update(50);
+        events.DelayEvents(100);
+        TEST_ASSERT(events.GetTimeUntilEvent(1) == 100);
+        events.ScheduleEvent(3, 100);
+        events.Update(150);
+        TEST_ASSERT(events.ExecuteEvent() == 1);
+        TEST_ASSERT(events.ExecuteEvent() == 3);
+        TEST_ASSERT(events.ExecuteEvent() == 0);
+        events.Update(100);
+        TEST_ASSERT(events.ExecuteEvent() == 2);
+        TEST_ASSERT(events.Empty());
+
+        // a delayed event keeps its place among the events due at the same time
+        events.ScheduleEvent(4, 100, 1);
+        events.ScheduleEvent(5, 150);
+        events.DelayEvents(50, 1);
+        events.Update(150);
+        TEST_ASSERT(events.ExecuteEvent() == 4);
+        TEST_ASSERT(events.ExecuteEvent() == 5);
+        TEST_ASSERT(events.Empty());
+
+        // values due at the same tick are ordered by Order, then by scheduling order
+        TimingWheel<uint32, std::greater<uint32>> ordered;
+        ordered.Schedule(100, 1);
+        ordered.Schedule(100, 3);
+        ordered.Schedule(50, 0);
+        ordered.Schedule(100, 2);
+        ordered.Schedule(100, 3);
+        ordered.Advance(100);
+        uint32 const expected[] = { 0, 3, 3, 2, 1 };
+        for (uint32 value : expected)
+        {
+            TEST_ASSERT(ordered.HasDue());
+            TEST_ASSERT(ordered.PopDue() == value);
+        }
+        TEST_ASSERT(ordered.Empty());
+    }
+};
+
+// "utilities timingwheel benchmark"
+// Times scheduling, cancelling and expiring with the wheel and with the std::multimap the event containers used before
+class TimingWheelBenchmarkTest : public TestCase
+{
+public:
+    static uint32 const COUNT = 200000;
+    static uint32 const TICKS = 60000;
+
+    void Test() override
+    {
+        std::vector<uint32> delays(COUNT);
+        for (uint32 i = 0; i < COUNT; i++)
+            delays[i] = urand(0, TICKS);
+
+        uint64 mapExpired = 0;
+        uint64 mapTime = Measure([&]()
+        {
+            std::multimap<uint64, uint32> container;
+            std::vector<std::multimap<uint64, uint32>::iterator> itrs;
+            itrs.reserve(COUNT);
+            for (uint32 i = 0; i < COUNT; i++)
+                itrs.push_back(container.insert({ delays[i], i }));
+            for (uint32 i = 0; i < COUNT; i += 4)
+                container.erase(itrs[i]);
+            for (uint64 now = 0; now <= TICKS; now++)
+                while (!container.empty() && container.begin()->first <= now)
+                {
+                    container.erase(container.begin());
+                    ++mapExpired;
+                }
+        });
+
+        uint64 wheelExpired = 0;
+        uint64 wheelTime = Measure([&]()
+        {
+            TimingWheel<uint32> container;
+            std::vector<TimingWheel<uint32>::Handle> handles;
+            handles.reserve(COUNT);
+            for (uint32 i = 0; i < COUNT; i++)
+                handles.push_back(container.Schedule(delays[i], i));
+            for (uint32 i = 0; i < COUNT; i += 4)
+                container.Cancel(handles[i]);
+            for (uint64 now = 0; now <= TICKS; now++)
+            {
+                container.Advance(now);
+                while (container.HasDue())
+                {
+                    container.PopDue();
+                    ++wheelExpired;
+                }
+            }
+        });
+
+        TC_LOG_INFO("test.unit_test", "TimingWheel benchmark: %u timers over %u ticks, std::multimap %u us, TimingWheel %u us",
+            COUNT, TICKS, uint32(mapTime), uint32(wheelTime));
+
+        TEST_ASSERT(mapExpired == wheelExpired);
+    }
+};
+
+void AddSC_test_timing_wheel()
+{
+    RegisterTestCase("utilities timingwheel order", TimingWheelOrderTest);
+    RegisterTestCase("utilities timingwheel benchmark", TimingWheelBenchmarkTest);
+}
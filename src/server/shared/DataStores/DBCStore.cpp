@@ -17,6 +17,7 @@
 
 #include "DBCStore.h"
 #include "DBCDatabaseLoader.h"
+#include "DBCFileLoader.h"
 
 DBCStorageBase::DBCStorageBase(char const* fmt) : _fieldCount(0), _fileFormat(fmt), _dataTable(nullptr), _indexTableSize(0)
 {
@@ -33,20 +34,23 @@ bool DBCStorageBase::Load(char const* path, char**& indexTable)
 {
     indexTable = nullptr;
 
-    DBCFileLoader dbc;
+    std::unique_ptr<DBCFileLoader> dbc = Trinity::make_unique<DBCFileLoader>();
     // Check if load was sucessful, only then continue
-    if (!dbc.Load(path, _fileFormat))
+    if (!dbc->Load(path, _fileFormat))
         return false;
 
-    _fieldCount = dbc.GetCols();
+    _fieldCount = dbc->GetCols();
 
     // load raw non-string data
-    _dataTable = dbc.AutoProduceData(_fileFormat, _indexTableSize, indexTable);
+    _dataTable = dbc->AutoProduceData(_fileFormat, _indexTableSize, indexTable);
 
     // load strings from dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
+    if (char* stringBlock = dbc->AutoProduceStrings(_fileFormat, _dataTable))
         _stringPool.push_back(stringBlock);
 
+    if (dbc->IsMapped())
+        _mappedFiles.push_back(std::move(dbc));
+
     // error in dbc file at loading if NULL
     return indexTable != nullptr;
 }
@@ -57,15 +61,18 @@ bool DBCStorageBase::LoadStringsFrom(char const* path, char** indexTable)
     if (!indexTable)
         return false;
 
-    DBCFileLoader dbc;
+    std::unique_ptr<DBCFileLoader> dbc = Trinity::make_unique<DBCFileLoader>();
     // Check if load was successful, only then continue
-    if (!dbc.Load(path, _fileFormat))
+    if (!dbc->Load(path, _fileFormat))
         return false;
 
     // load strings from another locale dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
+    if (char* stringBlock = dbc->AutoProduceStrings(_fileFormat, _dataTable))
         _stringPool.push_back(stringBlock);
 
+    if (dbc->IsMapped() && strchr(_fileFormat, FT_STRING))
+        _mappedFiles.push_back(std::move(dbc));
+
     return true;
 }
 
@@ -4,8 +4,11 @@
 #include "Common.h"
 #include "DBCStorageIterator.h"
 #include "Errors.h"
+#include <memory>
 #include <vector>
 
+class DBCFileLoader;
+
 /// Interface class for common access
 class TC_SHARED_API DBCStorageBase
 {
@@ -29,6 +32,7 @@ protected:
     char const* _fileFormat;
     char* _dataTable;
     std::vector<char*> _stringPool;
+    std::vector<std::unique_ptr<DBCFileLoader>> _mappedFiles;   // mapped files records or strings point into
     uint32 _indexTableSize;
 };
 
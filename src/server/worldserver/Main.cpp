@@ -162,7 +162,7 @@ extern int main(int argc, char **argv)
     if (vm.count("help") || vm.count("version"))
         return 0;
     if (vm.count("tests"))
-        sWorld->SetCITesting();
+        sWorld->SetCITesting(vm["tests"].as<std::string>());
 
 #ifdef _WIN32
     /*
@@ -526,7 +526,7 @@ variables_map GetConsoleArguments(int argc, char** argv,  fs::path& configFile,
     all.add_options()
         ("help,h", "print usage message")
         ("version,v", "print version build info")
-        ("tests,t", "run all tests and display results")
+        ("tests,t", value<std::string>()->implicit_value(".*"), "run all tests (or the ones matching <arg> regex) and display results")
         ("config,c", value<fs::path>(&configFile)->default_value(fs::absolute(_TRINITY_CORE_CONFIG)),
             "use <arg> as configuration file");
 #ifdef _WIN32
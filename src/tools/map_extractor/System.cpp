@@ -17,15 +17,22 @@
 */
 
 #include <stdio.h>
+#include <algorithm>
+#include <atomic>
 #include <deque>
 #include <set>
 #include <cstdlib>
 #include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
 
 #include "dbcfile.h"
 #include "Banner.h"
 #include "mpq_libmpq04.h"
 #include "StringFormat.h"
+#include "Timer.h"
+#include "ParallelTasks.h"
 
 #include "adt.h"
 #include "wdt.h"
@@ -74,6 +81,11 @@ float CONF_float_to_int16_limit = 2048.0f;   // Max accuracy = val/65536
 float CONF_flat_height_delta_limit = 0.005f; // If max - min less this value - surface is flat
 float CONF_flat_liquid_delta_limit = 0.001f; // If max - min less this value - liquid surface is flat
 
+// Number of threads converting ADT files, 0 or 1 to convert in the main thread only
+uint32 CONF_threads = std::thread::hardware_concurrency();
+// Convert every ADT again in the main thread after extraction and compare with the written map files
+bool  CONF_verify = false;
+
                                              // List MPQ for extract from
 const char *CONF_mpq_list[] = {
     "common.MPQ",
@@ -109,6 +121,8 @@ void Usage(char* prg)
         "-o set output path (max %d characters)\n"\
         "-e extract only MAP(1)/DBC(2)/Camera(4) - standard: all(7)\n"\
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
+        "--threads [#] number of threads converting map files, all cores by default\n"\
+        "--verify convert map files again in a single thread and compare the output\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"", prg, MAX_PATH_LENGTH - 1, MAX_PATH_LENGTH - 1, prg);
     exit(1);
 }
@@ -122,6 +136,23 @@ void HandleArgs(int argc, char * arg[])
         // e - extract only MAP(1)/DBC(2) - standard both(3)
         // f - use float to int conversion
         // h - limit minimum height
+        // --threads - number of threads converting map files
+        // --verify - compare map files with a single threaded conversion
+        if (strcmp(arg[c], "--threads") == 0)
+        {
+            if (c + 1 < argc)
+                CONF_threads = std::max(0, atoi(arg[++c]));
+            else
+                Usage(arg[0]);
+            continue;
+        }
+
+        if (strcmp(arg[c], "--verify") == 0)
+        {
+            CONF_verify = true;
+            continue;
+        }
+
         if (arg[c][0] != '-')
             Usage(arg[0]);
 
@@ -328,25 +359,26 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-
-uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-
-int16 flight_box_max[3][3];
-int16 flight_box_min[3][3];
-
-bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int /*cell_y*/, int /*cell_x*/, uint32 build)
+// Temporary grid data store, one per converting thread
+thread_local uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+
+thread_local float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint16 uint16_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint8  uint8_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+
+thread_local uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float liquid_height[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+
+thread_local int16 flight_box_max[3][3];
+thread_local int16 flight_box_min[3][3];
+
+// Converts an ADT file to the .map file format into mapData
+bool ConvertADT(std::string const& inputPath, std::string& mapData, uint32 build)
 {
     ADT_file adt;
 
@@ -360,9 +392,14 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
         return false;
     }
 
+    // also reset the grids that are not fully rewritten for every tile, so the
+    // output does not depend on which tile the thread converted before
+    memset(V8, 0, sizeof(V8));
+    memset(V9, 0, sizeof(V9));
     memset(liquid_show, 0, sizeof(liquid_show));
     memset(liquid_flags, 0, sizeof(liquid_flags));
     memset(liquid_entry, 0, sizeof(liquid_entry));
+    memset(liquid_height, 0, sizeof(liquid_height));
 
     // Prepare map header
     map_fileheader map;
@@ -847,12 +884,7 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
 
     // Ok all data prepared - store it
 
-    std::ofstream outFile(outputPath, std::ofstream::out | std::ofstream::binary);
-    if (!outFile)
-    {
-        printf("Can't create the output file '%s'\n", outputPath.c_str());
-        return false;
-    }
+    std::ostringstream outFile(std::ios::out | std::ios::binary);
 
     outFile.write(reinterpret_cast<char const*>(&map), sizeof(map));
     // Store area data
@@ -909,14 +941,51 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
     if (hasHoles)
         outFile.write(reinterpret_cast<char const*>(holes), map.holesSize);
 
+    mapData = outFile.str();
+    return true;
+}
+
+bool ExtractADT(std::string const& inputPath, std::string const& outputPath, uint32 build)
+{
+    std::string mapData;
+    if (!ConvertADT(inputPath, mapData, build))
+        return false;
+
+    std::ofstream outFile(outputPath, std::ofstream::out | std::ofstream::binary);
+    if (!outFile)
+    {
+        printf("Can't create the output file '%s'\n", outputPath.c_str());
+        return false;
+    }
+
+    outFile.write(mapData.data(), mapData.size());
     outFile.close();
     return true;
 }
 
-void ExtractMapsFromMpq(uint32 build)
+// Returns true if the written map file matches a conversion made in the calling thread
+bool VerifyADT(std::string const& inputPath, std::string const& outputPath, uint32 build)
+{
+    std::string mapData;
+    if (!ConvertADT(inputPath, mapData, build))
+        return !boost::filesystem::exists(outputPath);
+
+    std::ifstream inFile(outputPath, std::ifstream::in | std::ifstream::binary);
+    if (!inFile)
+        return false;
+
+    std::string written((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+    return written == mapData;
+}
+
+struct ADTExtractTask
 {
     std::string mpqFileName;
     std::string outputFileName;
+};
+
+bool ExtractMapsFromMpq(uint32 build)
+{
     std::string mpqMapName;
 
     printf("Extracting maps...\n");
@@ -933,7 +1002,8 @@ void ExtractMapsFromMpq(uint32 build)
     path += "/maps/";
     CreateDir(path);
 
-    printf("Convert map files\n");
+    // WDT files are read first, then the ADT files of all maps are converted by the worker threads
+    std::vector<ADTExtractTask> tasks;
     for (uint32 z = 0; z < map_count; ++z)
     {
         printf("Extract %s (%d/%u)                  \n", map_ids[z].name, z + 1, map_count);
@@ -954,16 +1024,45 @@ void ExtractMapsFromMpq(uint32 build)
                 if (!wdt.main->adt_list[y][x].exist)
                     continue;
 
-                mpqFileName = Trinity::StringFormat("World\\Maps\\%s\\%s_%u_%u.adt", map_ids[z].name, map_ids[z].name, x, y);
-                outputFileName = Trinity::StringFormat("%s/maps/%03u%02u%02u.map", output_path, map_ids[z].id, y, x);
-                ConvertADT(mpqFileName, outputFileName, y, x, build);
+                ADTExtractTask task;
+                task.mpqFileName = Trinity::StringFormat("World\\Maps\\%s\\%s_%u_%u.adt", map_ids[z].name, map_ids[z].name, x, y);
+                task.outputFileName = Trinity::StringFormat("%s/maps/%03u%02u%02u.map", output_path, map_ids[z].id, y, x);
+                tasks.push_back(std::move(task));
             }
-            // draw progress bar
-            printf("Processing........................%d%%\r", (100 * (y + 1)) / WDT_MAP_SIZE);
         }
     }
-    printf("\n");
     delete[] map_ids;
+
+    printf("Convert map files (%u threads)\n", std::max(CONF_threads, 1u));
+    uint32 startTime = GetMSTime();
+    std::atomic<uint32> done(0);
+    Trinity::RunParallelTasks(tasks.size(), CONF_threads, [&](size_t i)
+    {
+        ExtractADT(tasks[i].mpqFileName, tasks[i].outputFileName, build);
+
+        // draw progress bar
+        uint32 count = ++done;
+        if (count * 100 / tasks.size() != (count - 1) * 100 / tasks.size())
+            printf("Processing........................%u%%\r", uint32(count * 100 / tasks.size()));
+    });
+    uint32 convertTime = GetMSTimeDiffToNow(startTime);
+    printf("\nConverted %u map files in %u ms (%.1f files/s)\n", uint32(tasks.size()), convertTime, tasks.size() * 1000.0f / std::max(convertTime, 1u));
+
+    if (!CONF_verify)
+        return true;
+
+    printf("Verifying map files...\n");
+    uint32 mismatches = 0;
+    for (ADTExtractTask const& task : tasks)
+    {
+        if (!VerifyADT(task.mpqFileName, task.outputFileName, build))
+        {
+            printf("Map file '%s' differs from single threaded conversion\n", task.outputFileName.c_str());
+            ++mismatches;
+        }
+    }
+    printf("Verified %u map files, %u mismatches\n", uint32(tasks.size()), mismatches);
+    return mismatches == 0;
 }
 
 bool ExtractFile(char const* mpq_name, std::string const& filename)
@@ -1189,10 +1288,13 @@ int main(int argc, char * arg[])
         LoadCommonMPQFiles();
 
         // Extract maps
-        ExtractMapsFromMpq(build);
+        bool success = ExtractMapsFromMpq(build);
 
         // Close MPQs
         CloseMPQFiles();
+
+        if (!success)
+            return 1;
     }
 
     return 0;
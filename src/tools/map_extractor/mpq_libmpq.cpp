@@ -19,9 +19,13 @@
 #include "mpq_libmpq04.h"
 #include <deque>
 #include <cstdio>
+#include <mutex>
 
 ArchiveSet gOpenArchives;
 
+// libmpq archive handles are not thread-safe, files are read one at a time
+static std::mutex mpqReadLock;
+
 MPQArchive::MPQArchive(char const* filename)
 {
     int result = libmpq__archive_open(&mpq_a, filename, -1);
@@ -64,6 +68,7 @@ MPQFile::MPQFile(char const* filename) :
     pointer(0),
     size(0)
 {
+    std::lock_guard<std::mutex> lock(mpqReadLock);
     for (ArchiveSet::iterator i = gOpenArchives.begin(); i != gOpenArchives.end(); ++i)
     {
         mpq_archive *mpq_a = (*i)->mpq_a;
@@ -11,21 +11,62 @@
 #include "DetourCommon.h"
 
 #include "MMapManager.h"
+#include "VMapDefinitions.h"
 
 namespace MMAP
 {
+    static char const* const MANIFEST_FILE_NAME = "mmaps/tiles.manifest";
+
+    static uint64 packManifestKey(uint32 mapID, uint32 tileX, uint32 tileY)
+    {
+        return (uint64(mapID) << 32) | StaticMapTree::packTileID(tileX, tileY);
+    }
+
+    // 64 bit FNV-1a, only used to detect changed input files
+    static uint64 hashBytes(uint64 hash, void const* data, size_t size)
+    {
+        uint8 const* bytes = static_cast<uint8 const*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001B3ULL;
+        }
+        return hash;
+    }
+
+    static uint64 hashFile(uint64 hash, std::string const& fileName)
+    {
+        FILE* file = fopen(fileName.c_str(), "rb");
+        if (!file)
+        {
+            // a missing input still has to change the hash, e.g. a neighbour tile being removed
+            uint8 const missing = 0xFF;
+            return hashBytes(hash, &missing, sizeof(missing));
+        }
+
+        uint8 buffer[64 * 1024];
+        size_t count;
+        while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0)
+            hash = hashBytes(hash, buffer, count);
+
+        fclose(file);
+        return hash;
+    }
+
     MapBuilder::MapBuilder(bool skipLiquid,
         bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
         bool debugOutput, int mapid, bool quick, const char* offMeshFilePath) :
         m_terrainBuilder     (NULL),
         m_debugOutput        (debugOutput),
         m_offMeshFilePath    (offMeshFilePath),
+        m_skipLiquid         (skipLiquid),
         m_skipContinents     (skipContinents),
         m_skipJunkMaps       (skipJunkMaps),
         m_skipBattlegrounds  (skipBattlegrounds),
         m_mapid              (mapid),
         m_totalTiles         (0u),
         m_totalTilesProcessed(0u),
+        m_totalTilesUnchanged(0u),
         m_rcContext          (NULL),
         _cancelationToken    (false),
         m_quick(quick)
@@ -154,57 +195,293 @@ namespace MMAP
 
     void MapBuilder::WorkerThread()
     {
+        // TerrainBuilder keeps per map state (loaded vmap tiles, last heightmap), each thread needs its own
+        TerrainBuilder terrainBuilder(m_skipLiquid, m_quick);
+
         while (1)
         {
-            uint32 mapId = 0;
+            TileBuildTask* task = nullptr;
 
-            _queue.WaitAndPop(mapId);
+            _queue.WaitAndPop(task);
 
-            if (_cancelationToken)
+            if (_cancelationToken || !task)
                 return;
 
-            buildMap(mapId);
+            buildTileTask(*task, &terrainBuilder);
+            delete task;
         }
     }
+
     void MapBuilder::buildAllMaps(unsigned int threads)
     {
         printf("Using %u threads to extract mmaps\n", threads);
 
-        for (unsigned int i = 0; i < threads; ++i)
-        {
-            _workerThreads.push_back(std::thread(&MapBuilder::WorkerThread, this));
-        }
+        loadManifest();
+        loadOffMeshLines();
 
+        // biggest maps first so that their tiles are not the last ones left
         m_tiles.sort([](MapTiles a, MapTiles b)
         {
             return a.m_tiles->size() > b.m_tiles->size();
         });
 
+        std::vector<std::unique_ptr<MapBuildState>> maps;
+        std::vector<TileBuildTask> tasks;
+        m_totalTiles = 0;
         for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
         {
             uint32 mapId = it->m_mapId;
-            if (!shouldSkipMap(mapId))
+            if (m_mapid >= 0 ? mapId != uint32(m_mapid) : shouldSkipMap(mapId))
+                continue;
+
+            std::set<uint32>* tiles = it->m_tiles;
+            if (tiles->empty())
+                continue;
+
+            dtNavMeshParams navMeshParams;
+            if (!buildNavMeshParams(mapId, navMeshParams))
+            {
+                printf("[Map %03i] Failed creating navmesh!\n", mapId);
+                continue;
+            }
+
+            printf("[Map %03i] We have %u tiles.                          \n", mapId, (unsigned int)tiles->size());
+            maps.emplace_back(new MapBuildState(mapId, navMeshParams, tiles->size()));
+            for (std::set<uint32>::iterator tileItr = tiles->begin(); tileItr != tiles->end(); ++tileItr)
+            {
+                uint32 tileX, tileY;
+                StaticMapTree::unpackTileID(*tileItr, tileX, tileY);
+                tasks.emplace_back(maps.back().get(), tileX, tileY);
+            }
+            m_totalTiles += tiles->size();
+        }
+
+        if (threads > 0)
+        {
+            for (TileBuildTask const& task : tasks)
+                _queue.Push(new TileBuildTask(task));
+
+            for (unsigned int i = 0; i < threads; ++i)
+                _workerThreads.push_back(std::thread(&MapBuilder::WorkerThread, this));
+
+            while (!_queue.Empty())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+            }
+
+            _cancelationToken = true;
+
+            _queue.Cancel();
+
+            for (auto& thread : _workerThreads)
+            {
+                thread.join();
+            }
+        }
+        else
+        {
+            TerrainBuilder terrainBuilder(m_skipLiquid, m_quick);
+            for (TileBuildTask const& task : tasks)
+                buildTileTask(task, &terrainBuilder);
+        }
+
+        saveManifest();
+        printf("%u tiles processed, %u skipped as unchanged since last build\n", uint32(m_totalTilesProcessed), uint32(m_totalTilesUnchanged));
+    }
+
+    /**************************************************************************/
+    void MapBuilder::buildTileTask(TileBuildTask const& task, TerrainBuilder* terrainBuilder)
+    {
+        uint32 mapID = task.m_map->m_mapId;
+        uint64 inputHash = getTileInputHash(mapID, task.m_tileX, task.m_tileY);
+
+        if (shouldSkipTile(mapID, task.m_tileX, task.m_tileY, inputHash))
+            ++m_totalTilesUnchanged;
+        else
+        {
+            dtNavMesh* navMesh = dtAllocNavMesh();
+            if (dtStatusFailed(navMesh->init(&task.m_map->m_navMeshParams)))
+                printf("[Map %03i] Failed creating navmesh for tile [%02u,%02u]!\n", mapID, task.m_tileX, task.m_tileY);
+            else
             {
-                if (threads > 0)
-                    _queue.Push(mapId);
-                else
-                    buildMap(mapId);
+                // a tile left without geometry writes no file, the one of the previous build must not stay
+                char fileName[255];
+                sprintf(fileName, "mmaps/%03u%02i%02i.mmtile", mapID, task.m_tileY, task.m_tileX);
+                std::remove(fileName);
+
+                buildTile(mapID, task.m_tileX, task.m_tileY, navMesh, terrainBuilder);
+
+                bool written = shouldSkipTile(mapID, task.m_tileX, task.m_tileY);
+                std::lock_guard<std::mutex> lock(m_manifestLock);
+                TileManifestEntry& entry = m_manifest[packManifestKey(mapID, task.m_tileX, task.m_tileY)];
+                entry.m_inputHash = inputHash;
+                entry.m_written = written;
             }
+            dtFreeNavMesh(navMesh);
         }
 
-        while (!_queue.Empty())
+        ++m_totalTilesProcessed;
+
+        if (--task.m_map->m_tilesLeft == 0)
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+            printf("[Map %03i] Complete!\n", mapID);
+            // keep progress if the build gets interrupted
+            saveManifest();
         }
+    }
 
-        _cancelationToken = true;
+    /**************************************************************************/
+    void MapBuilder::loadManifest()
+    {
+        FILE* file = fopen(MANIFEST_FILE_NAME, "r");
+        if (!file)
+        {
+            printf("No tile manifest found, every tile will be rebuilt.\n");
+            return;
+        }
 
-        _queue.Cancel();
+        uint32 mapID, tileX, tileY, written;
+        unsigned long long inputHash;
+        while (fscanf(file, "%u %u %u %llx %u", &mapID, &tileX, &tileY, &inputHash, &written) == 5)
+            m_manifest[packManifestKey(mapID, tileX, tileY)] = { uint64(inputHash), written != 0 };
 
-        for (auto& thread : _workerThreads)
+        fclose(file);
+        printf("Loaded tile manifest with %u tiles.\n", uint32(m_manifest.size()));
+    }
+
+    void MapBuilder::saveManifest()
+    {
+        std::lock_guard<std::mutex> lock(m_manifestLock);
+
+        std::string tmpFileName = std::string(MANIFEST_FILE_NAME) + ".tmp";
+        FILE* file = fopen(tmpFileName.c_str(), "w");
+        if (!file)
+        {
+            char message[1024];
+            sprintf(message, "Failed to open %s for writing!\n", tmpFileName.c_str());
+            perror(message);
+            return;
+        }
+
+        for (auto const& itr : m_manifest)
         {
-            thread.join();
+            uint32 tileX, tileY;
+            StaticMapTree::unpackTileID(uint32(itr.first), tileX, tileY);
+            fprintf(file, "%u %u %u %016llx %u\n", uint32(itr.first >> 32), tileX, tileY, (unsigned long long)itr.second.m_inputHash, itr.second.m_written ? 1 : 0);
         }
+
+        fclose(file);
+        std::remove(MANIFEST_FILE_NAME);
+        std::rename(tmpFileName.c_str(), MANIFEST_FILE_NAME);
+    }
+
+    /**************************************************************************/
+    void MapBuilder::loadOffMeshLines()
+    {
+        if (!m_offMeshFilePath)
+            return;
+
+        FILE* fp = fopen(m_offMeshFilePath, "rb");
+        if (!fp)
+            return;
+
+        // same parsing as TerrainBuilder::loadOffMeshConnections, only kept to detect changed connections per tile
+        char buf[512];
+        while (fgets(buf, 512, fp))
+        {
+            uint32 mid, tx, ty;
+            if (sscanf(buf, "%u %u,%u", &mid, &tx, &ty) != 3)
+                continue;
+
+            m_offMeshLines[packManifestKey(mid, tx, ty)] += buf;
+        }
+
+        fclose(fp);
+    }
+
+    /**************************************************************************/
+    uint64 MapBuilder::getModelHash(std::string const& modelName)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_modelHashesLock);
+            auto itr = m_modelHashes.find(modelName);
+            if (itr != m_modelHashes.end())
+                return itr->second;
+        }
+
+        uint64 hash = hashFile(0xCBF29CE484222325ULL, "vmaps/" + modelName + ".vmo");
+
+        std::lock_guard<std::mutex> lock(m_modelHashesLock);
+        m_modelHashes[modelName] = hash;
+        return hash;
+    }
+
+    uint64 MapBuilder::getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY)
+    {
+        uint64 hash = 0xCBF29CE484222325ULL;
+
+        // build settings
+        uint32 const settings[] = { MMAP_VERSION, uint32(DT_NAVMESH_VERSION), m_skipLiquid, m_quick };
+        hash = hashBytes(hash, settings, sizeof(settings));
+
+        // terrain, see TerrainBuilder::loadMap, neighbour tiles are used for the borders
+        char fileName[255];
+        int32 const neighbours[5][2] = { { 0, 0 }, { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+        for (auto const& offset : neighbours)
+        {
+            sprintf(fileName, "maps/%03u%02u%02u.map", mapID, tileY + offset[1], tileX + offset[0]);
+            hash = hashFile(hash, fileName);
+        }
+
+        // models, see TerrainBuilder::loadVMap and StaticMapTree::InitMap/LoadMapTile
+        std::string treeFileName = "vmaps/" + VMapManager2::getMapFileName(mapID);
+        if (FILE* rf = fopen(treeFileName.c_str(), "rb"))
+        {
+            char chunk[8];
+            char tiled = 0;
+            BIH tree;
+            ModelSpawn spawn;
+            if (fread(chunk, sizeof(chunk), 1, rf) == 1 && !strncmp(chunk, VMAP_MAGIC, 8) && fread(&tiled, sizeof(char), 1, rf) == 1 && !tiled)
+            {
+                // non tiled maps have their only model spawn in the tree file
+                if (fread(chunk, 4, 1, rf) == 1 && tree.readFromFile(rf) && fread(chunk, 4, 1, rf) == 1 && ModelSpawn::readFromFile(rf, spawn))
+                {
+                    uint64 modelHash = getModelHash(spawn.name);
+                    hash = hashBytes(hash, &modelHash, sizeof(modelHash));
+                }
+                hash = hashFile(hash, treeFileName);
+            }
+            fclose(rf);
+        }
+
+        std::string tileFileName = "vmaps/" + StaticMapTree::getTileFileName(mapID, tileY, tileX);
+        hash = hashFile(hash, tileFileName);
+        if (FILE* tf = fopen(tileFileName.c_str(), "rb"))
+        {
+            char chunk[8];
+            uint32 numSpawns = 0;
+            if (fread(chunk, sizeof(chunk), 1, tf) == 1 && fread(&numSpawns, sizeof(uint32), 1, tf) == 1)
+            {
+                for (uint32 i = 0; i < numSpawns; ++i)
+                {
+                    ModelSpawn spawn;
+                    uint32 referencedVal;
+                    if (!ModelSpawn::readFromFile(tf, spawn) || fread(&referencedVal, sizeof(uint32), 1, tf) != 1)
+                        break;
+
+                    uint64 modelHash = getModelHash(spawn.name);
+                    hash = hashBytes(hash, &modelHash, sizeof(modelHash));
+                }
+            }
+            fclose(tf);
+        }
+
+        // off mesh connections
+        auto offMeshItr = m_offMeshLines.find(packManifestKey(mapID, tileX, tileY));
+        if (offMeshItr != m_offMeshLines.end())
+            hash = hashBytes(hash, offMeshItr->second.data(), offMeshItr->second.size());
+
+        return hash;
     }
     /**************************************************************************/
     void MapBuilder::getGridBounds(uint32 mapID, uint32 &minX, uint32 &minY, uint32 &maxX, uint32 &maxY) const
@@ -332,7 +609,7 @@ namespace MMAP
         getTileBounds(tileX, tileY, data.solidVerts.getCArray(), data.solidVerts.size() / 3, bmin, bmax);
 
         // build navmesh tile
-        buildMoveMapTile(mapId, tileX, tileY, data, bmin, bmax, navMesh);
+        buildMoveMapTile(mapId, tileX, tileY, data, bmin, bmax, navMesh, m_terrainBuilder);
         fclose(file);
     }
 
@@ -347,51 +624,12 @@ namespace MMAP
             return;
         }
 
-        buildTile(mapID, tileX, tileY, navMesh);
+        buildTile(mapID, tileX, tileY, navMesh, m_terrainBuilder);
         dtFreeNavMesh(navMesh);
     }
 
     /**************************************************************************/
-    void MapBuilder::buildMap(uint32 mapID)
-    {
-        std::set<uint32>* tiles = getTileList(mapID);
-
-        if (!tiles->empty())
-        {
-            // build navMesh
-            dtNavMesh* navMesh = NULL;
-            buildNavMesh(mapID, navMesh);
-            if (!navMesh)
-            {
-                printf("[Map %03i] Failed creating navmesh!\n", mapID);
-                m_totalTilesProcessed += tiles->size();
-                return;
-            }
-
-            // now start building mmtiles for each tile
-            printf("[Map %03i] We have %u tiles.                          \n", mapID, (unsigned int)tiles->size());
-            for (std::set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
-            {
-                uint32 tileX, tileY;
-
-                // unpack tile coords
-                StaticMapTree::unpackTileID((*it), tileX, tileY);
-
-                if (!shouldSkipTile(mapID, tileX, tileY))
-                    buildTile(mapID, tileX, tileY, navMesh);
-
-                ++m_totalTilesProcessed;
-                
-            }
-
-            dtFreeNavMesh(navMesh);
-        }
-
-        printf("[Map %03i] Complete!\n", mapID);
-    }
-
-    /**************************************************************************/
-    void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
+    void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh, TerrainBuilder* terrainBuilder)
     {
         printf("%u%% [Map %03i] Building tile [%02u,%02u]\n", percentageDone(m_totalTiles, m_totalTilesProcessed), mapID, tileX, tileY);
         printf("[Map %03i] Building tile [%02u,%02u]\n", mapID, tileX, tileY);
@@ -399,14 +637,14 @@ namespace MMAP
         MeshData meshData;
 
         // get heightmap data
-        m_terrainBuilder->loadMap(mapID, tileX, tileY, meshData);
+        terrainBuilder->loadMap(mapID, tileX, tileY, meshData);
 
         // remove unused vertices
         TerrainBuilder::cleanVertices(meshData.solidVerts, meshData.solidTris);
         TerrainBuilder::cleanVertices(meshData.liquidVerts, meshData.liquidTris);
 
         // get model data
-        m_terrainBuilder->loadVMap(mapID, tileY, tileX, meshData);
+        terrainBuilder->loadVMap(mapID, tileY, tileX, meshData);
 
         // if there is no data, give up now
         if (!meshData.solidVerts.size() && !meshData.liquidVerts.size())
@@ -428,15 +666,30 @@ namespace MMAP
         float bmin[3], bmax[3];
         getTileBounds(tileX, tileY, allVerts.getCArray(), allVerts.size() / 3, bmin, bmax);
 
-        m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
+        terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
 
         // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
-        m_terrainBuilder->unloadVMap(mapID, tileY, tileX);
+        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh, terrainBuilder);
+        terrainBuilder->unloadVMap(mapID, tileY, tileX);
     }
 
     /**************************************************************************/
     void MapBuilder::buildNavMesh(uint32 mapID, dtNavMesh* &navMesh)
+    {
+        dtNavMeshParams navMeshParams;
+        if (!buildNavMeshParams(mapID, navMeshParams))
+            return;
+
+        navMesh = dtAllocNavMesh();
+        if (dtStatusFailed(navMesh->init(&navMeshParams)))
+        {
+            dtFreeNavMesh(navMesh);
+            navMesh = NULL;
+        }
+    }
+
+    /**************************************************************************/
+    bool MapBuilder::buildNavMeshParams(uint32 mapID, dtNavMeshParams& navMeshParams)
     {
         std::set<uint32>* tiles = getTileList(mapID);
 
@@ -476,7 +729,6 @@ namespace MMAP
         /***       now create the navmesh       ***/
 
         // navmesh creation params
-        dtNavMeshParams navMeshParams;
         memset(&navMeshParams, 0, sizeof(dtNavMeshParams));
         navMeshParams.tileWidth = GRID_SIZE;
         navMeshParams.tileHeight = GRID_SIZE;
@@ -484,12 +736,14 @@ namespace MMAP
         navMeshParams.maxTiles = maxTiles;
         navMeshParams.maxPolys = maxPolysPerTile;
 
-        navMesh = dtAllocNavMesh();
+        dtNavMesh* navMesh = dtAllocNavMesh();
         printf("[Map %03i] Creating navMesh...\n", mapID);
-        if (!navMesh->init(&navMeshParams))
+        dtStatus initResult = navMesh->init(&navMeshParams);
+        dtFreeNavMesh(navMesh);
+        if (dtStatusFailed(initResult))
         {
             printf("[Map %03i] Failed creating navmesh!                \n", mapID);
-            return;
+            return false;
         }
 
         char fileName[25];
@@ -498,16 +752,16 @@ namespace MMAP
         FILE* file = fopen(fileName, "wb");
         if (!file)
         {
-            dtFreeNavMesh(navMesh);
             char message[1024];
             sprintf(message, "[Map %03i] Failed to open %s for writing!\n", mapID, fileName);
             perror(message);
-            return;
+            return false;
         }
 
         // now that we know navMesh params are valid, we can write them to file
         fwrite(&navMeshParams, sizeof(dtNavMeshParams), 1, file);
         fclose(file);
+        return true;
     }
 
     inline void calcTriNormal(const float* v0, const float* v1, const float* v2, float* norm)
@@ -520,7 +774,7 @@ namespace MMAP
     }
 
     //mark triangle under terrain as non walkable (adapted from nost)
-    void MapBuilder::removeVMAPTrianglesUnderTerrain(uint32 MapID, MeshData& meshData, unsigned char triFlags[], float* tVerts, int* tTris, int tTriCount)
+    void MapBuilder::removeVMAPTrianglesUnderTerrain(uint32 MapID, MeshData& meshData, unsigned char triFlags[], float* tVerts, int* tTris, int tTriCount, TerrainBuilder* terrainBuilder)
     {
         /* sun; removed for now, does not seem working + don't see obvious cases where this is useful for now
         float norm[3];
@@ -542,13 +796,13 @@ namespace MMAP
                         verts[3 * c + v] = (5 * tVerts[tTris[c] * 3 + v] + tVerts[tTris[(c + 1) % 3] * 3 + v] + tVerts[tTris[(c + 2) % 3] * 3 + v]) / 7;
 
                 // A triangle is undermap if all corners are undermap
-                bool undermap1 = m_terrainBuilder->IsUnderMap(MapID, &verts[0]);
+                bool undermap1 = terrainBuilder->IsUnderMap(MapID, &verts[0]);
                 if (!undermap1)
                     continue;
-                bool undermap2 = m_terrainBuilder->IsUnderMap(MapID, &verts[3]);
+                bool undermap2 = terrainBuilder->IsUnderMap(MapID, &verts[3]);
                 if (!undermap2)
                     continue;
-                bool undermap3 = m_terrainBuilder->IsUnderMap(MapID, &verts[6]);
+                bool undermap3 = terrainBuilder->IsUnderMap(MapID, &verts[6]);
                 if (!undermap3)
                     continue;
 
@@ -613,7 +867,7 @@ namespace MMAP
     /**************************************************************************/
     void MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
         MeshData &meshData, float bmin[3], float bmax[3],
-        dtNavMesh* navMesh)
+        dtNavMesh* navMesh, TerrainBuilder* terrainBuilder)
     {
         // console output
         char tileString[20];
@@ -697,7 +951,7 @@ namespace MMAP
                 markWalkableTriangles(meshData, triFlags, tVerts, tTris, tTriCount); // Replaces rcClearUnwalkableTriangles (adapted from nost)
                 // Now we remove terrain triangles under the mesh (actually set flags to 0) - Also adapted from Nost
                 if(!m_quick)
-                    removeVMAPTrianglesUnderTerrain(mapID, meshData, triFlags, tVerts, tTris, tTriCount);
+                    removeVMAPTrianglesUnderTerrain(mapID, meshData, triFlags, tVerts, tTris, tTriCount, terrainBuilder);
 
                 /// 4. Every triangle is correctly marked now, we can rasterize everything
                 rcRasterizeTriangles(m_rcContext, tVerts, tVertCount, tTris, triFlags, tTriCount, *tile.solid, config.walkableClimb);
@@ -930,7 +1184,7 @@ namespace MMAP
 
             // write header
             MmapTileHeader header;
-            header.usesLiquids = m_terrainBuilder->usesLiquids();
+            header.usesLiquids = terrainBuilder->usesLiquids();
             header.size = uint32(navDataSize);
             fwrite(&header, sizeof(MmapTileHeader), 1, file);
 
@@ -1096,6 +1350,27 @@ namespace MMAP
 
         return true;
     }
+
+    bool MapBuilder::shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash)
+    {
+        TileManifestEntry entry;
+        {
+            std::lock_guard<std::mutex> lock(m_manifestLock);
+            auto itr = m_manifest.find(packManifestKey(mapID, tileX, tileY));
+            if (itr == m_manifest.end())
+                return false;
+            entry = itr->second;
+        }
+
+        if (entry.m_inputHash != inputHash)
+            return false;
+
+        // tiles without geometry have no file, their previous one was removed when they were built
+        if (!entry.m_written)
+            return true;
+
+        return shouldSkipTile(mapID, tileX, tileY);
+    }
     /**************************************************************************/
     /**
     * Build navmesh for GameObject model.
@@ -25,6 +25,8 @@
 #include <map>
 #include <list>
 #include <atomic>
+#include <mutex>
+#include <unordered_map>
 
 #include "TerrainBuilder.h"
 #include "IntermediateValues.h"
@@ -55,6 +57,33 @@ namespace MMAP
 
     typedef std::list<MapTiles> TileList;
 
+    // shared by all tile tasks of a map, each task creates its own navmesh from these params
+    struct MapBuildState
+    {
+        MapBuildState(uint32 mapId, dtNavMeshParams const& params, uint32 tileCount) :
+            m_mapId(mapId), m_navMeshParams(params), m_tilesLeft(tileCount) {}
+
+        uint32 m_mapId;
+        dtNavMeshParams m_navMeshParams;
+        std::atomic<uint32> m_tilesLeft;
+    };
+
+    struct TileBuildTask
+    {
+        TileBuildTask(MapBuildState* map, uint32 tileX, uint32 tileY) : m_map(map), m_tileX(tileX), m_tileY(tileY) {}
+
+        MapBuildState* m_map;
+        uint32 m_tileX;
+        uint32 m_tileY;
+    };
+
+    // input hash of a tile at the time it was last built, see mmaps/tiles.manifest
+    struct TileManifestEntry
+    {
+        uint64 m_inputHash;
+        bool m_written;         // false if the tile had no geometry and no .mmtile was written
+    };
+
     struct Tile
     {
         Tile() : chf(NULL), solid(NULL), cset(NULL), pmesh(NULL), dmesh(NULL) {}
@@ -109,14 +138,14 @@ namespace MMAP
 
             ~MapBuilder();
 
-            // builds all mmap tiles for the specified map id (ignores skip settings)
-            void buildMap(uint32 mapID);
             void buildMeshFromFile(char* name);
 
             // builds an mmap tile for the specified map and its mesh
             void buildSingleTile(uint32 mapID, uint32 tileX, uint32 tileY);
 
-            // builds list of maps, then builds all of mmap tiles (based on the skip settings)
+            // builds list of maps, then builds all of mmap tiles (based on the skip settings, or only the map id given
+            // to the constructor, ignoring skip settings). Tiles are shared among threads, tiles whose input did not change since
+            // the last build are skipped.
             void buildAllMaps(unsigned int threads);
 
             void buildGameObject(std::string modelName, uint32 displayId);
@@ -130,11 +159,14 @@ namespace MMAP
             std::set<uint32>* getTileList(uint32 mapID);
 
             void markWalkableTriangles(MeshData& meshData, unsigned char triFlags[], float* tVerts, int* tTris, int tTriCount);
-            void removeVMAPTrianglesUnderTerrain(uint32 mapID, MeshData& meshData, unsigned char triFlags[], float* tVerts, int* tTris, int tTriCount);
+            void removeVMAPTrianglesUnderTerrain(uint32 mapID, MeshData& meshData, unsigned char triFlags[], float* tVerts, int* tTris, int tTriCount, TerrainBuilder* terrainBuilder);
 
             void buildNavMesh(uint32 mapID, dtNavMesh* &navMesh);
+            // computes navmesh params for the map and writes them to its .mmap file
+            bool buildNavMeshParams(uint32 mapID, dtNavMeshParams& navMeshParams);
 
-            void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
+            void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh, TerrainBuilder* terrainBuilder);
+            void buildTileTask(TileBuildTask const& task, TerrainBuilder* terrainBuilder);
 
             // move map building
             void buildMoveMapTile(uint32 mapID,
@@ -143,7 +175,8 @@ namespace MMAP
                 MeshData &meshData,
                 float bmin[3],
                 float bmax[3],
-                dtNavMesh* navMesh);
+                dtNavMesh* navMesh,
+                TerrainBuilder* terrainBuilder);
 
             void getTileBounds(uint32 tileX, uint32 tileY,
                 float* verts, int vertCount,
@@ -153,6 +186,14 @@ namespace MMAP
             bool shouldSkipMap(uint32 mapID);
             bool isTransportMap(uint32 mapID);
             bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY);
+            bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash);
+
+            // incremental builds
+            void loadManifest();
+            void saveManifest();
+            void loadOffMeshLines();
+            uint64 getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY);
+            uint64 getModelHash(std::string const& modelName);
 
             // Fences should not be passable
             float const agentMaxClimbModelTerrainTransition = 1.2f;
@@ -167,6 +208,7 @@ namespace MMAP
             bool m_debugOutput;
 
             const char* m_offMeshFilePath;
+            bool m_skipLiquid;
             bool m_skipContinents;
             bool m_skipJunkMaps;
             bool m_skipBattlegrounds;
@@ -185,13 +227,22 @@ namespace MMAP
 
             std::atomic<uint32> m_totalTiles;
             std::atomic<uint32> m_totalTilesProcessed;
+            std::atomic<uint32> m_totalTilesUnchanged;
 
             // build performance - not really used for now
             rcContext* m_rcContext;
 
             std::vector<std::thread> _workerThreads;
-            ProducerConsumerQueue<uint32> _queue;
+            ProducerConsumerQueue<TileBuildTask*> _queue;
             std::atomic<bool> _cancelationToken;
+
+            std::mutex m_manifestLock;
+            std::unordered_map<uint64 /*mapId << 32 | tileId*/, TileManifestEntry> m_manifest;
+
+            std::mutex m_modelHashesLock;
+            std::unordered_map<std::string, uint64> m_modelHashes;
+
+            std::unordered_map<uint64 /*mapId << 32 | tileId*/, std::string> m_offMeshLines;
     };
 }
 #endif
\ No newline at end of file
@@ -258,11 +258,11 @@ int main(int argc, char** argv)
         builder.buildMeshFromFile(file);
     else if (tileX > -1 && tileY > -1 && mapnum >= 0)
         builder.buildSingleTile(mapnum, tileX, tileY);
-    else if (mapnum >= 0)
-        builder.buildMap(uint32(mapnum));
     else
     {
-        builder.buildTransports();
+        // a single map is also split by tiles among threads, the builder only picks mapnum if given
+        if (mapnum < 0)
+            builder.buildTransports();
         builder.buildAllMaps(threads);
     }
 
@@ -79,7 +79,7 @@ ADTFile::ADTFile(char* filename): ADT(filename), nWMO(0), nMDX(0), WmoInstansNam
     Adtfilename.append(filename);
 }
 
-bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY)
+bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY, std::vector<char>& spawns)
 {
     if(ADT.isEof ())
         return false;
@@ -101,15 +101,6 @@ bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY)
     //printf("xMap = %s\n", xMap.c_str());
     //printf("yMap = %s\n", yMap.c_str());
 
-    std::string dirname = std::string(szWorkDirWmo) + "/dir_bin";
-    FILE *dirfile;
-    dirfile = fopen(dirname.c_str(), "ab");
-    if(!dirfile)
-    {
-        printf("Can't open dirfile!'%s'\n", dirname.c_str());
-        return false;
-    }
-
     while (!ADT.isEof())
     {
         char fourcc[5];
@@ -181,7 +172,7 @@ bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY)
                 {
                     uint32 id;
                     ADT.read(&id, 4);
-                    ModelInstance inst(ADT,ModelInstansName[id].c_str(), map_num, tileX, tileY, dirfile);
+                    ModelInstance inst(ADT,ModelInstansName[id].c_str(), map_num, tileX, tileY, spawns);
                 }
                 delete[] ModelInstansName;
             }
@@ -195,7 +186,7 @@ bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY)
                 {
                     uint32 id;
                     ADT.read(&id, 4);
-                    WMOInstance inst(ADT,WmoInstansName[id].c_str(), map_num, tileX, tileY, dirfile);
+                    WMOInstance inst(ADT,WmoInstansName[id].c_str(), map_num, tileX, tileY, spawns);
                 }
                 delete[] WmoInstansName;
             }
@@ -204,7 +195,6 @@ bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY)
         ADT.seek(nextpos);
     }
     ADT.close();
-    fclose(dirfile);
     return true;
 }
 
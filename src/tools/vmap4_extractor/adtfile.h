@@ -121,7 +121,8 @@ public:
     int nMDX;
     std::string* WmoInstansName;
     std::string* ModelInstansName;
-    bool init(uint32 map_num, uint32 tileX, uint32 tileY);
+    // model spawns are appended to spawns, see dir_bin
+    bool init(uint32 map_num, uint32 tileX, uint32 tileY, std::vector<char>& spawns);
     //void LoadMapChunks();
 
     //uint32 wmo_count;
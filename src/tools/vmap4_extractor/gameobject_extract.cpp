@@ -20,10 +20,20 @@
 #include "dbcfile.h"
 #include "adtfile.h"
 #include "vmapexport.h"
+#include "ParallelTasks.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <stdio.h>
 
+// with parallel ADT parsing several threads may need the same model, only the first one converts it
+// and the others wait for it since they read the converted file right after
+static std::mutex modelExtractLock;
+static std::condition_variable modelExtractCondition;
+static std::map<std::string, bool /*done*/> modelExtractStates;
+
 bool ExtractSingleModel(std::string& fname)
 {
     char * name = GetPlainName((char*)fname.c_str());
@@ -43,14 +53,33 @@ bool ExtractSingleModel(std::string& fname)
     output += "/";
     output += name;
 
-    if (FileExists(output.c_str()))
-        return true;
+    {
+        std::unique_lock<std::mutex> lock(modelExtractLock);
+        auto itr = modelExtractStates.find(output);
+        if (itr != modelExtractStates.end())
+        {
+            while (!itr->second)
+                modelExtractCondition.wait(lock);
+            return FileExists(output.c_str());
+        }
+        modelExtractStates[output] = false;
+    }
 
-    Model mdl(fname);
-    if (!mdl.open())
-        return false;
+    bool result = FileExists(output.c_str());
+    if (!result)
+    {
+        Model mdl(fname);
+        result = mdl.open() && mdl.ConvertToVMAPModel(output.c_str());
+        if (result)
+            ++extractedModelCount;
+    }
 
-    return mdl.ConvertToVMAPModel(output.c_str());
+    {
+        std::lock_guard<std::mutex> lock(modelExtractLock);
+        modelExtractStates[output] = true;
+    }
+    modelExtractCondition.notify_all();
+    return result;
 }
 
 void ExtractGameobjectModels()
@@ -75,6 +104,15 @@ void ExtractGameobjectModels()
         return;
     }
 
+    struct DisplayModel
+    {
+        uint32 displayId;
+        std::string path;
+        std::string name;
+        bool result;
+    };
+
+    std::vector<DisplayModel> models;
     for (DBCFile::Iterator it = dbc.begin(); it != dbc.end(); ++it)
     {
         path = it->getString(1);
@@ -92,28 +130,40 @@ void ExtractGameobjectModels()
 
         strToLower(ch_ext);
 
-        bool result = false;
-        if (!strcmp(ch_ext, ".wmo"))
-        {
-            result = ExtractSingleWmo(path);
-        }
-        else if (!strcmp(ch_ext, ".mdl"))
-        {
-            // TODO: extract .mdl files, if needed
+        // TODO: extract .mdl files, if needed
+        if (!strcmp(ch_ext, ".mdl"))
             continue;
-        }
-        else //if (!strcmp(ch_ext, ".mdx") || !strcmp(ch_ext, ".m2"))
-        {
-            result = ExtractSingleModel(path);
-        }
 
-        if (result)
+        models.push_back({ it->getUInt(0), path, name, false });
+    }
+
+    // the same wmo may be used by several display ids, do not let two threads convert it at once
+    std::map<std::string, size_t> firstWmoUse;
+    for (size_t i = 0; i < models.size(); ++i)
+        if (!strcmp(GetExtension((char*)models[i].name.c_str()), ".wmo"))
+            firstWmoUse.insert(std::make_pair(models[i].name, i));
+
+    Trinity::RunParallelTasks(models.size(), extractThreads, [&](size_t i)
+    {
+        DisplayModel& model = models[i];
+        if (strcmp(GetExtension((char*)model.name.c_str()), ".wmo"))
+            model.result = ExtractSingleModel(model.path); //if (!strcmp(ch_ext, ".mdx") || !strcmp(ch_ext, ".m2"))
+        else if (firstWmoUse.find(model.name)->second == i)
+            model.result = ExtractSingleWmo(model.path);
+    });
+
+    for (DisplayModel& model : models)
+    {
+        // duplicated wmos take the result of the first conversion
+        if (!model.result && !strcmp(GetExtension((char*)model.name.c_str()), ".wmo"))
+            model.result = models[firstWmoUse.find(model.name)->second].result;
+
+        if (model.result)
         {
-            uint32 displayId = it->getUInt(0);
-            size_t path_length = strlen(name);
-            fwrite(&displayId, sizeof(uint32), 1, model_list);
+            size_t path_length = model.name.length();
+            fwrite(&model.displayId, sizeof(uint32), 1, model_list);
             fwrite(&path_length, sizeof(uint32), 1, model_list);
-            fwrite(name, sizeof(char), path_length, model_list);
+            fwrite(model.name.c_str(), sizeof(char), path_length, model_list);
         }
     }
 
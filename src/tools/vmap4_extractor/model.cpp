@@ -142,7 +142,7 @@ Vec3D fixCoordSystem2(Vec3D v)
     return Vec3D(v.x, v.z, v.y);
 }
 
-ModelInstance::ModelInstance(MPQFile& f, char const* ModelInstName, uint32 mapID, uint32 tileX, uint32 tileY, FILE *pDirfile)
+ModelInstance::ModelInstance(MPQFile& f, char const* ModelInstName, uint32 mapID, uint32 tileX, uint32 tileY, std::vector<char>& spawns)
 {
     float ff[3];
     f.read(&id, 4);
@@ -184,18 +184,18 @@ ModelInstance::ModelInstance(MPQFile& f, char const* ModelInstName, uint32 mapID
         flags |= MOD_WORLDSPAWN;
 
     //write mapID, tileX, tileY, Flags, ID, Pos, Rot, Scale, name
-    fwrite(&mapID, sizeof(uint32), 1, pDirfile);
-    fwrite(&tileX, sizeof(uint32), 1, pDirfile);
-    fwrite(&tileY, sizeof(uint32), 1, pDirfile);
-    fwrite(&flags, sizeof(uint32), 1, pDirfile);
-    fwrite(&adtId, sizeof(uint16), 1, pDirfile);
-    fwrite(&id, sizeof(uint32), 1, pDirfile);
-    fwrite(&pos, sizeof(float), 3, pDirfile);
-    fwrite(&rot, sizeof(float), 3, pDirfile);
-    fwrite(&sc, sizeof(float), 1, pDirfile);
-    size_t nlen=strlen(ModelInstName);
-    fwrite(&nlen, sizeof(uint32), 1, pDirfile);
-    fwrite(ModelInstName, sizeof(char), nlen, pDirfile);
+    AppendSpawnData(spawns, &mapID, sizeof(uint32));
+    AppendSpawnData(spawns, &tileX, sizeof(uint32));
+    AppendSpawnData(spawns, &tileY, sizeof(uint32));
+    AppendSpawnData(spawns, &flags, sizeof(uint32));
+    AppendSpawnData(spawns, &adtId, sizeof(uint16));
+    AppendSpawnData(spawns, &id, sizeof(uint32));
+    AppendSpawnData(spawns, &pos, sizeof(float) * 3);
+    AppendSpawnData(spawns, &rot, sizeof(float) * 3);
+    AppendSpawnData(spawns, &sc, sizeof(float));
+    uint32 nlen = strlen(ModelInstName);
+    AppendSpawnData(spawns, &nlen, sizeof(uint32));
+    AppendSpawnData(spawns, ModelInstName, nlen * sizeof(char));
 
     /* int realx1 = (int) ((float) pos.x / 533.333333f);
     int realy1 = (int) ((float) pos.z / 533.333333f);
@@ -60,7 +60,7 @@ public:
     float sc;
 
     ModelInstance() : id(0), scale(0), sc(0.0f) {}
-    ModelInstance(MPQFile& f, char const* ModelInstName, uint32 mapID, uint32 tileX, uint32 tileY, FILE* pDirfile);
+    ModelInstance(MPQFile& f, char const* ModelInstName, uint32 mapID, uint32 tileX, uint32 tileY, std::vector<char>& spawns);
 
 };
 
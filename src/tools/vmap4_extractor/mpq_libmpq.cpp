@@ -20,9 +20,13 @@
 #include <deque>
 #include <cstdio>
 #include <algorithm>
+#include <mutex>
 
 ArchiveSet gOpenArchives;
 
+// libmpq archives are not thread safe, with parallel extraction all reads go through here one at a time
+static std::mutex mpqReadLock;
+
 MPQArchive::MPQArchive(const char* filename)
 {
     int result = libmpq__archive_open(&mpq_a, filename, -1);
@@ -70,6 +74,8 @@ MPQFile::MPQFile(const char* filename) :
     pointer(0),
     size(0)
 {
+    std::lock_guard<std::mutex> lock(mpqReadLock);
+
     for (ArchiveSet::iterator i = gOpenArchives.begin(); i != gOpenArchives.end(); ++i)
     {
         mpq_archive *mpq_a = (*i)->mpq_a;
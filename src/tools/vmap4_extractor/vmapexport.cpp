@@ -40,6 +40,7 @@
 //#pragma comment(lib, "Winmm.lib")
 
 #include <map>
+#include <set>
 
 //From Extractor
 #include "adtfile.h"
@@ -49,6 +50,8 @@
 #include "mpq_libmpq04.h"
 
 #include "vmapexport.h"
+#include "Timer.h"
+#include "ParallelTasks.h"
 
 //------------------------------------------------------------------------------
 // Defines
@@ -74,6 +77,10 @@ char output_path[128]=".";
 char input_path[1024]=".";
 bool hasInputPathParam = false;
 bool preciseVectorData = false;
+unsigned int extractThreads = 0;
+
+std::atomic<uint32> extractedWmoCount(0);
+std::atomic<uint32> extractedModelCount(0);
 
 // Constants
 
@@ -128,22 +135,36 @@ void ReadLiquidTypeTableDBC()
 
 bool ExtractWmo()
 {
-    bool success = true;
+    std::vector<std::string> wmoFiles;
+    std::set<std::string> localFiles;
 
     //const char* ParsArchiveNames[] = {"patch-2.MPQ", "patch.MPQ", "common.MPQ", "expansion.MPQ"};
 
-    for (ArchiveSet::const_iterator ar_itr = gOpenArchives.begin(); ar_itr != gOpenArchives.end() && success; ++ar_itr)
+    for (ArchiveSet::const_iterator ar_itr = gOpenArchives.begin(); ar_itr != gOpenArchives.end(); ++ar_itr)
     {
         vector<string> filelist;
 
         (*ar_itr)->GetFileListTo(filelist);
-        for (vector<string>::iterator fname = filelist.begin(); fname != filelist.end() && success; ++fname)
+        for (vector<string>::iterator fname = filelist.begin(); fname != filelist.end(); ++fname)
         {
-            if (fname->find(".wmo") != string::npos)
-                success = ExtractSingleWmo(*fname);
+            if (fname->find(".wmo") == string::npos)
+                continue;
+
+            // files are listed in every archive overriding them, they all extract to the same local file
+            std::string localFile = GetPlainName(fname->c_str());
+            fixnamen(&localFile[0], localFile.length());
+            if (localFiles.insert(localFile).second)
+                wmoFiles.push_back(*fname);
         }
     }
 
+    std::atomic<bool> success(true);
+    Trinity::RunParallelTasks(wmoFiles.size(), extractThreads, [&](size_t i)
+    {
+        if (success && !ExtractSingleWmo(wmoFiles[i]))
+            success = false;
+    });
+
     if (success)
         printf("\nExtract wmo complete (No (fatal) errors)\n");
 
@@ -228,6 +249,8 @@ bool ExtractSingleWmo(std::string& fname)
     // Delete the extracted file in the case of an error
     if (!file_ok)
         remove(szLocalFile);
+    else
+        ++extractedWmoCount;
     return true;
 }
 
@@ -236,6 +259,7 @@ void ParsMapFiles()
     char fn[512];
     //char id_filename[64];
     char id[10];
+    std::string dirname = std::string(szWorkDirWmo) + "/dir_bin";
     for (unsigned int i=0; i<map_count; ++i)
     {
         sprintf(id,"%03u",map_ids[i].id);
@@ -244,20 +268,40 @@ void ParsMapFiles()
         if(WDT.init(id, map_ids[i].id))
         {
             printf("Processing Map %u\n[", map_ids[i].id);
-            for (int x=0; x<64; ++x)
+
+            FILE* dirfile = fopen(dirname.c_str(), "ab");
+            if (!dirfile)
             {
-                for (int y=0; y<64; ++y)
+                printf("Can't open dirfile!'%s'\n", dirname.c_str());
+                continue;
+            }
+
+            // each tile keeps its spawns in memory, they are appended to dir_bin in tile order afterwards
+            // so that the output does not depend on the thread count
+            std::vector<std::vector<char>> tileSpawns(64 * 64);
+            std::atomic<uint32> tilesDone(0);
+            Trinity::RunParallelTasks(64 * 64, extractThreads, [&](size_t tile)
+            {
+                int x = int(tile / 64);
+                int y = int(tile % 64);
+                if (ADTFile *ADT = WDT.GetMap(x,y))
                 {
-                    if (ADTFile *ADT = WDT.GetMap(x,y))
-                    {
-                        //sprintf(id_filename,"%02u %02u %03u",x,y,map_ids[i].id);//!!!!!!!!!
-                        ADT->init(map_ids[i].id, x, y);
-                        delete ADT;
-                    }
+                    //sprintf(id_filename,"%02u %02u %03u",x,y,map_ids[i].id);//!!!!!!!!!
+                    ADT->init(map_ids[i].id, x, y, tileSpawns[tile]);
+                    delete ADT;
                 }
-                printf("#");
-                fflush(stdout);
-            }
+
+                if (++tilesDone % 64 == 0)
+                {
+                    printf("#");
+                    fflush(stdout);
+                }
+            });
+
+            for (std::vector<char> const& spawns : tileSpawns)
+                fwrite(spawns.data(), 1, spawns.size(), dirfile);
+
+            fclose(dirfile);
             printf("]\n");
         }
     }
@@ -420,6 +464,18 @@ bool processArgv(int argc, char ** argv, const char *versionString)
         {
             preciseVectorData = true;
         }
+        else if(strcmp("-t",argv[i]) == 0)
+        {
+            if((i+1)<argc)
+            {
+                extractThreads = static_cast<unsigned int>(std::max(0, atoi(argv[i+1])));
+                ++i;
+            }
+            else
+            {
+                result = false;
+            }
+        }
         else
         {
             result = false;
@@ -429,10 +485,11 @@ bool processArgv(int argc, char ** argv, const char *versionString)
     if(!result)
     {
         printf("Extract %s.\n",versionString);
-        printf("%s [-?][-s][-l][-d <path>]\n", argv[0]);
+        printf("%s [-?][-s][-l][-d <path>][-t <threads>]\n", argv[0]);
         printf("   -s : (default) small size (data size optimization), ~500MB less vmap data.\n");
         printf("   -l : large size, ~500MB more vmap data. (might contain more details)\n");
         printf("   -d <path>: Path to the vector data source folder.\n");
+        printf("   -t <threads>: Number of threads converting models and ADTs, MPQ reads stay serialized. (default 0, no extra thread)\n");
         printf("   -? : This message.\n");
     }
     return result;
@@ -503,9 +560,14 @@ int main(int argc, char ** argv)
     ReadLiquidTypeTableDBC();
 #endif
 
+    printf("Using %u threads\n", std::max(1u, extractThreads));
+
     // extract data
+    uint32 startTime = GetMSTime();
+    uint32 wmoTime = 0, mapTime = 0, gameobjectTime = 0;
     if (success)
         success = ExtractWmo();
+    wmoTime = GetMSTimeDiffToNow(startTime);
 
     //xxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
     //map.dbc
@@ -529,13 +591,22 @@ int main(int argc, char ** argv)
 
 
         delete dbc;
+        uint32 mapStartTime = GetMSTime();
         ParsMapFiles();
+        mapTime = GetMSTimeDiffToNow(mapStartTime);
         delete [] map_ids;
         //nError = ERROR_SUCCESS;
         // Extract models, listed in DameObjectDisplayInfo.dbc
+        uint32 gameobjectStartTime = GetMSTime();
         ExtractGameobjectModels();
+        gameobjectTime = GetMSTimeDiffToNow(gameobjectStartTime);
     }
 
+    uint32 totalTime = GetMSTimeDiffToNow(startTime);
+    printf("\nThroughput: %u wmos, %u m2 models converted in %u ms (%.1f models/s)\n", uint32(extractedWmoCount), uint32(extractedModelCount),
+        totalTime, (extractedWmoCount + extractedModelCount) * 1000.0f / std::max(1u, totalTime));
+    printf("    wmo extraction: %u ms, map files: %u ms, gameobject models: %u ms\n", wmoTime, mapTime, gameobjectTime);
+
     printf("\n");
     if (!success)
     {
@@ -19,7 +19,10 @@
 #ifndef VMAPEXPORT_H
 #define VMAPEXPORT_H
 
+#include "Define.h"
+#include <atomic>
 #include <string>
+#include <vector>
 
 enum ModelFlags
 {
@@ -30,6 +33,10 @@ enum ModelFlags
 
 extern const char * szWorkDirWmo;
 extern const char * szRawVMAPMagic;                         // vmap magic string for extracted raw vmap data
+extern unsigned int extractThreads;                         // 0 or 1 for serial extraction
+
+extern std::atomic<uint32> extractedWmoCount;
+extern std::atomic<uint32> extractedModelCount;
 
 bool FileExists(const char * file);
 void strToLower(char* str);
@@ -39,4 +46,11 @@ bool ExtractSingleModel(std::string& fname);
 
 void ExtractGameobjectModels();
 
+// dir_bin records of model spawns, see ModelInstance and WMOInstance
+inline void AppendSpawnData(std::vector<char>& spawns, void const* data, size_t size)
+{
+    char const* bytes = static_cast<char const*>(data);
+    spawns.insert(spawns.end(), bytes, bytes + size);
+}
+
 #endif
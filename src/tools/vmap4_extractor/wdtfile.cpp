@@ -95,12 +95,14 @@ bool WDTFile::init(char* /*map_id*/, unsigned int mapID)
             {
                 gnWMO = (int)size / 64;
 
+                std::vector<char> spawns;
                 for (int i = 0; i < gnWMO; ++i)
                 {
                     int id;
                     WDT.read(&id, 4);
-                    WMOInstance inst(WDT,gWmoInstansName[id].c_str(), mapID, 65, 65, dirfile);
+                    WMOInstance inst(WDT,gWmoInstansName[id].c_str(), mapID, 65, 65, spawns);
                 }
+                fwrite(spawns.data(), 1, spawns.size(), dirfile);
 
                 delete[] gWmoInstansName;
             }
@@ -502,7 +502,7 @@ WMOGroup::~WMOGroup()
     delete [] LiquBytes;
 }
 
-WMOInstance::WMOInstance(MPQFile& f, char const* WmoInstName, uint32 mapID, uint32 tileX, uint32 tileY, FILE* pDirfile)
+WMOInstance::WMOInstance(MPQFile& f, char const* WmoInstName, uint32 mapID, uint32 tileX, uint32 tileY, std::vector<char>& spawns)
     : currx(0), curry(0), wmo(nullptr), doodadset(0), pos(), indx(0), id(0)
 {
     float ff[3];
@@ -568,20 +568,20 @@ WMOInstance::WMOInstance(MPQFile& f, char const* WmoInstName, uint32 mapID, uint
     uint32 flags = MOD_HAS_BOUND;
     if (tileX == 65 && tileY == 65) flags |= MOD_WORLDSPAWN;
     //write mapID, tileX, tileY, Flags, ID, Pos, Rot, Scale, Bound_lo, Bound_hi, name
-    fwrite(&mapID, sizeof(uint32), 1, pDirfile);
-    fwrite(&tileX, sizeof(uint32), 1, pDirfile);
-    fwrite(&tileY, sizeof(uint32), 1, pDirfile);
-    fwrite(&flags, sizeof(uint32), 1, pDirfile);
-    fwrite(&adtId, sizeof(uint16), 1, pDirfile);
-    fwrite(&id, sizeof(uint32), 1, pDirfile);
-    fwrite(&pos, sizeof(float), 3, pDirfile);
-    fwrite(&rot, sizeof(float), 3, pDirfile);
-    fwrite(&scale, sizeof(float), 1, pDirfile);
-    fwrite(&pos2, sizeof(float), 3, pDirfile);
-    fwrite(&pos3, sizeof(float), 3, pDirfile);
+    AppendSpawnData(spawns, &mapID, sizeof(uint32));
+    AppendSpawnData(spawns, &tileX, sizeof(uint32));
+    AppendSpawnData(spawns, &tileY, sizeof(uint32));
+    AppendSpawnData(spawns, &flags, sizeof(uint32));
+    AppendSpawnData(spawns, &adtId, sizeof(uint16));
+    AppendSpawnData(spawns, &id, sizeof(uint32));
+    AppendSpawnData(spawns, &pos, sizeof(float) * 3);
+    AppendSpawnData(spawns, &rot, sizeof(float) * 3);
+    AppendSpawnData(spawns, &scale, sizeof(float));
+    AppendSpawnData(spawns, &pos2, sizeof(float) * 3);
+    AppendSpawnData(spawns, &pos3, sizeof(float) * 3);
     uint32 nlen = strlen(WmoInstName);
-    fwrite(&nlen, sizeof(uint32), 1, pDirfile);
-    fwrite(WmoInstName, sizeof(char), nlen, pDirfile);
+    AppendSpawnData(spawns, &nlen, sizeof(uint32));
+    AppendSpawnData(spawns, WmoInstName, nlen * sizeof(char));
 
     /* fprintf(pDirfile,"%s/%s %f,%f,%f_%f,%f,%f 1.0 %d %d %d,%d %d\n",
         MapName,
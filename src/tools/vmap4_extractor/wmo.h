@@ -23,6 +23,7 @@
 
 #include <string>
 #include <set>
+#include <vector>
 #include "vec3d.h"
 #include "loadlib/loadlib.h"
 
@@ -134,7 +135,7 @@ public:
     Vec3D pos2, pos3, rot;
     uint32 indx, id;
 
-    WMOInstance(MPQFile&f , char const* WmoInstName, uint32 mapID, uint32 tileX, uint32 tileY, FILE* pDirfile);
+    WMOInstance(MPQFile&f , char const* WmoInstName, uint32 mapID, uint32 tileX, uint32 tileY, std::vector<char>& spawns);
 
     static void reset();
 };